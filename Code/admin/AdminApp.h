@@ -47,6 +47,7 @@ class AdminApp : public Platform::Application, public TiltedPhoques::Client
     void OnUpdate() override;
 
     void SendShutdownRequest();
+    void SendLogLevel(uint8_t aLevel);
 
 protected:
 
@@ -1,6 +1,7 @@
 #include "AdminApp.h"
 #include "Packet.hpp"
 #include "AdminMessages/AdminShutdownRequest.h"
+#include "AdminMessages/AdminSetLogLevel.h"
 #include "AdminMessages/ServerLogs.h"
 #include "AdminMessages/ServerAdminMessageFactory.h"
 
@@ -112,6 +113,13 @@ void AdminApp::SendShutdownRequest()
     Send(request);
 }
 
+void AdminApp::SendLogLevel(uint8_t aLevel)
+{
+    AdminSetLogLevel request;
+    request.Level = aLevel;
+    Send(request);
+}
+
 void AdminApp::HandleMessage(const AdminSessionOpen& acMessage)
 {
     m_state = ConnectionState::kConnected;
@@ -119,5 +127,8 @@ void AdminApp::HandleMessage(const AdminSessionOpen& acMessage)
 
 void AdminApp::HandleMessage(const ServerLogs& acMessage)
 {
+    if (acMessage.Dropped > 0)
+        m_overlay.GetConsole().Log(String("[") + std::to_string(acMessage.Dropped).c_str() + " log lines dropped by the server]");
+
     m_overlay.GetConsole().Log(acMessage.Logs);
 }
@@ -18,6 +18,12 @@ bool Admin::OnDisable()
 
 void Admin::Update(AdminApp& aApp)
 {
+    // Same order as spdlog's levels
+    static const char* s_levels[] = {"Trace", "Debug", "Info", "Warning", "Error", "Critical", "Off"};
+
+    if (ImGui::Combo("Log level", &m_logLevel, s_levels, IM_ARRAYSIZE(s_levels)))
+        aApp.SendLogLevel(static_cast<uint8_t>(m_logLevel));
+
     if (ImGui::Button("Shutdown Server"))
         ImGui::OpenPopup("Shutdown Server Dialog");
 
@@ -13,4 +13,5 @@ struct Admin : Widget
 
 private:
 
+    int m_logLevel{0};
 };
@@ -0,0 +1,14 @@
+#include "AdminSetLogLevel.h"
+
+
+void AdminSetLogLevel::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    aWriter.WriteBits(Level, 8);
+}
+
+void AdminSetLogLevel::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    uint64_t level = 0;
+    aReader.ReadBits(level, 8);
+    Level = level & 0xFF;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Message.h"
+
+// Only logs at this level or above are forwarded to the session, values are spdlog's levels
+struct AdminSetLogLevel : ClientAdminMessage
+{
+    static constexpr ClientAdminOpcode Opcode = kAdminSetLogLevel;
+
+    AdminSetLogLevel() : ClientAdminMessage(Opcode)
+    {
+    }
+
+    virtual ~AdminSetLogLevel() = default;
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const AdminSetLogLevel& achRhs) const noexcept
+    {
+        return GetOpcode() == achRhs.GetOpcode() && Level == achRhs.Level;
+    }
+
+    uint8_t Level{0};
+};
@@ -5,6 +5,7 @@
 #include "MetaMessage.h"
 
 #include "AdminShutdownRequest.h"
+#include "AdminSetLogLevel.h"
 
 using TiltedPhoques::UniquePtr;
 
@@ -14,7 +15,7 @@ struct ClientAdminMessageFactory
 
     template <class T> static auto Visit(T&& func)
     {
-        auto s_visitor = CreateMessageVisitor<AdminShutdownRequest>;
+        auto s_visitor = CreateMessageVisitor<AdminShutdownRequest, AdminSetLogLevel>;
 
         return s_visitor(std::forward<T>(func));
     }
@@ -4,9 +4,11 @@
 void ServerLogs::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
 {
     Serialization::WriteString(aWriter, Logs);
+    Serialization::WriteVarInt(aWriter, Dropped);
 }
 
 void ServerLogs::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
 {
     Logs = Serialization::ReadString(aReader);
+    Dropped = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
 }
@@ -17,9 +17,12 @@ struct ServerLogs : ServerAdminMessage
 
     bool operator==(const ServerLogs& achRhs) const noexcept
     {
-        return GetOpcode() == achRhs.GetOpcode() && Logs == achRhs.Logs;
+        return GetOpcode() == achRhs.GetOpcode() && Logs == achRhs.Logs && Dropped == achRhs.Dropped;
     }
 
+    // Lines are batched, each one ends with a new line
     String Logs;
+    // Lines the server couldn't forward since the last message
+    uint32_t Dropped{0};
 
 };
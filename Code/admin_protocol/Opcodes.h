@@ -3,6 +3,7 @@
 enum ClientAdminOpcode : unsigned char
 {
     kAdminShutdown = 0,
+    kAdminSetLogLevel,
 
     kClientAdminOpcodeMax
 };
@@ -5,6 +5,7 @@
 #endif
 
 #include <Structs/ActionEvent.h>
+#include <Structs/GameId.h>
 
 struct LocalComponent
 {
@@ -13,4 +14,11 @@ struct LocalComponent
     uint32_t Id;
     ActionEvent CurrentAction;
     bool IsDead;
+
+    // Cell and worldspace last sent in movement updates, they are sent again for a while after changing as updates
+    // may be lost
+    GameId SentCellId{};
+    GameId SentWorldSpaceId{};
+    uint64_t CellResendUntil{0};
+    uint64_t CellSentTick{0};
 };
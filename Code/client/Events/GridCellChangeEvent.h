@@ -6,7 +6,6 @@ struct GridCellChangeEvent
 {
     uint32_t WorldSpaceId;
     GameId PlayerCell;
-    Vector<GameId> Cells{};
     GridCellCoords CenterCoords;
     GridCellCoords PlayerCoords;
 };
@@ -121,6 +121,7 @@ void TESObjectREFR::SaveAnimationVariables(AnimationVariables& aVariables) const
                 return;
             
             aVariables.Booleans = 0;
+            aVariables.DescriptorKey = pExtendedActor->GraphDescriptorHash;
 
             aVariables.Floats.resize(pDescriptor->FloatLookupTable.size());
             aVariables.Integers.resize(pDescriptor->IntegerLookupTable.size());
@@ -1,20 +1,24 @@
 #pragma once
 #include "Structs/Inventory.h"
+#include <Structs/GridCellCoords.h>
+#include <Messages/CharacterSpawnRequest.h>
 
 struct UpdateEvent;
+struct GridCellChangeEvent;
+struct CellChangeEvent;
 struct ConnectedEvent;
 struct DisconnectedEvent;
 struct EquipmentChangeEvent;
 struct FormIdComponent;
 struct ActionEvent;
 struct AssignCharacterResponse;
-struct CharacterSpawnRequest;
 struct ServerReferencesMoveRequest;
 struct NotifyInventoryChanges;
 struct NotifyFactionsChanges;
 struct NotifyRemoveCharacter;
 struct NotifySpawnData;
 struct NotifyOwnershipTransfer;
+struct NotifyRelinquishControl;
 
 struct Actor;
 struct World;
@@ -27,23 +31,26 @@ struct CharacterService
 
     TP_NOCOPYMOVE(CharacterService);
 
-    void OnFormIdComponentAdded(entt::registry& aRegistry, entt::entity aEntity) const noexcept;
+    void OnFormIdComponentAdded(entt::registry& aRegistry, entt::entity aEntity) noexcept;
     void OnFormIdComponentRemoved(entt::registry& aRegistry, entt::entity aEntity) const noexcept;
     void OnUpdate(const UpdateEvent& acUpdateEvent) noexcept;
-    void OnConnected(const ConnectedEvent& acConnectedEvent) const noexcept;
-    void OnDisconnected(const DisconnectedEvent& acDisconnectedEvent) const noexcept;
-    void OnAssignCharacter(const AssignCharacterResponse& acMessage) const noexcept;
-    void OnCharacterSpawn(const CharacterSpawnRequest& acMessage) const noexcept;
+    void OnConnected(const ConnectedEvent& acConnectedEvent) noexcept;
+    void OnDisconnected(const DisconnectedEvent& acDisconnectedEvent) noexcept;
+    void OnAssignCharacter(const AssignCharacterResponse& acMessage) noexcept;
+    void OnCharacterSpawn(const CharacterSpawnRequest& acMessage) noexcept;
     void OnReferencesMoveRequest(const ServerReferencesMoveRequest& acMessage) const noexcept;
     void OnActionEvent(const ActionEvent& acActionEvent) const noexcept;
     void OnFactionsChanges(const NotifyFactionsChanges& acEvent) const noexcept;
     void OnOwnershipTransfer(const NotifyOwnershipTransfer& acMessage) const noexcept;
-    void OnRemoveCharacter(const NotifyRemoveCharacter& acMessage) const noexcept;
+    void OnRelinquishControl(const NotifyRelinquishControl& acMessage) const noexcept;
+    void OnRemoveCharacter(const NotifyRemoveCharacter& acMessage) noexcept;
     void OnRemoteSpawnDataReceived(const NotifySpawnData& acEvent) const noexcept;
+    void OnGridCellChange(const GridCellChangeEvent& acEvent) noexcept;
+    void OnCellChange(const CellChangeEvent& acEvent) noexcept;
 
 private:
 
-    void RequestServerAssignment(entt::registry& aRegistry, entt::entity aEntity) const noexcept;
+    void RequestServerAssignment(entt::registry& aRegistry, entt::entity aEntity, bool aFullState = false) noexcept;
     void CancelServerAssignment(entt::registry& aRegistry, entt::entity aEntity, uint32_t aFormId) const noexcept;
 
     Actor* CreateCharacterForEntity(entt::entity aEntity) const noexcept;
@@ -52,17 +59,40 @@ private:
     void RunRemoteUpdates() const noexcept;
     void RunFactionsUpdates() const noexcept;
     void RunSpawnUpdates() const noexcept;
+    void RunPrefetchUpdates(double aDelta) noexcept;
+    [[nodiscard]] bool IsInGrid(const CharacterSpawnRequest& acRequest, uint32_t aWorldSpaceId,
+                                const GridCellCoords& acCenter) const noexcept;
 
     World& m_world;
     entt::dispatcher& m_dispatcher;
     TransportService& m_transport;
 
+    // References the server assigned this session, it may still hold their state so we only send brief requests
+    Set<uint32_t> m_knownReferences;
+
+    struct PrefetchedSpawn
+    {
+        CharacterSpawnRequest Request;
+        double ExpiresAt;
+    };
+
+    // Characters the server sent ahead of a grid shift, spawned as soon as our own grid reaches them
+    Map<uint32_t, PrefetchedSpawn> m_prefetchedSpawns;
+    // Grid we last shifted to, a prefetch arriving after the shift is spawned right away
+    uint32_t m_gridWorldSpaceId{0};
+    GridCellCoords m_gridCenter{};
+    // Prefetches are held back on a congested connection and can arrive after the character was removed, with the time
+    // until which they are ignored
+    Map<uint32_t, double> m_removedCharacters;
+    double m_time{0.0};
+
     entt::scoped_connection m_formIdAddedConnection;
     entt::scoped_connection m_formIdRemovedConnection;
     entt::scoped_connection m_updateConnection;
     entt::scoped_connection m_actionConnection;
     entt::scoped_connection m_factionsConnection;
     entt::scoped_connection m_ownershipTransferConnection;
+    entt::scoped_connection m_relinquishControlConnection;
     entt::scoped_connection m_removeCharacterConnection;
     entt::scoped_connection m_connectedConnection;
     entt::scoped_connection m_disconnectedConnection;
@@ -71,4 +101,6 @@ private:
     entt::scoped_connection m_referenceMovementSnapshotConnection;
     entt::scoped_connection m_remoteSpawnDataReceivedConnection;
     entt::scoped_connection m_fireProjectileConnection;
+    entt::scoped_connection m_gridCellChangeConnection;
+    entt::scoped_connection m_cellChangeConnection;
 };
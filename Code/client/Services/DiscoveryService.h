@@ -21,7 +21,7 @@ struct DiscoveryService final
 protected:
 
     void VisitCell(bool aForceTrigger = false) noexcept;
-    void DetectGridCellChange(TESWorldSpace* aWorldSpace, bool aNewGridCell) noexcept;
+    void DetectGridCellChange(TESWorldSpace* aWorldSpace) noexcept;
     void VisitForms() noexcept;
 
     void OnUpdate(const PreUpdateEvent& acPreUpdateEvent) noexcept;
@@ -30,6 +30,8 @@
 #include <Events/ConnectedEvent.h>
 #include <Events/DisconnectedEvent.h>
 #include <Events/EquipmentChangeEvent.h>
+#include <Events/GridCellChangeEvent.h>
+#include <Events/CellChangeEvent.h>
 #include <Events/UpdateEvent.h>
 
 #include <Structs/ActionEvent.h>
@@ -46,6 +48,7 @@
 #include <Messages/NotifySpawnData.h>
 #include <Messages/RequestOwnershipTransfer.h>
 #include <Messages/NotifyOwnershipTransfer.h>
+#include <Messages/NotifyRelinquishControl.h>
 #include <Messages/RequestOwnershipClaim.h>
 
 #include <World.h>
@@ -73,11 +76,14 @@ CharacterService::CharacterService(World& aWorld, entt::dispatcher& aDispatcher,
     m_referenceMovementSnapshotConnection = m_dispatcher.sink<ServerReferencesMoveRequest>().connect<&CharacterService::OnReferencesMoveRequest>(this);
     m_factionsConnection = m_dispatcher.sink<NotifyFactionsChanges>().connect<&CharacterService::OnFactionsChanges>(this);
     m_ownershipTransferConnection = m_dispatcher.sink<NotifyOwnershipTransfer>().connect<&CharacterService::OnOwnershipTransfer>(this);
+    m_relinquishControlConnection = m_dispatcher.sink<NotifyRelinquishControl>().connect<&CharacterService::OnRelinquishControl>(this);
     m_removeCharacterConnection = m_dispatcher.sink<NotifyRemoveCharacter>().connect<&CharacterService::OnRemoveCharacter>(this);
     m_remoteSpawnDataReceivedConnection = m_dispatcher.sink<NotifySpawnData>().connect<&CharacterService::OnRemoteSpawnDataReceived>(this);
+    m_gridCellChangeConnection = m_dispatcher.sink<GridCellChangeEvent>().connect<&CharacterService::OnGridCellChange>(this);
+    m_cellChangeConnection = m_dispatcher.sink<CellChangeEvent>().connect<&CharacterService::OnCellChange>(this);
 }
 
-void CharacterService::OnFormIdComponentAdded(entt::registry& aRegistry, const entt::entity aEntity) const noexcept
+void CharacterService::OnFormIdComponentAdded(entt::registry& aRegistry, const entt::entity aEntity) noexcept
 {
     if (!m_transport.IsOnline())
         return;
@@ -136,9 +142,10 @@ void CharacterService::OnUpdate(const UpdateEvent& acUpdateEvent) noexcept
     RunLocalUpdates();
     RunFactionsUpdates();
     RunRemoteUpdates();
+    RunPrefetchUpdates(acUpdateEvent.Delta);
 }
 
-void CharacterService::OnConnected(const ConnectedEvent& acConnectedEvent) const noexcept
+void CharacterService::OnConnected(const ConnectedEvent& acConnectedEvent) noexcept
 {
     //m_world.clear<WaitingForAssignmentComponent, LocalComponent, RemoteComponent>();
 
@@ -150,7 +157,7 @@ void CharacterService::OnConnected(const ConnectedEvent& acConnectedEvent) const
     }
 }
 
-void CharacterService::OnDisconnected(const DisconnectedEvent& acDisconnectedEvent) const noexcept
+void CharacterService::OnDisconnected(const DisconnectedEvent& acDisconnectedEvent) noexcept
 {
     auto remoteView = m_world.view<FormIdComponent, RemoteComponent>();
     for (auto entity : remoteView)
@@ -163,9 +170,13 @@ void CharacterService::OnDisconnected(const DisconnectedEvent& acDisconnectedEve
     }
 
     m_world.clear<WaitingForAssignmentComponent, LocalComponent, RemoteComponent>();
+    m_knownReferences.clear();
+    m_prefetchedSpawns.clear();
+    m_removedCharacters.clear();
+    m_gridWorldSpaceId = 0;
 }
 
-void CharacterService::OnAssignCharacter(const AssignCharacterResponse& acMessage) const noexcept
+void CharacterService::OnAssignCharacter(const AssignCharacterResponse& acMessage) noexcept
 {
     spdlog::info("Received for cookie {:X}", acMessage.Cookie);
 
@@ -187,6 +198,16 @@ void CharacterService::OnAssignCharacter(const AssignCharacterResponse& acMessag
 
     m_world.remove<WaitingForAssignmentComponent>(cEntity);
 
+    // The server dropped what it knew about this character, send everything
+    if (acMessage.StateRequired)
+    {
+        m_knownReferences.erase(formIdComponent.Id);
+        RequestServerAssignment(m_world, cEntity, true);
+        return;
+    }
+
+    m_knownReferences.insert(formIdComponent.Id);
+
     if (m_world.any_of<LocalComponent, RemoteComponent>(cEntity))
     {
         auto* const pForm = TESForm::GetById(formIdComponent.Id);
@@ -205,6 +226,25 @@ void CharacterService::OnAssignCharacter(const AssignCharacterResponse& acMessag
     {
         m_world.emplace<LocalComponent>(cEntity, acMessage.ServerId);
         m_world.emplace<LocalAnimationComponent>(cEntity);
+
+        // Our copy was reset when the cell unloaded, take back what the server kept
+        if (acMessage.Restored)
+        {
+            auto* const pForm = TESForm::GetById(formIdComponent.Id);
+            auto* pActor = RTTI_CAST(pForm, TESForm, Actor);
+            if (!pActor)
+                return;
+
+            pActor->SetActorValues(acMessage.AllActorValues);
+            pActor->SetInventory(acMessage.InventoryContent);
+            pActor->SetFactions(acMessage.FactionsContent);
+
+            if (auto* pCacheComponent = m_world.try_get<CacheComponent>(cEntity))
+                pCacheComponent->FactionsContent = acMessage.FactionsContent;
+
+            if (pActor->IsDead() != acMessage.IsDead)
+                acMessage.IsDead ? pActor->Kill() : pActor->Respawn();
+        }
     }
     else
     {
@@ -236,7 +276,7 @@ void CharacterService::OnAssignCharacter(const AssignCharacterResponse& acMessag
     }
 }
 
-void CharacterService::OnCharacterSpawn(const CharacterSpawnRequest& acMessage) const noexcept
+void CharacterService::OnCharacterSpawn(const CharacterSpawnRequest& acMessage) noexcept
 {
     auto remoteView = m_world.view<RemoteComponent>();
     const auto remoteItor = std::find_if(std::begin(remoteView), std::end(remoteView), [remoteView, Id = acMessage.ServerId](auto entity)
@@ -246,10 +286,34 @@ void CharacterService::OnCharacterSpawn(const CharacterSpawnRequest& acMessage)
 
     if (remoteItor != std::end(remoteView))
     {
-        spdlog::warn("Character with remote id {:X} is already spawned.", acMessage.ServerId);
+        if (!acMessage.Prefetch)
+            spdlog::warn("Character with remote id {:X} is already spawned.", acMessage.ServerId);
         return;
     }
 
+    if (acMessage.Prefetch)
+    {
+        if (m_removedCharacters.count(acMessage.ServerId))
+            return;
+
+        // The server doesn't send prefetched characters again, one arriving after our grid already reached it is
+        // spawned now
+        if (m_gridWorldSpaceId != 0 && IsInGrid(acMessage, m_gridWorldSpaceId, m_gridCenter))
+        {
+            CharacterSpawnRequest request = acMessage;
+            request.Prefetch = false;
+            m_prefetchedSpawns.erase(request.ServerId);
+            OnCharacterSpawn(request);
+            return;
+        }
+
+        // Keep the newest data, the character may have moved since the last prefetch
+        m_prefetchedSpawns[acMessage.ServerId] = {acMessage, m_time + 20.0};
+        return;
+    }
+
+    m_prefetchedSpawns.erase(acMessage.ServerId);
+
     Actor* pActor = nullptr;
 
     std::optional<entt::entity> entity;
@@ -487,8 +551,41 @@ void CharacterService::OnOwnershipTransfer(const NotifyOwnershipTransfer& acMess
     m_transport.Send(request);
 }
 
-void CharacterService::OnRemoveCharacter(const NotifyRemoveCharacter& acMessage) const noexcept
+void CharacterService::OnRelinquishControl(const NotifyRelinquishControl& acMessage) const noexcept
+{
+    auto view = m_world.view<LocalComponent, FormIdComponent>();
+
+    const auto itor = std::find_if(std::begin(view), std::end(view), [&acMessage, &view](auto entity) {
+        return view.get<LocalComponent>(entity).Id == acMessage.ServerId;
+    });
+
+    if (itor == std::end(view))
+        return;
+
+    const auto cEntity = *itor;
+    const auto cFormId = view.get<FormIdComponent>(cEntity).Id;
+
+    m_world.remove_if_exists<LocalComponent, LocalAnimationComponent>(cEntity);
+
+    auto* const pActor = RTTI_CAST(TESForm::GetById(cFormId), TESForm, Actor);
+    if (!pActor)
+        return;
+
+    m_world.emplace_or_replace<RemoteComponent>(cEntity, acMessage.ServerId, cFormId);
+
+    pActor->GetExtension()->SetRemote(true);
+
+    InterpolationSystem::Setup(m_world, cEntity);
+    AnimationSystem::Setup(m_world, cEntity);
+
+    spdlog::info("Ownership relinquished {:X}", acMessage.ServerId);
+}
+
+void CharacterService::OnRemoveCharacter(const NotifyRemoveCharacter& acMessage) noexcept
 {
+    m_prefetchedSpawns.erase(acMessage.ServerId);
+    m_removedCharacters[acMessage.ServerId] = m_time + 20.0;
+
     auto view = m_world.view<RemoteComponent>();
 
     const auto itor = std::find_if(std::begin(view), std::end(view), [id = acMessage.ServerId, view](entt::entity entity) {
@@ -511,7 +608,53 @@ void CharacterService::OnRemoveCharacter(const NotifyRemoveCharacter& acMessage)
     }
 }
 
-void CharacterService::RequestServerAssignment(entt::registry& aRegistry, const entt::entity aEntity) const noexcept
+void CharacterService::OnGridCellChange(const GridCellChangeEvent& acEvent) noexcept
+{
+    m_gridWorldSpaceId = acEvent.WorldSpaceId;
+    m_gridCenter = acEvent.CenterCoords;
+
+    Vector<CharacterSpawnRequest> spawns;
+
+    for (auto itor = std::begin(m_prefetchedSpawns); itor != std::end(m_prefetchedSpawns);)
+    {
+        const auto& request = itor->second.Request;
+
+        if (!IsInGrid(request, acEvent.WorldSpaceId, acEvent.CenterCoords))
+        {
+            ++itor;
+            continue;
+        }
+
+        spawns.push_back(request);
+        spawns.back().Prefetch = false;
+
+        itor = m_prefetchedSpawns.erase(itor);
+    }
+
+    for (const auto& request : spawns)
+        OnCharacterSpawn(request);
+}
+
+void CharacterService::OnCellChange(const CellChangeEvent& acEvent) noexcept
+{
+    // Interiors have no grid, late prefetches wait for the next exterior one
+    if (acEvent.WorldSpaceId == GameId{})
+        m_gridWorldSpaceId = 0;
+}
+
+bool CharacterService::IsInGrid(const CharacterSpawnRequest& acRequest, const uint32_t aWorldSpaceId,
+                                const GridCellCoords& acCenter) const noexcept
+{
+    const auto cCellId = World::Get().GetModSystem().GetGameId(acRequest.CellId);
+    const auto* pCell = RTTI_CAST(TESForm::GetById(cCellId), TESForm, TESObjectCELL);
+    if (!pCell || !pCell->worldspace || pCell->worldspace->formID != aWorldSpaceId)
+        return false;
+
+    const auto coords = GridCellCoords::CalculateGridCellCoords(acRequest.Position.x, acRequest.Position.y);
+    return GridCellCoords::IsCellInGridCell(coords, acCenter);
+}
+
+void CharacterService::RequestServerAssignment(entt::registry& aRegistry, const entt::entity aEntity, const bool aFullState) noexcept
 {
     if (!m_transport.IsOnline())
         return;
@@ -565,6 +708,8 @@ void CharacterService::RequestServerAssignment(entt::registry& aRegistry, const
     const auto isPlayer = (formIdComponent.Id == 0x14);
     const auto isTemporary = pActor->formID >= 0xFF000000;
 
+    message.Brief = !aFullState && !isPlayer && !isTemporary && m_knownReferences.count(formIdComponent.Id) > 0;
+
     if(isPlayer)
     {
         pNpc->MarkChanged(0x2000800);
@@ -572,7 +717,7 @@ void CharacterService::RequestServerAssignment(entt::registry& aRegistry, const
 
     const auto changeFlags = pNpc->GetChangeFlags();
 
-    if(isPlayer || pNpc->formID >= 0xFF000000 || changeFlags != 0)
+    if(!message.Brief && (isPlayer || pNpc->formID >= 0xFF000000 || changeFlags != 0))
     {
         message.ChangeFlags = changeFlags;
         pNpc->Serialize(&message.AppearanceBuffer);
@@ -628,8 +773,12 @@ void CharacterService::RequestServerAssignment(entt::registry& aRegistry, const
         questLog.resize(std::distance(questLog.begin(), ip));
     }
 
-    message.InventoryContent = pActor->GetInventory();
-    message.FactionsContent = pActor->GetFactions();
+    if (!message.Brief)
+    {
+        message.InventoryContent = pActor->GetInventory();
+        message.FactionsContent = pActor->GetFactions();
+    }
+
     message.AllActorValues = pActor->GetEssentialActorValues();
     message.IsDead = pActor->IsDead();
 
@@ -781,7 +930,11 @@ void CharacterService::RunLocalUpdates() const noexcept
         AnimationSystem::Serialize(m_world, message, localComponent, animationComponent, formIdComponent);
     }
 
-    m_transport.Send(message);
+    // Actions are not repeated by later snapshots so they can't be dropped
+    const bool hasActions = std::any_of(std::begin(message.Updates), std::end(message.Updates),
+                                        [](const auto& acEntry) { return !acEntry.second.ActionEvents.empty(); });
+
+    m_transport.Send(message, hasActions ? EDelivery::kReliable : ClientReferencesMoveRequest::Delivery);
 }
 
 void CharacterService::RunRemoteUpdates() const noexcept
@@ -945,3 +1098,24 @@ void CharacterService::RunSpawnUpdates() const noexcept
         }
     }
 }
+
+void CharacterService::RunPrefetchUpdates(const double aDelta) noexcept
+{
+    m_time += aDelta;
+
+    for (auto itor = std::begin(m_prefetchedSpawns); itor != std::end(m_prefetchedSpawns);)
+    {
+        if (itor->second.ExpiresAt <= m_time)
+            itor = m_prefetchedSpawns.erase(itor);
+        else
+            ++itor;
+    }
+
+    for (auto itor = std::begin(m_removedCharacters); itor != std::end(m_removedCharacters);)
+    {
+        if (itor->second <= m_time)
+            itor = m_removedCharacters.erase(itor);
+        else
+            ++itor;
+    }
+}
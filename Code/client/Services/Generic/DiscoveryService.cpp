@@ -41,12 +41,12 @@ void DiscoveryService::VisitCell(bool aForceTrigger) noexcept
 
         if (m_worldSpaceId != worldSpaceId || aForceTrigger)
         {
-            DetectGridCellChange(pWorldSpace, true);
+            DetectGridCellChange(pWorldSpace);
             aForceTrigger = true;
         }
 
         if (m_centerGridX != pTES->centerGridX || m_centerGridY != pTES->centerGridY)
-            DetectGridCellChange(pWorldSpace, false);
+            DetectGridCellChange(pWorldSpace);
 
         if (m_currentGridX != pTES->currentGridX || m_currentGridY != pTES->currentGridY || aForceTrigger)
         {
@@ -100,7 +100,7 @@ void DiscoveryService::VisitCell(bool aForceTrigger) noexcept
     }
 }
 
-void DiscoveryService::DetectGridCellChange(TESWorldSpace* aWorldSpace, bool aNewGridCell) noexcept
+void DiscoveryService::DetectGridCellChange(TESWorldSpace* aWorldSpace) noexcept
 {
     const auto* pTES = TES::Get();
 
@@ -108,33 +108,7 @@ void DiscoveryService::DetectGridCellChange(TESWorldSpace* aWorldSpace, bool aNe
     const auto worldSpaceId = aWorldSpace->formID;
     changeEvent.WorldSpaceId = worldSpaceId;
 
-    const auto startGridX = pTES->centerGridX - GridCellCoords::m_gridsToLoad / 2;
-    const auto startGridY = pTES->centerGridY - GridCellCoords::m_gridsToLoad / 2;
-    for (int32_t i = 0; i < GridCellCoords::m_gridsToLoad; ++i)
-    {
-        for (int32_t j = 0; j < GridCellCoords::m_gridsToLoad; ++j)
-        {
-            if (!aNewGridCell)
-            {
-                if (GridCellCoords::IsCellInGridCell(GridCellCoords(m_centerGridX, m_centerGridY),
-                                                     GridCellCoords(startGridX + i, startGridY + j)))
-                {
-                    continue;
-                }
-            }
-
-            const auto* pCell = ModManager::Get()->GetCellFromCoordinates(startGridX + i, startGridY + j, aWorldSpace, 0);
-
-            if (pCell)
-            {
-                uint32_t baseId = 0;
-                uint32_t modId = 0;
-                if (m_world.GetModSystem().GetServerModId(pCell->formID, modId, baseId))
-                    changeEvent.Cells.push_back(GameId(modId, baseId));
-            }
-        }
-    }
-
+    // The server works out which cells came into view from the coordinates
     const auto* pCell = ModManager::Get()->GetCellFromCoordinates(pTES->centerGridX, pTES->centerGridY, aWorldSpace, 0);
 
     uint32_t baseId = 0;
@@ -9,6 +9,8 @@
 #include <Services/TransportService.h>
 
 #include <Messages/NotifyPlayerList.h>
+#include <Messages/NotifyPlayerListDelta.h>
+#include <Messages/RequestPlayerList.h>
 #include <Messages/NotifyPartyInfo.h>
 #include <Messages/NotifyPartyInvite.h>
 #include <Messages/PartyInviteRequest.h>
@@ -22,6 +24,7 @@ PartyService::PartyService(entt::dispatcher& aDispatcher, ImguiService& aImguiSe
     m_drawConnection = aImguiService.OnDraw.connect<&PartyService::OnDraw>(this);
 
     m_playerListConnection = aDispatcher.sink<NotifyPlayerList>().connect<&PartyService::OnPlayerList>(this);
+    m_playerListDeltaConnection = aDispatcher.sink<NotifyPlayerListDelta>().connect<&PartyService::OnPlayerListDelta>(this);
     m_partyInfoConnection = aDispatcher.sink<NotifyPartyInfo>().connect<&PartyService::OnPartyInfo>(this);
     m_partyInviteConnection = aDispatcher.sink<NotifyPartyInvite>().connect<&PartyService::OnPartyInvite>(this);
 }
@@ -52,6 +55,34 @@ void PartyService::OnUpdate(const UpdateEvent& acEvent) noexcept
 void PartyService::OnPlayerList(const NotifyPlayerList& acPlayerList) noexcept
 {
     m_players = acPlayerList.Players;
+    m_playerListVersion = acPlayerList.Version;
+    m_playerListRequested = false;
+}
+
+void PartyService::OnPlayerListDelta(const NotifyPlayerListDelta& acDelta) noexcept
+{
+    // We missed a change, drop deltas until the full list arrives
+    if (acDelta.Version != m_playerListVersion + 1)
+    {
+        if (!m_playerListRequested)
+        {
+            RequestPlayerList request;
+            request.Version = m_playerListVersion;
+
+            m_transportService.Send(request);
+            m_playerListRequested = true;
+        }
+
+        return;
+    }
+
+    for (auto& player : acDelta.UpdatedPlayers)
+        m_players[player.first] = player.second;
+
+    for (auto id : acDelta.RemovedPlayers)
+        m_players.erase(id);
+
+    m_playerListVersion = acDelta.Version;
 }
 
 void PartyService::OnPartyInfo(const NotifyPartyInfo& acPlayerList) noexcept
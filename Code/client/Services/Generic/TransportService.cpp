@@ -17,9 +17,12 @@
 #include <Packet.hpp>
 #include <Messages/AuthenticationRequest.h>
 #include <Messages/ServerMessageFactory.h>
+#include <Messages/ClientMessageFactory.h>
 #include <Messages/ShiftGridCellRequest.h>
 #include <Messages/EnterExteriorCellRequest.h>
 #include <Messages/EnterInteriorCellRequest.h>
+#include <Messages/RequestClientStats.h>
+#include <Messages/NotifyMessageChunk.h>
 
 #include <Services/ImguiService.h>
 #include <Services/DiscordService.h>
@@ -29,6 +32,12 @@
 
 using TiltedPhoques::Packet;
 
+namespace
+{
+    // Upload rate of large messages, most of them are sent while joining
+    constexpr uint32_t kStreamRate = 256 * 1024;
+}
+
 TransportService::TransportService(World& aWorld, entt::dispatcher& aDispatcher, ImguiService& aImguiService) noexcept
     : m_world(aWorld)
     , m_dispatcher(aDispatcher)
@@ -58,10 +67,32 @@ TransportService::TransportService(World& aWorld, entt::dispatcher& aDispatcher,
         const auto pRealMessage = TiltedPhoques::CastUnique<AuthenticationResponse>(std::move(apMessage));
         HandleAuthenticationResponse(*pRealMessage);
     };
+
+    m_messageHandlers[NotifyMessageChunk::Opcode] = [this](UniquePtr<ServerMessage>& apMessage) {
+        const auto pRealMessage = TiltedPhoques::CastUnique<NotifyMessageChunk>(std::move(apMessage));
+        HandleMessageChunk(pRealMessage->Chunk);
+    };
+
+    m_messageHandlers[ServerMessageBatch::Opcode] = [this](UniquePtr<ServerMessage>& apMessage) {
+        const auto pRealMessage = TiltedPhoques::CastUnique<ServerMessageBatch>(std::move(apMessage));
+        HandleMessageBatch(pRealMessage->Messages);
+    };
+
+    m_messageHandlers[NotifyJoinQueue::Opcode] = [this](UniquePtr<ServerMessage>& apMessage) {
+        const auto pRealMessage = TiltedPhoques::CastUnique<NotifyJoinQueue>(std::move(apMessage));
+        spdlog::info("Waiting to join the server, {} player(s) ahead", pRealMessage->Position);
+    };
 }
 
 bool TransportService::Send(const ClientMessage& acMessage) const noexcept
 {
+    return Send(acMessage, ClientMessageFactory::GetTraits(acMessage.GetOpcode()).Delivery);
+}
+
+bool TransportService::Send(const ClientMessage& acMessage, EDelivery aDelivery) const noexcept
+{
+    // Allocated once outside of the scratch allocator, it has to fit the largest message we can stream
+    static thread_local Buffer s_buffer(MessageStream::kSerializeBufferSize);
     static thread_local ScratchAllocator s_allocator(1 << 18);
 
     struct ScopedReset
@@ -73,14 +104,39 @@ bool TransportService::Send(const ClientMessage& acMessage) const noexcept
     {
         ScopedAllocator _{ s_allocator };
 
-        Buffer buffer(1 << 16);
-        Buffer::Writer writer(&buffer);
+        Buffer::Writer writer(&s_buffer);
         writer.WriteBits(0, 8); // Write first byte as packet needs it
 
         acMessage.Serialize(writer);
-        TiltedPhoques::PacketView packet(reinterpret_cast<char*>(buffer.GetWriteData()), writer.Size());
 
-        Client::Send(&packet);
+        if (MessageStream::IsTruncated(writer))
+        {
+            spdlog::error("Message {} doesn't fit in {} bytes, dropped", acMessage.GetOpcode(), MessageStream::kMaxMessageSize);
+            return false;
+        }
+
+        const auto* cpData = s_buffer.GetWriteData();
+        const auto cSize = writer.Size();
+
+        const auto cSendReliable = [this](const uint8_t* apPacket, size_t aSize) { SendRaw(apPacket, aSize, EDelivery::kReliable); };
+
+        if (aDelivery == EDelivery::kUnreliable)
+        {
+            if (!m_unreliableBatch.Add(cpData, cSize, [this](const uint8_t* apPacket, size_t aSize) { SendRaw(apPacket, aSize, EDelivery::kUnreliable); }))
+                SendRaw(cpData, cSize, EDelivery::kUnreliable);
+        }
+        // Large messages are streamed, reliable ones sent after a stream wait for it to keep their order
+        else if (cSize > MessageStream::kChunkSize || !m_outgoingStream.IsIdle())
+        {
+            m_reliableBatch.Flush(cSendReliable);
+
+            if (!m_outgoingStream.Queue(cpData, cSize))
+                SendRaw(cpData, cSize, EDelivery::kReliable);
+        }
+        else if (!m_reliableBatch.Add(cpData, cSize, cSendReliable))
+        {
+            SendRaw(cpData, cSize, EDelivery::kReliable);
+        }
 
         return true;
     }
@@ -88,6 +144,22 @@ bool TransportService::Send(const ClientMessage& acMessage) const noexcept
     return false;
 }
 
+void TransportService::Flush() const noexcept
+{
+    if (!IsConnected())
+        return;
+
+    m_reliableBatch.Flush([this](const uint8_t* apPacket, size_t aSize) { SendRaw(apPacket, aSize, EDelivery::kReliable); });
+    m_unreliableBatch.Flush([this](const uint8_t* apPacket, size_t aSize) { SendRaw(apPacket, aSize, EDelivery::kUnreliable); });
+}
+
+void TransportService::SendRaw(const uint8_t* apData, size_t aSize, EDelivery aDelivery) const noexcept
+{
+    TiltedPhoques::PacketView packet(reinterpret_cast<char*>(const_cast<uint8_t*>(apData)), aSize);
+
+    Client::Send(&packet, aDelivery == EDelivery::kReliable ? EPacketFlags::kReliable : EPacketFlags::kUnreliable);
+}
+
 void TransportService::OnConsume(const void* apData, uint32_t aSize)
 {
     ServerMessageFactory factory;
@@ -105,6 +177,12 @@ void TransportService::OnConsume(const void* apData, uint32_t aSize)
 }
 
 void TransportService::OnConnected()
+{
+    // Most servers run a mod pack, try with the load order hash first
+    SendAuthenticationRequest(false);
+}
+
+void TransportService::SendAuthenticationRequest(bool aFullManifest) const noexcept
 {
     AuthenticationRequest request;
 
@@ -135,6 +213,14 @@ void TransportService::OnConnected()
         entry.Filename = pMod->filename;
     }
 
+    request.ModsHash = request.UserMods.GetHash();
+
+    if (!aFullManifest)
+    {
+        request.UserMods.StandardMods.clear();
+        request.UserMods.LiteMods.clear();
+    }
+
     Send(request);
 }
 
@@ -142,6 +228,12 @@ void TransportService::OnDisconnected(EDisconnectReason aReason)
 {
     m_connected = false;
 
+    // Whatever was streaming is lost with the connection
+    m_outgoingStream = {};
+    m_incomingStream = {};
+    m_reliableBatch = {};
+    m_unreliableBatch = {};
+
     spdlog::warn("Disconnected from server {}", aReason);
 
     m_dispatcher.trigger(DisconnectedEvent());
@@ -154,6 +246,30 @@ void TransportService::OnUpdate()
 void TransportService::HandleUpdate(const UpdateEvent& acEvent) noexcept
 {
     Update();
+
+    if (!m_outgoingStream.IsIdle() && IsConnected())
+    {
+        m_outgoingStream.Update(static_cast<float>(acEvent.Delta), kStreamRate,
+                                [this](const uint8_t* apPacket, size_t aSize) { SendRaw(apPacket, aSize, EDelivery::kReliable); });
+    }
+
+    if (!m_connected)
+        return;
+
+    // Let the server know how loaded we are so it doesn't give us more NPCs than we can simulate
+    m_statsElapsed += acEvent.Delta;
+    ++m_statsFrames;
+
+    if (m_statsElapsed >= 5.0)
+    {
+        RequestClientStats request;
+        request.FrameTime = static_cast<uint32_t>(m_statsElapsed * 1000000.0 / m_statsFrames);
+
+        Send(request);
+
+        m_statsElapsed = 0.0;
+        m_statsFrames = 0;
+    }
 }
 
 void TransportService::OnGridCellChangeEvent(const GridCellChangeEvent& acEvent) const noexcept
@@ -168,7 +284,6 @@ void TransportService::OnGridCellChangeEvent(const GridCellChangeEvent& acEvent)
         request.PlayerCell = acEvent.PlayerCell;
         request.CenterCoords = acEvent.CenterCoords;
         request.PlayerCoords = acEvent.PlayerCoords;
-        request.Cells = acEvent.Cells;
 
         Send(request);
     }
@@ -217,6 +332,25 @@ void TransportService::OnDraw() noexcept
 
         ImGui::InputFloat("User Out kBps", (float*)&uncompressedSent, 0.f, 0.f, "%.3f", ImGuiInputTextFlags_ReadOnly);
         ImGui::InputFloat("User In kBps", (float*)&uncompressedReceived, 0.f, 0.f, "%.3f", ImGuiInputTextFlags_ReadOnly);
+
+        const auto& cStreamStats = m_outgoingStream.GetStats();
+        float streamQueued = float(cStreamStats.QueuedBytes) / 1024.f;
+        float streamSent = float(cStreamStats.SentBytes) / 1024.f;
+        ImGui::InputFloat("Stream Out queued kB", &streamQueued, 0.f, 0.f, "%.3f", ImGuiInputTextFlags_ReadOnly);
+        ImGui::InputFloat("Stream Out total kB", &streamSent, 0.f, 0.f, "%.3f", ImGuiInputTextFlags_ReadOnly);
+        ImGui::ProgressBar(m_outgoingStream.GetProgress(), ImVec2(-1.f, 0.f), "Stream Out");
+
+        const auto cReceivingSize = m_incomingStream.GetTotalSize();
+        const float cReceived = cReceivingSize ? float(m_incomingStream.GetReceivedBytes()) / float(cReceivingSize) : 0.f;
+        ImGui::ProgressBar(cReceived, ImVec2(-1.f, 0.f), "Stream In");
+
+        // Every message that shared a packet saved that packet's overhead
+        int batchedMessages = static_cast<int>(m_reliableBatch.GetStats().Messages + m_unreliableBatch.GetStats().Messages);
+        int batchedPackets = static_cast<int>(m_reliableBatch.GetStats().Packets + m_unreliableBatch.GetStats().Packets);
+        int batchOverhead = static_cast<int>(m_reliableBatch.GetStats().OverheadBytes + m_unreliableBatch.GetStats().OverheadBytes);
+        ImGui::InputInt("Batched messages", &batchedMessages, 0, 0, ImGuiInputTextFlags_ReadOnly);
+        ImGui::InputInt("Batched packets", &batchedPackets, 0, 0, ImGuiInputTextFlags_ReadOnly);
+        ImGui::InputInt("Batch overhead bytes", &batchOverhead, 0, 0, ImGuiInputTextFlags_ReadOnly);
         ImGui::End();
     }
 
@@ -226,9 +360,55 @@ void TransportService::OnDraw() noexcept
         ImVec2(50.f, 50.f), m_connected ? ImColor(0, 230, 64) : ImColor(240, 52, 52));
 }
 
+void TransportService::HandleMessageChunk(const MessageChunk& acChunk) noexcept
+{
+    const auto cResult = m_incomingStream.Add(acChunk);
+    if (cResult == MessageStreamReader::EResult::kInvalid)
+    {
+        spdlog::error("Dropped an invalid message stream from the server");
+        return;
+    }
+
+    if (cResult != MessageStreamReader::EResult::kComplete)
+        return;
+
+    const auto& cMessage = m_incomingStream.GetMessage();
+
+    // A stream can't carry another one, the reassembled buffer would be overwritten while we read it
+    if (cMessage.empty() || cMessage[0] == NotifyMessageChunk::Opcode)
+    {
+        spdlog::error("Invalid streamed message from the server");
+        return;
+    }
+
+    OnConsume(cMessage.data(), static_cast<uint32_t>(cMessage.size()));
+}
+
+void TransportService::HandleMessageBatch(const PackedMessages& acMessages) noexcept
+{
+    const bool cValid = acMessages.Visit([this](const uint8_t* apMessage, size_t aSize) {
+        // Batches are never nested
+        if (apMessage[0] == ServerMessageBatch::Opcode)
+            return;
+
+        OnConsume(apMessage, static_cast<uint32_t>(aSize));
+    });
+
+    if (!cValid)
+        spdlog::error("Malformed message batch from the server");
+}
+
 void TransportService::HandleAuthenticationResponse(const AuthenticationResponse& acMessage) noexcept
 {
+    if (acMessage.ModsRequired)
+    {
+        SendAuthenticationRequest(true);
+        return;
+    }
+
     m_connected = true;
+    m_statsElapsed = 0.0;
+    m_statsFrames = 0;
 
     // Dispatch the mods to anyone who needs it
     m_dispatcher.trigger(acMessage.UserMods);
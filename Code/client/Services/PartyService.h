@@ -3,6 +3,7 @@
 struct ImguiService;
 struct TransportService;
 struct NotifyPlayerList;
+struct NotifyPlayerListDelta;
 struct NotifyPartyInfo;
 struct NotifyPartyInvite;
 struct UpdateEvent;
@@ -18,6 +19,7 @@ protected:
 
     void OnUpdate(const UpdateEvent& acPlayerList) noexcept;
     void OnPlayerList(const NotifyPlayerList& acPlayerList) noexcept;
+    void OnPlayerListDelta(const NotifyPlayerListDelta& acDelta) noexcept;
     void OnPartyInfo(const NotifyPartyInfo& acPartyInfo) noexcept;
     void OnPartyInvite(const NotifyPartyInvite& acPartyInvite) noexcept;
 
@@ -25,6 +27,8 @@ private:
     void OnDraw() noexcept;
 
     Map<uint32_t, String> m_players;
+    uint32_t m_playerListVersion{0};
+    bool m_playerListRequested{false};
     Vector<uint32_t> m_partyMembers;
     Map<uint32_t, uint64_t> m_invitations;
     uint64_t m_nextUpdate{0};
@@ -34,6 +38,7 @@ private:
     entt::scoped_connection m_drawConnection;
     entt::scoped_connection m_updateConnection;
     entt::scoped_connection m_playerListConnection;
+    entt::scoped_connection m_playerListDeltaConnection;
     entt::scoped_connection m_partyInfoConnection;
     entt::scoped_connection m_partyInviteConnection;
 };
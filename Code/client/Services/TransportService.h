@@ -2,6 +2,10 @@
 
 #include <atomic>
 #include <Client.hpp>
+#include <MessageStream.h>
+#include <MessageBatcher.h>
+#include <Messages/ClientMessageBatch.h>
+#include <Messages/RequestMessageChunk.h>
 
 struct ImguiService;
 struct GridCellChangeEvent;
@@ -22,6 +26,10 @@ struct TransportService : Client
     TP_NOCOPYMOVE(TransportService);
 
     bool Send(const ClientMessage& acMessage) const noexcept;
+    // Overrides the delivery class the message type declares
+    bool Send(const ClientMessage& acMessage, EDelivery aDelivery) const noexcept;
+    // Sends the messages batched during the frame
+    void Flush() const noexcept;
 
     void OnConsume(const void* apData, uint32_t aSize) override;
     void OnConnected() override;
@@ -40,12 +48,25 @@ protected:
 
     // Packet handlers
     void HandleAuthenticationResponse(const AuthenticationResponse& acMessage) noexcept;
+    void HandleMessageChunk(const MessageChunk& acChunk) noexcept;
+    void HandleMessageBatch(const PackedMessages& acMessages) noexcept;
+
+    void SendAuthenticationRequest(bool aFullManifest) const noexcept;
+    void SendRaw(const uint8_t* apData, size_t aSize, EDelivery aDelivery) const noexcept;
 
 private:
 
     World& m_world;
     entt::dispatcher& m_dispatcher;
     bool m_connected;
+    double m_statsElapsed{0.0};
+    uint32_t m_statsFrames{0};
+
+    // Send is const for the services, queueing behind a stream is an implementation detail
+    mutable MessageStreamWriter<RequestMessageChunk> m_outgoingStream;
+    MessageStreamReader m_incomingStream;
+    mutable MessageBatcher<ClientMessageBatch> m_reliableBatch;
+    mutable MessageBatcher<ClientMessageBatch> m_unreliableBatch{MessageBatcher<ClientMessageBatch>::kMaxUnreliableSize};
 
     entt::scoped_connection m_updateConnection;
     entt::scoped_connection m_gridCellChangeConnection;
@@ -75,7 +75,8 @@ void AnimationSystem::AddAction(RemoteAnimationComponent& aAnimationComponent, c
     TiltedPhoques::ViewBuffer buffer((uint8_t*)acActionDiff.data(), acActionDiff.size());
     Buffer::Reader reader(&buffer);
 
-    lastProcessedAction.ApplyDifferential(reader);
+    if (!lastProcessedAction.ApplyDifferential(reader))
+        return;
 
     aAnimationComponent.TimePoints.push_back(lastProcessedAction);
 }
@@ -97,6 +98,23 @@ void AnimationSystem::Serialize(World& aWorld, ClientReferencesMoveRequest& aMov
         World::Get().GetModSystem().GetServerModId(pWorldSpace->formID, movement.WorldSpaceId.ModId,
                                                    movement.WorldSpaceId.BaseId);
 
+    // Only send the cell when it changed, repeat it for a bit in case the update is lost and now and then in case
+    // all of them were
+    constexpr uint64_t cCellResendTime = 1000;
+    constexpr uint64_t cCellRefreshTime = 5000;
+
+    const auto cTick = aMovementSnapshot.Tick;
+    if (movement.CellId != localComponent.SentCellId || movement.WorldSpaceId != localComponent.SentWorldSpaceId)
+    {
+        localComponent.SentCellId = movement.CellId;
+        localComponent.SentWorldSpaceId = movement.WorldSpaceId;
+        localComponent.CellResendUntil = cTick + cCellResendTime;
+    }
+
+    movement.HasCell = cTick < localComponent.CellResendUntil || cTick - localComponent.CellSentTick >= cCellRefreshTime;
+    if (movement.HasCell)
+        localComponent.CellSentTick = cTick;
+
     movement.Position = pActor->position;
 
     movement.Rotation.x = pActor->rotation.x;
@@ -8,6 +8,7 @@
 
 #include <Games/References.h>
 #include <World.h>
+#include <DeadReckoning.h>
 
 void InterpolationSystem::Update(Actor* apActor, InterpolationComponent& aInterpolationComponent,
                                  const uint64_t aTick) noexcept
@@ -39,7 +40,10 @@ void InterpolationSystem::Update(Actor* apActor, InterpolationComponent& aInterp
 
     delta = TiltedPhoques::Min(delta, 1.0f);
 
-    const NiPoint3 position{TiltedPhoques::Lerp(first.Position, second.Position, delta)};
+    // The server skips updates while we can guess the movement, past the last point keep going the same way
+    const NiPoint3 position{aTick > second.Tick
+                                ? DeadReckoning::Extrapolate(first.Position, first.Tick, second.Position, second.Tick, aTick)
+                                : TiltedPhoques::Lerp(first.Position, second.Position, delta)};
 
     aInterpolationComponent.Position = position;
 
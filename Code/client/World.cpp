@@ -60,6 +60,9 @@ void World::Update() noexcept
     // Force run this before so we get the tasks scheduled to run
     m_runner.OnUpdate(UpdateEvent(cDeltaSeconds));
     m_dispatcher.trigger(UpdateEvent(cDeltaSeconds));
+
+    // Everything the services sent during the frame goes out together
+    m_transport.Flush();
 }
 
 RunnerService& World::GetRunner() noexcept
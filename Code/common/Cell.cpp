@@ -1,6 +0,0 @@
-#include "Cell.h"
-
-Cell::Cell()
-{
-    
-}
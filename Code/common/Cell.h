@@ -1,11 +1,15 @@
 #pragma once
 
-#include <memory>
+#include <cstdint>
 
-struct Map;
+// Exterior cell entry of a world map file, the layout matches the file so tables can be used in place
 struct Cell
 {
-    using Pointer = std::shared_ptr<Cell>;
+    [[nodiscard]] bool IsValid() const noexcept { return Master != 0; }
 
-    Cell();
+    // 1 based index in the master list of the map file, 0 when there is no cell at these coordinates
+    uint32_t Master{0};
+    uint32_t BaseId{0};
 };
+
+static_assert(sizeof(Cell) == 8, "Cell is read straight from the world map file");
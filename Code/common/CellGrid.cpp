@@ -0,0 +1,23 @@
+#include "CellGrid.h"
+
+CellGrid::CellGrid(const Cell* apCells, int32_t aMinX, int32_t aMinY, uint32_t aWidth, uint32_t aHeight) noexcept
+    : m_pCells(apCells)
+    , m_minX(aMinX)
+    , m_minY(aMinY)
+    , m_width(aWidth)
+    , m_height(aHeight)
+{
+}
+
+const Cell* CellGrid::At(int32_t aX, int32_t aY) const noexcept
+{
+    // Going through unsigned also rejects coordinates below the minimum
+    const auto x = static_cast<uint32_t>(static_cast<int64_t>(aX) - m_minX);
+    const auto y = static_cast<uint32_t>(static_cast<int64_t>(aY) - m_minY);
+
+    if (!m_pCells || x >= m_width || y >= m_height)
+        return nullptr;
+
+    const auto* pCell = &m_pCells[static_cast<size_t>(y) * m_width + x];
+    return pCell->IsValid() ? pCell : nullptr;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Cell.h>
+
+#include <cstddef>
+
+// Dense coordinates -> cell table of a worldspace, the cells are not owned
+struct CellGrid
+{
+    CellGrid() noexcept = default;
+    CellGrid(const Cell* apCells, int32_t aMinX, int32_t aMinY, uint32_t aWidth, uint32_t aHeight) noexcept;
+
+    // Returns nullptr if the coordinates are out of the worldspace or there is no cell there
+    [[nodiscard]] const Cell* At(int32_t aX, int32_t aY) const noexcept;
+
+    [[nodiscard]] uint32_t GetWidth() const noexcept { return m_width; }
+    [[nodiscard]] uint32_t GetHeight() const noexcept { return m_height; }
+
+private:
+
+    const Cell* m_pCells{nullptr};
+    int32_t m_minX{0};
+    int32_t m_minY{0};
+    uint32_t m_width{0};
+    uint32_t m_height{0};
+};
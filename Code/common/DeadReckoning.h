@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+
+// Movement model shared by the server and the clients. Once a receiver runs out of updates it keeps an entity going
+// along the last two points it got, the server runs the same model to know when the receivers are wrong enough to
+// deserve a new update.
+namespace DeadReckoning
+{
+    // Milliseconds an entity keeps moving past its last update, it stops there until the next one arrives
+    static constexpr uint64_t cMaxExtrapolation = 1000;
+
+    template<class T>
+    T Extrapolate(const T& acFrom, uint64_t aFromTick, const T& acTo, uint64_t aToTick, uint64_t aTick) noexcept
+    {
+        if (aToTick <= aFromTick || aTick <= aToTick)
+            return acTo;
+
+        const auto elapsed = std::min(aTick - aToTick, cMaxExtrapolation);
+        const auto factor = static_cast<float>(elapsed) / static_cast<float>(aToTick - aFromTick);
+
+        return acTo + (acTo - acFrom) * factor;
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <TiltedCore/Stl.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Bounded multi producer, multi consumer queue (D. Vyukov's design), capacity must be a power of two.
+// Push and Pop never block, when the queue is full TryPush fails and the caller decides what to drop.
+template <class T>
+struct LocklessQueue
+{
+    explicit LocklessQueue(size_t aCapacity) noexcept
+        : m_mask(aCapacity - 1)
+        , m_cells(std::make_unique<Cell[]>(aCapacity))
+    {
+        assert(aCapacity >= 2 && (aCapacity & m_mask) == 0);
+
+        for (size_t i = 0; i < aCapacity; ++i)
+            m_cells[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~LocklessQueue() noexcept = default;
+
+    TP_NOCOPYMOVE(LocklessQueue);
+
+    bool TryPush(T aValue) noexcept
+    {
+        auto position = m_tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto& cell = m_cells[position & m_mask];
+            const auto sequence = cell.Sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (difference == 0)
+            {
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.Value = std::move(aValue);
+                    cell.Sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                // Full
+                return false;
+            }
+            else
+            {
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool TryPop(T& aValue) noexcept
+    {
+        auto position = m_head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto& cell = m_cells[position & m_mask];
+            const auto sequence = cell.Sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+            if (difference == 0)
+            {
+                if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    aValue = std::move(cell.Value);
+                    cell.Sequence.store(position + m_mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                // Empty
+                return false;
+            }
+            else
+            {
+                position = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Only a hint, other threads may be pushing or popping concurrently
+    [[nodiscard]] size_t ApproximateSize() const noexcept
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        const auto head = m_head.load(std::memory_order_relaxed);
+
+        return tail > head ? tail - head : 0;
+    }
+
+    [[nodiscard]] size_t Capacity() const noexcept
+    {
+        return m_mask + 1;
+    }
+
+private:
+
+    struct Cell
+    {
+        std::atomic<size_t> Sequence{0};
+        T Value{};
+    };
+
+    const size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+
+    alignas(64) std::atomic<size_t> m_head{0};
+    alignas(64) std::atomic<size_t> m_tail{0};
+};
@@ -1,6 +0,0 @@
-#include "Map.h"
-
-Cell* Map::At(int32_t aX, int32_t aY) noexcept
-{
-    return nullptr;
-}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <TiltedCore/Buffer.hpp>
+#include <TiltedCore/Serialization.hpp>
+#include <TiltedCore/Stl.hpp>
+#include <algorithm>
+
+// Values keyed by id kept sorted in a flat vector, for the per entity collections of messages. Iterating is a linear
+// walk and the ids go on the wire as the (small) difference with the previous one instead of in full. Entries added
+// in increasing id order, like when deserializing or walking an entity view, are appended without any search.
+template <class T>
+struct IdMap
+{
+    using value_type = std::pair<uint32_t, T>;
+    using iterator = typename TiltedPhoques::Vector<value_type>::iterator;
+    using const_iterator = typename TiltedPhoques::Vector<value_type>::const_iterator;
+
+    bool operator==(const IdMap& acRhs) const noexcept { return m_entries == acRhs.m_entries; }
+    bool operator!=(const IdMap& acRhs) const noexcept { return !this->operator==(acRhs); }
+
+    T& operator[](uint32_t aId) noexcept;
+    template <class... TArgs> std::pair<iterator, bool> try_emplace(uint32_t aId, TArgs&&... aArgs) noexcept;
+
+    [[nodiscard]] iterator find(uint32_t aId) noexcept;
+    [[nodiscard]] const_iterator find(uint32_t aId) const noexcept;
+    [[nodiscard]] size_t count(uint32_t aId) const noexcept { return find(aId) != end() ? 1 : 0; }
+
+    iterator begin() noexcept { return m_entries.begin(); }
+    iterator end() noexcept { return m_entries.end(); }
+    const_iterator begin() const noexcept { return m_entries.begin(); }
+    const_iterator end() const noexcept { return m_entries.end(); }
+
+    [[nodiscard]] size_t size() const noexcept { return m_entries.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_entries.empty(); }
+    void clear() noexcept { m_entries.clear(); }
+    void reserve(size_t aCount) noexcept { m_entries.reserve(aCount); }
+
+    // The count is left to the message, each message has its own way of sending it
+    // aSerialize(const T& acValue, Buffer::Writer& aWriter) writes a value
+    template <class TFunc> void Serialize(TiltedPhoques::Buffer::Writer& aWriter, const TFunc& aSerialize) const noexcept;
+    // aDeserialize(T& aValue, Buffer::Reader& aReader) reads a value, replaces what was in the map
+    template <class TFunc> void Deserialize(TiltedPhoques::Buffer::Reader& aReader, size_t aCount, const TFunc& aDeserialize) noexcept;
+
+private:
+
+    // More than any message carries, only a malformed count goes past it
+    static constexpr size_t kMaxReserved = 4096;
+
+    iterator LowerBound(uint32_t aId) noexcept;
+
+    TiltedPhoques::Vector<value_type> m_entries;
+};
+
+template <class T>
+T& IdMap<T>::operator[](uint32_t aId) noexcept
+{
+    return try_emplace(aId).first->second;
+}
+
+template <class T>
+template <class... TArgs>
+std::pair<typename IdMap<T>::iterator, bool> IdMap<T>::try_emplace(uint32_t aId, TArgs&&... aArgs) noexcept
+{
+    auto itor = LowerBound(aId);
+    if (itor != end() && itor->first == aId)
+        return {itor, false};
+
+    itor = m_entries.emplace(itor, std::piecewise_construct, std::forward_as_tuple(aId), std::forward_as_tuple(std::forward<TArgs>(aArgs)...));
+    return {itor, true};
+}
+
+template <class T>
+typename IdMap<T>::iterator IdMap<T>::find(uint32_t aId) noexcept
+{
+    auto itor = LowerBound(aId);
+    return itor != end() && itor->first == aId ? itor : end();
+}
+
+template <class T>
+typename IdMap<T>::const_iterator IdMap<T>::find(uint32_t aId) const noexcept
+{
+    return const_cast<IdMap*>(this)->find(aId);
+}
+
+template <class T>
+typename IdMap<T>::iterator IdMap<T>::LowerBound(uint32_t aId) noexcept
+{
+    // Appending is by far the most common case
+    if (m_entries.empty() || m_entries.back().first < aId)
+        return end();
+
+    return std::lower_bound(begin(), end(), aId, [](const value_type& acEntry, uint32_t aId) { return acEntry.first < aId; });
+}
+
+template <class T>
+template <class TFunc>
+void IdMap<T>::Serialize(TiltedPhoques::Buffer::Writer& aWriter, const TFunc& aSerialize) const noexcept
+{
+    uint32_t previousId = 0;
+    for (const auto& [id, value] : m_entries)
+    {
+        TiltedPhoques::Serialization::WriteVarInt(aWriter, id - previousId);
+        aSerialize(value, aWriter);
+
+        previousId = id;
+    }
+}
+
+template <class T>
+template <class TFunc>
+void IdMap<T>::Deserialize(TiltedPhoques::Buffer::Reader& aReader, size_t aCount, const TFunc& aDeserialize) noexcept
+{
+    m_entries.clear();
+    // The count comes from the wire, it doesn't get to decide how much is allocated up front
+    m_entries.reserve(std::min(aCount, kMaxReserved));
+
+    uint32_t id = 0;
+    for (size_t i = 0; i < aCount; ++i)
+    {
+        // Every entry takes at least a byte, stop once the reader runs dry instead of looping over a bogus count
+        const auto cPosition = aReader.GetBytePosition();
+        id += static_cast<uint32_t>(TiltedPhoques::Serialization::ReadVarInt(aReader) & 0xFFFFFFFF);
+        if (aReader.GetBytePosition() == cPosition)
+            break;
+
+        // A well formed message only ever appends, anything else still ends up sorted
+        auto& value = (m_entries.empty() || m_entries.back().first < id) ? m_entries.emplace_back(id, T{}).second : operator[](id);
+        aDeserialize(value, aReader);
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Structs/PackedMessages.h>
+#include <TiltedCore/Buffer.hpp>
+#include <algorithm>
+
+// Collects the small messages sent during a frame and sends them as one packet when flushed, so a busy frame costs
+// one packet's overhead instead of one per message and the transport compresses them together. One batcher per
+// delivery class, T is the batch message type of the direction (ServerMessageBatch or ClientMessageBatch).
+template <class T>
+struct MessageBatcher
+{
+    // Unreliable batches have to fit in a single packet, losing any fragment of a larger one would lose every message
+    // in it instead of just one
+    static constexpr size_t kMaxUnreliableSize = 1100;
+
+    struct Stats
+    {
+        uint64_t Messages{0};
+        uint64_t Packets{0};
+        // Bytes added by the batch headers and length prefixes
+        uint64_t OverheadBytes{0};
+    };
+
+    // Adds a serialized packet, returns false if it is too large to be batched and has to be sent on its own, what was
+    // batched before it is flushed first so the order is kept. aSend(const uint8_t* apPacket, size_t aSize) sends a packet.
+    // aMaxSize is the most a batch holds before it is sent, at most PackedMessages::kMaxSize
+    explicit MessageBatcher(size_t aMaxSize = PackedMessages::kMaxSize) noexcept
+        : m_maxSize(std::min(aMaxSize, PackedMessages::kMaxSize))
+    {
+    }
+
+    template <class TSend> [[nodiscard]] bool Add(const uint8_t* apPacket, size_t aSize, const TSend& aSend) noexcept;
+    template <class TSend> void Flush(const TSend& aSend) noexcept;
+
+    [[nodiscard]] bool IsEmpty() const noexcept { return m_count == 0; }
+    [[nodiscard]] const Stats& GetStats() const noexcept { return m_stats; }
+
+private:
+
+    T m_batch;
+    size_t m_maxSize;
+    uint32_t m_count{0};
+    size_t m_messageBytes{0};
+    Stats m_stats;
+};
+
+template <class T>
+template <class TSend>
+bool MessageBatcher<T>::Add(const uint8_t* apPacket, size_t aSize, const TSend& aSend) noexcept
+{
+    // The first byte belongs to the transport, it isn't part of the message
+    // Larger messages gain little from sharing a packet, they go out on their own
+    if (aSize <= 1 || aSize - 1 > m_maxSize / 4)
+    {
+        Flush(aSend);
+        return false;
+    }
+
+    if (!m_batch.Messages.Append(apPacket + 1, aSize - 1, m_maxSize))
+    {
+        Flush(aSend);
+
+        if (!m_batch.Messages.Append(apPacket + 1, aSize - 1, m_maxSize))
+            return false;
+    }
+
+    ++m_count;
+    m_messageBytes += aSize - 1;
+    ++m_stats.Messages;
+
+    return true;
+}
+
+template <class T>
+template <class TSend>
+void MessageBatcher<T>::Flush(const TSend& aSend) noexcept
+{
+    if (m_count == 0)
+        return;
+
+    Buffer buffer(m_batch.Messages.Data.size() + 16);
+    Buffer::Writer writer(&buffer);
+    writer.WriteBits(0, 8); // Skip the first byte as it is used by packet
+
+    if (m_count == 1)
+    {
+        // Not worth a batch, send the message as it was
+        (void)m_batch.Messages.Visit([&writer](const uint8_t* apMessage, size_t aSize) { writer.WriteBytes(apMessage, aSize); });
+    }
+    else
+    {
+        m_batch.Serialize(writer);
+        m_stats.OverheadBytes += writer.Size() - 1 - m_messageBytes;
+    }
+
+    aSend(buffer.GetWriteData(), writer.Size());
+
+    ++m_stats.Packets;
+    m_batch.Messages.Data.clear();
+    m_count = 0;
+    m_messageBytes = 0;
+}
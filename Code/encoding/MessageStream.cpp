@@ -0,0 +1,55 @@
+#include <MessageStream.h>
+
+#include <algorithm>
+
+TiltedPhoques::Buffer& MessageStream::GetScratch() noexcept
+{
+    static thread_local TiltedPhoques::Buffer s_buffer(kSerializeBufferSize);
+    return s_buffer;
+}
+
+MessageStreamReader::EResult MessageStreamReader::Add(const MessageChunk& acChunk) noexcept
+{
+    if (acChunk.Offset == 0)
+    {
+        if (acChunk.StreamId == 0 || acChunk.TotalSize == 0 || acChunk.TotalSize > MessageStream::kMaxMessageSize)
+        {
+            Reset();
+            return EResult::kInvalid;
+        }
+
+        m_streamId = acChunk.StreamId;
+        m_totalSize = acChunk.TotalSize;
+        m_data.clear();
+        // The size comes from the other side, only trust it with a few chunks until they actually arrive
+        m_data.reserve(std::min<size_t>(m_totalSize, 4 * MessageStream::kChunkSize));
+    }
+    else if (acChunk.StreamId != m_streamId || acChunk.TotalSize != m_totalSize || acChunk.Offset != m_data.size())
+    {
+        Reset();
+        return EResult::kInvalid;
+    }
+
+    if (acChunk.Data.empty() || acChunk.Data.size() > m_totalSize - m_data.size())
+    {
+        Reset();
+        return EResult::kInvalid;
+    }
+
+    m_data.insert(std::end(m_data), std::begin(acChunk.Data), std::end(acChunk.Data));
+
+    if (m_data.size() < m_totalSize)
+        return EResult::kIncomplete;
+
+    m_streamId = 0;
+    ++m_receivedMessages;
+
+    return EResult::kComplete;
+}
+
+void MessageStreamReader::Reset() noexcept
+{
+    m_streamId = 0;
+    m_totalSize = 0;
+    m_data.clear();
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <Structs/MessageChunk.h>
+#include <TiltedCore/Buffer.hpp>
+#include <TiltedCore/Stl.hpp>
+
+// Messages too large for a single packet are serialized once and streamed as reliable chunks at a limited rate,
+// instead of going out as one huge packet that everything sent after it has to wait for. Unreliable traffic keeps
+// going out between chunks, reliable messages queue behind the stream so the other side still sees them in order.
+struct MessageStream
+{
+    // Largest message that can be serialized and reassembled
+    static constexpr size_t kMaxMessageSize = 4 * 1024 * 1024;
+    // Messages are serialized into twice as much. A write that doesn't fit is dropped without moving the writer and
+    // messages don't report it, but no single field is larger than a whole message, so a dropped write always leaves
+    // more than kMaxMessageSize written and IsTruncated catches it.
+    static constexpr size_t kSerializeBufferSize = 2 * kMaxMessageSize;
+
+    [[nodiscard]] static bool IsTruncated(const TiltedPhoques::Buffer::Writer& acWriter) noexcept
+    {
+        return acWriter.Size() > kMaxMessageSize;
+    }
+    static constexpr size_t kChunkSize = MessageChunk::kMaxSize;
+
+    // Serializes with acSerialize(Buffer::Writer&) into aData for structures that don't report failed writes.
+    // Returns false with aData empty if the output doesn't fit in kMaxMessageSize. Calls can't be nested.
+    template <class T> static bool Serialize(TiltedPhoques::Vector<uint8_t>& aData, const T& acSerialize) noexcept;
+
+private:
+
+    // kSerializeBufferSize bytes shared by every Serialize call of the thread
+    static TiltedPhoques::Buffer& GetScratch() noexcept;
+};
+
+// Outgoing side, T is the chunk message type of the direction (NotifyMessageChunk or RequestMessageChunk)
+template <class T>
+struct MessageStreamWriter
+{
+    struct Stats
+    {
+        uint64_t SentBytes{0};
+        uint64_t SentMessages{0};
+        // Bytes waiting to be sent, streams and the reliable messages queued behind them
+        uint32_t QueuedBytes{0};
+    };
+
+    // Takes a serialized packet that has to arrive reliably, returns false if it can be sent as is right away
+    [[nodiscard]] bool Queue(const uint8_t* apPacket, size_t aSize) noexcept;
+    // Sends what aBytesPerSecond allows for this frame, aSend(const uint8_t* apPacket, size_t aSize) sends a packet
+    template <class TSend> void Update(float aDelta, uint32_t aBytesPerSecond, const TSend& aSend) noexcept;
+
+    [[nodiscard]] bool IsIdle() const noexcept { return m_pending.empty(); }
+    [[nodiscard]] const Stats& GetStats() const noexcept { return m_stats; }
+    // How much of the stream being sent went out, between 0 and 1
+    [[nodiscard]] float GetProgress() const noexcept;
+
+private:
+
+    struct Pending
+    {
+        // Still has the leading byte the transport uses, it isn't part of the streamed message
+        Vector<uint8_t> Packet;
+        // 0 for a reliable message that fits a packet and only waits for its turn
+        uint32_t StreamId;
+        size_t Offset;
+    };
+
+    // Never let more than a few chunks go out in the same frame after an idle period
+    static constexpr float kMaxBurst = static_cast<float>(4 * MessageStream::kChunkSize);
+
+    Vector<Pending> m_pending;
+    // Chunk packets are small, one buffer serves every chunk
+    TiltedPhoques::Buffer m_buffer{MessageStream::kChunkSize + 64};
+    float m_budget{0.f};
+    uint32_t m_nextStreamId{1};
+    Stats m_stats;
+};
+
+// Incoming side, chunks are reliable and in order so only one stream is ever being reassembled
+struct MessageStreamReader
+{
+    enum class EResult
+    {
+        kIncomplete,
+        kComplete,
+        // The chunk doesn't continue the stream, whatever was received so far is dropped
+        kInvalid
+    };
+
+    [[nodiscard]] EResult Add(const MessageChunk& acChunk) noexcept;
+
+    // The reassembled message once Add returned kComplete, without the transport byte, valid until the next Add
+    [[nodiscard]] const Vector<uint8_t>& GetMessage() const noexcept { return m_data; }
+    [[nodiscard]] uint32_t GetReceivedBytes() const noexcept { return m_streamId ? static_cast<uint32_t>(m_data.size()) : 0; }
+    [[nodiscard]] uint32_t GetTotalSize() const noexcept { return m_streamId ? m_totalSize : 0; }
+    [[nodiscard]] uint64_t GetReceivedMessages() const noexcept { return m_receivedMessages; }
+
+private:
+
+    void Reset() noexcept;
+
+    uint32_t m_streamId{0};
+    uint32_t m_totalSize{0};
+    uint64_t m_receivedMessages{0};
+    Vector<uint8_t> m_data;
+};
+
+template <class T>
+bool MessageStream::Serialize(TiltedPhoques::Vector<uint8_t>& aData, const T& acSerialize) noexcept
+{
+    auto& buffer = GetScratch();
+    TiltedPhoques::Buffer::Writer writer(&buffer);
+
+    acSerialize(writer);
+
+    if (IsTruncated(writer))
+    {
+        aData.clear();
+        return false;
+    }
+
+    aData.assign(buffer.GetData(), buffer.GetData() + writer.Size());
+    return true;
+}
+
+template <class T>
+bool MessageStreamWriter<T>::Queue(const uint8_t* apPacket, size_t aSize) noexcept
+{
+    const bool cLarge = aSize > MessageStream::kChunkSize;
+    if (!cLarge && m_pending.empty())
+        return false;
+
+    auto& pending = m_pending.emplace_back();
+    pending.Packet.assign(apPacket, apPacket + aSize);
+    pending.StreamId = cLarge ? m_nextStreamId++ : 0;
+    pending.Offset = 1;
+
+    // 0 means not streamed
+    if (m_nextStreamId == 0)
+        m_nextStreamId = 1;
+
+    m_stats.QueuedBytes += static_cast<uint32_t>(cLarge ? aSize - 1 : aSize);
+
+    return true;
+}
+
+template <class T>
+template <class TSend>
+void MessageStreamWriter<T>::Update(float aDelta, uint32_t aBytesPerSecond, const TSend& aSend) noexcept
+{
+    if (m_pending.empty())
+    {
+        m_budget = 0.f;
+        return;
+    }
+
+    m_budget = std::min(m_budget + static_cast<float>(aBytesPerSecond) * aDelta, kMaxBurst);
+
+    T message;
+
+    size_t count = 0;
+    while (count < m_pending.size() && m_budget > 0.f)
+    {
+        auto& pending = m_pending[count];
+        const auto cRemaining = pending.Packet.size() - pending.Offset;
+        size_t sent = 0;
+
+        if (pending.StreamId == 0)
+        {
+            aSend(pending.Packet.data(), pending.Packet.size());
+            sent = pending.Packet.size();
+        }
+        else
+        {
+            auto& chunk = message.Chunk;
+            chunk.StreamId = pending.StreamId;
+            chunk.TotalSize = static_cast<uint32_t>(pending.Packet.size() - 1);
+            chunk.Offset = static_cast<uint32_t>(pending.Offset - 1);
+
+            const auto cSize = std::min(cRemaining, MessageStream::kChunkSize);
+            chunk.Data.assign(pending.Packet.data() + pending.Offset, pending.Packet.data() + pending.Offset + cSize);
+
+            Buffer::Writer writer(&m_buffer);
+            writer.WriteBits(0, 8); // Skip the first byte as it is used by packet
+            message.Serialize(writer);
+
+            aSend(m_buffer.GetWriteData(), writer.Size());
+
+            pending.Offset += cSize;
+            sent = cSize;
+        }
+
+        m_budget -= static_cast<float>(sent);
+        m_stats.SentBytes += sent;
+        m_stats.QueuedBytes -= static_cast<uint32_t>(std::min<size_t>(sent, m_stats.QueuedBytes));
+
+        if (pending.StreamId == 0 || pending.Offset == pending.Packet.size())
+        {
+            ++m_stats.SentMessages;
+            ++count;
+        }
+    }
+
+    m_pending.erase(std::begin(m_pending), std::begin(m_pending) + count);
+    if (m_pending.empty())
+        m_stats.QueuedBytes = 0;
+}
+
+template <class T>
+float MessageStreamWriter<T>::GetProgress() const noexcept
+{
+    if (m_pending.empty() || m_pending.front().Packet.size() <= 1)
+        return 0.f;
+
+    const auto& cPending = m_pending.front();
+    return static_cast<float>(cPending.Offset - 1) / static_cast<float>(cPending.Packet.size() - 1);
+}
@@ -9,13 +9,24 @@ void AssignCharacterRequest::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter
     WorldSpaceId.Serialize(aWriter);
     Position.Serialize(aWriter);
     Rotation.Serialize(aWriter);
+    Serialization::WriteBool(aWriter, Brief);
     aWriter.WriteBits(ChangeFlags, 32);
-    Serialization::WriteString(aWriter, AppearanceBuffer);
-    InventoryContent.Serialize(aWriter);
-    FactionsContent.Serialize(aWriter);
+
+    if (!Brief)
+    {
+        Serialization::WriteString(aWriter, AppearanceBuffer);
+        InventoryContent.Serialize(aWriter);
+        FactionsContent.Serialize(aWriter);
+    }
+
     LatestAction.GenerateDifferential(ActionEvent{}, aWriter);
-    QuestContent.Serialize(aWriter);
-    FaceTints.Serialize(aWriter);
+
+    if (!Brief)
+    {
+        QuestContent.Serialize(aWriter);
+        FaceTints.Serialize(aWriter);
+    }
+
     AllActorValues.Serialize(aWriter);
     Serialization::WriteBool(aWriter, IsDead);
 }
@@ -31,23 +42,35 @@ void AssignCharacterRequest::DeserializeRaw(TiltedPhoques::Buffer::Reader& aRead
     WorldSpaceId.Deserialize(aReader);
     Position.Deserialize(aReader);
     Rotation.Deserialize(aReader);
+    Brief = Serialization::ReadBool(aReader);
 
     uint64_t dest = 0;
     aReader.ReadBits(dest, 32);
     ChangeFlags = dest & 0xFFFFFFFF;
 
-    AppearanceBuffer = Serialization::ReadString(aReader);
+    AppearanceBuffer = {};
     InventoryContent = {};
-    InventoryContent.Deserialize(aReader);
-
     FactionsContent = {};
-    FactionsContent.Deserialize(aReader);
+
+    if (!Brief)
+    {
+        AppearanceBuffer = Serialization::ReadString(aReader);
+        InventoryContent.Deserialize(aReader);
+        FactionsContent.Deserialize(aReader);
+    }
 
     LatestAction = ActionEvent{};
     LatestAction.ApplyDifferential(aReader);
 
-    QuestContent.Deserialize(aReader);
-    FaceTints.Deserialize(aReader);
+    QuestContent = {};
+    FaceTints = {};
+
+    if (!Brief)
+    {
+        QuestContent.Deserialize(aReader);
+        FaceTints.Deserialize(aReader);
+    }
+
     AllActorValues.Deserialize(aReader);
     IsDead = Serialization::ReadBool(aReader);
 }
@@ -45,6 +45,7 @@ struct AssignCharacterRequest final : ClientMessage
             QuestContent == acRhs.QuestContent &&
             AllActorValues == acRhs.AllActorValues &&
             IsDead == acRhs.IsDead &&
+            Brief == acRhs.Brief &&
             GetOpcode() == acRhs.GetOpcode();
     }
 
@@ -64,4 +65,6 @@ struct AssignCharacterRequest final : ClientMessage
     Tints FaceTints{};
     ActorValues AllActorValues{};
     bool IsDead{};
+    // Sent for references the server already knew, appearance, inventory, factions, quests and tints are left out
+    bool Brief{false};
 };
@@ -3,21 +3,40 @@
 void AssignCharacterResponse::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
 {
     Serialization::WriteBool(aWriter, Owner);
+    Serialization::WriteBool(aWriter, StateRequired);
     Serialization::WriteVarInt(aWriter, Cookie);
     Serialization::WriteVarInt(aWriter, ServerId);
     Position.Serialize(aWriter);
     CellId.Serialize(aWriter);
     AllActorValues.Serialize(aWriter);
     Serialization::WriteBool(aWriter, IsDead);
+    Serialization::WriteBool(aWriter, Restored);
+
+    if (Restored)
+    {
+        InventoryContent.Serialize(aWriter);
+        FactionsContent.Serialize(aWriter);
+    }
 }
 
 void AssignCharacterResponse::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
 {
     Owner = Serialization::ReadBool(aReader);
+    StateRequired = Serialization::ReadBool(aReader);
     Cookie = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
     ServerId = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
     Position.Deserialize(aReader);
     CellId.Deserialize(aReader);
     AllActorValues.Deserialize(aReader);
     IsDead = Serialization::ReadBool(aReader);
+    Restored = Serialization::ReadBool(aReader);
+
+    InventoryContent = {};
+    FactionsContent = {};
+
+    if (Restored)
+    {
+        InventoryContent.Deserialize(aReader);
+        FactionsContent.Deserialize(aReader);
+    }
 }
@@ -3,6 +3,8 @@
 #include "Message.h"
 #include <Structs/Mods.h>
 #include <Structs/ActorValues.h>
+#include <Structs/Factions.h>
+#include <Structs/Inventory.h>
 #include <Structs/Vector3_NetQuantize.h>
 #include <Structs/GameId.h>
 
@@ -21,19 +23,30 @@ struct AssignCharacterResponse final : ServerMessage
     {
         return GetOpcode() == achRhs.GetOpcode() &&
             Owner == achRhs.Owner &&
+            StateRequired == achRhs.StateRequired &&
             Cookie == achRhs.Cookie &&
             ServerId == achRhs.ServerId &&
             Position == achRhs.Position &&
             CellId == achRhs.CellId &&
             IsDead == achRhs.IsDead &&
-            AllActorValues == achRhs.AllActorValues;
+            AllActorValues == achRhs.AllActorValues &&
+            Restored == achRhs.Restored &&
+            InventoryContent == achRhs.InventoryContent &&
+            FactionsContent == achRhs.FactionsContent;
     }
 
     bool Owner{ false };
+    // The request was brief but the server no longer has the character, the client must send it again in full
+    bool StateRequired{ false };
     uint32_t Cookie{};
     uint32_t ServerId{};
     Vector3_NetQuantize Position{};
     GameId CellId{};
     ActorValues AllActorValues{};
     bool IsDead{};
+    // The server brought back the state it kept for a dormant character, the owner's copy was reset and has to be
+    // replaced. Inventory and factions are only sent in that case.
+    bool Restored{ false };
+    Inventory InventoryContent{};
+    Factions FactionsContent{};
 };
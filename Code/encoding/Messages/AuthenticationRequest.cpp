@@ -4,6 +4,7 @@ void AuthenticationRequest::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter)
 {
     Serialization::WriteVarInt(aWriter, DiscordId);
     Serialization::WriteString(aWriter, Token);
+    aWriter.WriteBits(ModsHash, 64);
     UserMods.Serialize(aWriter);
     Serialization::WriteString(aWriter, Username);
 }
@@ -14,6 +15,7 @@ void AuthenticationRequest::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReade
 
     DiscordId = Serialization::ReadVarInt(aReader);
     Token = Serialization::ReadString(aReader);
+    aReader.ReadBits(ModsHash, 64);
     UserMods.Deserialize(aReader);
     Username = Serialization::ReadString(aReader);
 }
@@ -21,6 +21,7 @@ struct AuthenticationRequest final : ClientMessage
     {
         return DiscordId == achRhs.DiscordId &&
             Token == achRhs.Token && 
+            ModsHash == achRhs.ModsHash &&
             UserMods == achRhs.UserMods && 
             Username == achRhs.Username &&
             GetOpcode() == achRhs.GetOpcode();
@@ -28,6 +29,8 @@ struct AuthenticationRequest final : ClientMessage
 
     uint64_t DiscordId;
     String Token;
+    // The server may know the load order from another player, in which case UserMods is left empty
+    uint64_t ModsHash{0};
     Mods UserMods;
     String Username;
 };
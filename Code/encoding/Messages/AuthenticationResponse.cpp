@@ -3,6 +3,7 @@
 void AuthenticationResponse::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
 {
     Serialization::WriteBool(aWriter, Accepted);
+    Serialization::WriteBool(aWriter, ModsRequired);
     UserMods.Serialize(aWriter);
     ServerScripts.Serialize(aWriter);
     ReplicatedObjects.Serialize(aWriter);
@@ -11,6 +12,7 @@ void AuthenticationResponse::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter
 void AuthenticationResponse::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
 {
     Accepted = Serialization::ReadBool(aReader);
+    ModsRequired = Serialization::ReadBool(aReader);
     UserMods.Deserialize(aReader);
     ServerScripts.Deserialize(aReader);
     ReplicatedObjects.Deserialize(aReader);
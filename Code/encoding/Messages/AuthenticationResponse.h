@@ -20,12 +20,15 @@ struct AuthenticationResponse final : ServerMessage
     {
         return GetOpcode() == achRhs.GetOpcode() && 
             Accepted == achRhs.Accepted && 
+            ModsRequired == achRhs.ModsRequired &&
             UserMods == achRhs.UserMods && 
             ServerScripts == achRhs.ServerScripts &&
             ReplicatedObjects == achRhs.ReplicatedObjects;
     }
 
     bool Accepted{ false };
+    // The server doesn't know the manifest hash, the client has to authenticate again with its full mod list
+    bool ModsRequired{ false };
     Mods UserMods{};
     Scripts ServerScripts{};
     FullObjects ReplicatedObjects{};
@@ -39,6 +39,7 @@ struct CharacterSpawnRequest final : ServerMessage
             FactionsContent == acRhs.FactionsContent &&
             FaceTints == acRhs.FaceTints &&
             IsDead == acRhs.IsDead &&
+            Prefetch == acRhs.Prefetch &&
             GetOpcode() == acRhs.GetOpcode();
     }
 
@@ -56,4 +57,6 @@ struct CharacterSpawnRequest final : ServerMessage
     Tints FaceTints{};
     ActorValues InitialActorValues{};
     bool IsDead{};
+    // Sent ahead of a grid shift, the client should hold on to it until the character's cell is loaded
+    bool Prefetch{};
 };
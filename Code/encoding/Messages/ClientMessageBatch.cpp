@@ -0,0 +1,13 @@
+#include <Messages/ClientMessageBatch.h>
+
+void ClientMessageBatch::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Messages.Serialize(aWriter);
+}
+
+void ClientMessageBatch::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ClientMessage::DeserializeRaw(aReader);
+
+    Messages.Deserialize(aReader);
+}
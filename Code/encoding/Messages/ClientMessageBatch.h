@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Message.h"
+#include <Structs/PackedMessages.h>
+
+// Several messages sent in the same frame, packed into one packet
+struct ClientMessageBatch final : ClientMessage
+{
+    static constexpr ClientOpcode Opcode = kClientMessageBatch;
+
+    ClientMessageBatch() : ClientMessage(Opcode)
+    {
+    }
+
+    virtual ~ClientMessageBatch() = default;
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const ClientMessageBatch& achRhs) const noexcept
+    {
+        return Messages == achRhs.Messages &&
+            GetOpcode() == achRhs.GetOpcode();
+    }
+
+    PackedMessages Messages{};
+};
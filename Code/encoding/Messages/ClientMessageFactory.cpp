@@ -4,6 +4,7 @@
 
 static std::function<UniquePtr<ClientMessage>(TiltedPhoques::Buffer::Reader& aReader)>
     s_clientMessageExtractor[kClientOpcodeMax];
+static MessageTraits s_clientMessageTraits[kClientOpcodeMax];
 
 namespace details
 {
@@ -20,6 +21,8 @@ namespace details
                     return TiltedPhoques::CastUnique<ClientMessage>(std::move(ptr));
                 };
 
+                s_clientMessageTraits[T::Opcode] = MessageTraits{T::Delivery, T::Lane};
+
                 return false;
             };
 
@@ -40,3 +43,11 @@ UniquePtr<ClientMessage> ClientMessageFactory::Extract(TiltedPhoques::Buffer::Re
     const auto opcode = static_cast<ClientOpcode>(data);
     return s_clientMessageExtractor[opcode](aReader);
 }
+
+MessageTraits ClientMessageFactory::GetTraits(ClientOpcode aOpcode) noexcept
+{
+    if (aOpcode >= kClientOpcodeMax) [[unlikely]]
+        return {};
+
+    return s_clientMessageTraits[aOpcode];
+}
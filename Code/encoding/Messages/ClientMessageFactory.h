@@ -28,12 +28,18 @@
 #include <Messages/EnterExteriorCellRequest.h>
 #include <Messages/RequestOwnershipClaim.h>
 #include <Messages/RequestObjectInventoryChanges.h>
+#include <Messages/RequestPlayerList.h>
+#include <Messages/RequestClientStats.h>
+#include <Messages/RequestMessageChunk.h>
+#include <Messages/ClientMessageBatch.h>
 
 using TiltedPhoques::UniquePtr;
 
 struct ClientMessageFactory
 {
     UniquePtr<ClientMessage> Extract(TiltedPhoques::Buffer::Reader& aReader) const noexcept;
+    // Delivery class and lane the message type declares
+    [[nodiscard]] static MessageTraits GetTraits(ClientOpcode aOpcode) noexcept;
 
     template <class T>
     static auto Visit(T&& func)
@@ -45,7 +51,8 @@ struct ClientMessageFactory
                                  RequestActorValueChanges, RequestActorMaxValueChanges, EnterExteriorCellRequest,
                                  RequestHealthChangeBroadcast, RequestSpawnData, ActivateRequest, LockChangeRequest,
                                  AssignObjectsRequest, RequestDeathStateChange, ShiftGridCellRequest, RequestOwnershipTransfer,
-                                 RequestOwnershipClaim, RequestObjectInventoryChanges>;
+                                 RequestOwnershipClaim, RequestObjectInventoryChanges, RequestPlayerList, RequestClientStats,
+                                 RequestMessageChunk, ClientMessageBatch>;
 
         return s_visitor(std::forward<T>(func));
     }
@@ -6,11 +6,7 @@ void ClientReferencesMoveRequest::SerializeRaw(TiltedPhoques::Buffer::Writer& aW
     Serialization::WriteVarInt(aWriter, Tick);
     Serialization::WriteVarInt(aWriter, Updates.size());
 
-    for (const auto& kvp : Updates)
-    {
-        Serialization::WriteVarInt(aWriter, kvp.first);
-        kvp.second.Serialize(aWriter);
-    }
+    Updates.Serialize(aWriter, [](const ReferenceUpdate& acUpdate, TiltedPhoques::Buffer::Writer& aWriter) { acUpdate.Serialize(aWriter); });
 }
 
 void ClientReferencesMoveRequest::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
@@ -20,9 +16,12 @@ void ClientReferencesMoveRequest::DeserializeRaw(TiltedPhoques::Buffer::Reader&
     Tick = Serialization::ReadVarInt(aReader);
     const auto count = Serialization::ReadVarInt(aReader);
 
-    for (auto i = 0u; i < count; ++i)
-    {
-        uint32_t serverId = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
-        Updates[serverId].Deserialize(aReader);
-    }
+    // The updates that follow a bad one can't be read, drop them all, another move request comes next tick
+    bool valid = true;
+    Updates.Deserialize(aReader, count, [&valid](ReferenceUpdate& aUpdate, TiltedPhoques::Buffer::Reader& aReader) {
+        valid = valid && aUpdate.Deserialize(aReader);
+    });
+
+    if (!valid)
+        Updates.clear();
 }
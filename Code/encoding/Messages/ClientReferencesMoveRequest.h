@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Message.h"
+#include <IdMap.h>
 #include <Structs/ReferenceUpdate.h>
 #include <TiltedCore/Stl.hpp>
 
@@ -10,6 +11,8 @@ using TiltedPhoques::Map;
 struct ClientReferencesMoveRequest final : ClientMessage
 {
     static constexpr ClientOpcode Opcode = kClientReferencesMoveRequest;
+    static constexpr EDelivery Delivery = EDelivery::kUnreliable;
+    static constexpr ELane Lane = ELane::kMovement;
 
     ClientReferencesMoveRequest() : ClientMessage(Opcode)
     {
@@ -27,5 +30,5 @@ struct ClientReferencesMoveRequest final : ClientMessage
     }
     
     uint64_t Tick{};
-    Map<uint32_t, ReferenceUpdate> Updates{};
+    IdMap<ReferenceUpdate> Updates{};
 };
@@ -8,8 +8,36 @@
 using TiltedPhoques::String;
 using TiltedPhoques::Serialization;
 
+// How a message travels. Messages override these next to their opcode, anything else is reliable state.
+enum class EDelivery : uint8_t
+{
+    // Guaranteed and in order, for state the other side can't rebuild
+    kReliable,
+    // May be lost, the next message of the same type replaces it anyway
+    kUnreliable
+};
+
+enum class ELane : uint8_t
+{
+    // Gameplay state, goes out right away
+    kState,
+    // Snapshots, merged with the next ones when the connection is backed up
+    kMovement,
+    // Large payloads that can wait, held back while the connection is backed up
+    kBulk
+};
+
+struct MessageTraits
+{
+    EDelivery Delivery{EDelivery::kReliable};
+    ELane Lane{ELane::kState};
+};
+
 struct ClientMessage : TiltedPhoques::AllocatorCompatible
 {
+    static constexpr EDelivery Delivery = EDelivery::kReliable;
+    static constexpr ELane Lane = ELane::kState;
+
     ClientMessage(ClientOpcode aOpcode)
         : m_opcode(aOpcode)
     {}
@@ -33,6 +61,9 @@ private:
 
 struct ServerMessage : TiltedPhoques::AllocatorCompatible
 {
+    static constexpr EDelivery Delivery = EDelivery::kReliable;
+    static constexpr ELane Lane = ELane::kState;
+
     ServerMessage(ServerOpcode aOpcode)
         : m_opcode(aOpcode)
     {}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Message.h"
+#include <IdMap.h>
 #include <TiltedCore/Buffer.hpp>
 #include <Structs/Inventory.h>
 
@@ -23,5 +24,5 @@ struct NotifyCharacterInventoryChanges final : ServerMessage
             GetOpcode() == acRhs.GetOpcode();
     }
     
-    Map<uint32_t, Inventory> Changes{};
+    IdMap<Inventory> Changes{};
 };
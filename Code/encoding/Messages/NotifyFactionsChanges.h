@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Message.h"
+#include <IdMap.h>
 #include <Structs/Factions.h>
 
 using TiltedPhoques::Map;
@@ -22,5 +23,5 @@ struct NotifyFactionsChanges final : ServerMessage
             GetOpcode() == acRhs.GetOpcode();
     }
     
-    Map<uint32_t, Factions> Changes{};
+    IdMap<Factions> Changes{};
 };
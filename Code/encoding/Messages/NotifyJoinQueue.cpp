@@ -0,0 +1,13 @@
+#include <Messages/NotifyJoinQueue.h>
+
+void NotifyJoinQueue::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Serialization::WriteVarInt(aWriter, Position);
+}
+
+void NotifyJoinQueue::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ServerMessage::DeserializeRaw(aReader);
+
+    Position = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Message.h"
+
+struct NotifyJoinQueue final : ServerMessage
+{
+    static constexpr ServerOpcode Opcode = kNotifyJoinQueue;
+
+    NotifyJoinQueue() : ServerMessage(Opcode)
+    {
+    }
+
+    virtual ~NotifyJoinQueue() = default;
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const NotifyJoinQueue& achRhs) const noexcept
+    {
+        return Position == achRhs.Position &&
+            GetOpcode() == achRhs.GetOpcode();
+    }
+
+    uint32_t Position{};
+};
@@ -0,0 +1,13 @@
+#include <Messages/NotifyMessageChunk.h>
+
+void NotifyMessageChunk::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Chunk.Serialize(aWriter);
+}
+
+void NotifyMessageChunk::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ServerMessage::DeserializeRaw(aReader);
+
+    Chunk.Deserialize(aReader);
+}
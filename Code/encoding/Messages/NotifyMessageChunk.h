@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Message.h"
+#include <Structs/MessageChunk.h>
+
+// Part of a message too large for a single packet, the client reassembles it before handling it
+struct NotifyMessageChunk final : ServerMessage
+{
+    static constexpr ServerOpcode Opcode = kNotifyMessageChunk;
+
+    NotifyMessageChunk() : ServerMessage(Opcode)
+    {
+    }
+
+    virtual ~NotifyMessageChunk() = default;
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const NotifyMessageChunk& achRhs) const noexcept
+    {
+        return Chunk == achRhs.Chunk &&
+            GetOpcode() == achRhs.GetOpcode();
+    }
+
+    MessageChunk Chunk{};
+};
@@ -3,6 +3,7 @@
 
 void NotifyPlayerList::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
 {
+    Serialization::WriteVarInt(aWriter, Version);
     Serialization::WriteVarInt(aWriter, Players.size());
 
     for (auto& player : Players)
@@ -16,6 +17,8 @@ void NotifyPlayerList::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) no
 {
     ServerMessage::DeserializeRaw(aReader);
 
+    Version = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+
     auto count = Serialization::ReadVarInt(aReader) & 0xFFFF;
 
     for (auto i = 0u; i < count; ++i)
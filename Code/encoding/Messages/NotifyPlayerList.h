@@ -8,6 +8,9 @@ using TiltedPhoques::Map;
 struct NotifyPlayerList final : ServerMessage
 {
     static constexpr ServerOpcode Opcode = kNotifyPlayerList;
+    static constexpr EDelivery Delivery = EDelivery::kReliable;
+    // Same lane as the deltas, holding the list back while deltas go out would make the client ask for it again
+    static constexpr ELane Lane = ELane::kState;
 
     NotifyPlayerList() : 
         ServerMessage(Opcode)
@@ -21,9 +24,11 @@ struct NotifyPlayerList final : ServerMessage
 
     bool operator==(const NotifyPlayerList& acRhs) const noexcept
     {
-        return Players == acRhs.Players &&
+        return Version == acRhs.Version &&
+            Players == acRhs.Players &&
             GetOpcode() == acRhs.GetOpcode();
     }
 
+    uint32_t Version{0};
     Map<uint32_t, String> Players{};
 };
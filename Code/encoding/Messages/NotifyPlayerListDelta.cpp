@@ -0,0 +1,44 @@
+#include <Messages/NotifyPlayerListDelta.h>
+#include <TiltedCore/Serialization.hpp>
+
+void NotifyPlayerListDelta::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Serialization::WriteVarInt(aWriter, Version);
+    Serialization::WriteVarInt(aWriter, UpdatedPlayers.size());
+
+    for (auto& player : UpdatedPlayers)
+    {
+        Serialization::WriteVarInt(aWriter, player.first);
+        Serialization::WriteString(aWriter, player.second);
+    }
+
+    Serialization::WriteVarInt(aWriter, RemovedPlayers.size());
+
+    for (auto id : RemovedPlayers)
+    {
+        Serialization::WriteVarInt(aWriter, id);
+    }
+}
+
+void NotifyPlayerListDelta::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ServerMessage::DeserializeRaw(aReader);
+
+    Version = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+
+    auto count = Serialization::ReadVarInt(aReader) & 0xFFFF;
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        uint32_t id = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+        UpdatedPlayers[id] = Serialization::ReadString(aReader);
+    }
+
+    count = Serialization::ReadVarInt(aReader) & 0xFFFF;
+    RemovedPlayers.resize(count);
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        RemovedPlayers[i] = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Message.h"
+
+using TiltedPhoques::String;
+using TiltedPhoques::Map;
+using TiltedPhoques::Vector;
+
+// Changes to the player list since Version - 1, clients that are not at Version - 1 request the full list
+struct NotifyPlayerListDelta final : ServerMessage
+{
+    static constexpr ServerOpcode Opcode = kNotifyPlayerListDelta;
+
+    NotifyPlayerListDelta() : 
+        ServerMessage(Opcode)
+    {
+    }
+
+    virtual ~NotifyPlayerListDelta() = default;
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const NotifyPlayerListDelta& acRhs) const noexcept
+    {
+        return Version == acRhs.Version &&
+            UpdatedPlayers == acRhs.UpdatedPlayers &&
+            RemovedPlayers == acRhs.RemovedPlayers &&
+            GetOpcode() == acRhs.GetOpcode();
+    }
+
+    uint32_t Version{0};
+    // Players that were added or renamed
+    Map<uint32_t, String> UpdatedPlayers{};
+    Vector<uint32_t> RemovedPlayers{};
+};
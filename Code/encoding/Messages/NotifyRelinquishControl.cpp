@@ -0,0 +1,13 @@
+#include <Messages/NotifyRelinquishControl.h>
+
+void NotifyRelinquishControl::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Serialization::WriteVarInt(aWriter, ServerId);
+}
+
+void NotifyRelinquishControl::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ServerMessage::DeserializeRaw(aReader);
+
+    ServerId = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Message.h"
+
+// Sent to the previous owner when the server moves an entity to another player on its own
+struct NotifyRelinquishControl final : ServerMessage
+{
+    static constexpr ServerOpcode Opcode = kNotifyRelinquishControl;
+
+    NotifyRelinquishControl() : ServerMessage(Opcode)
+    {
+    }
+
+    virtual ~NotifyRelinquishControl() = default;
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const NotifyRelinquishControl& achRhs) const noexcept
+    {
+        return ServerId == achRhs.ServerId &&
+            GetOpcode() == achRhs.GetOpcode();
+    }
+
+    uint32_t ServerId;
+};
@@ -7,6 +7,8 @@
 struct NotifySpawnData final : ServerMessage
 {
     static constexpr ServerOpcode Opcode = kNotifySpawnData;
+    static constexpr EDelivery Delivery = EDelivery::kReliable;
+    static constexpr ELane Lane = ELane::kBulk;
 
     NotifySpawnData() : ServerMessage(Opcode)
     {
@@ -5,11 +5,7 @@ void RequestCharacterInventoryChanges::SerializeRaw(TiltedPhoques::Buffer::Write
 {
     Serialization::WriteVarInt(aWriter, Changes.size());
 
-    for (auto& change : Changes)
-    {
-        Serialization::WriteVarInt(aWriter, change.first);
-        change.second.Serialize(aWriter);
-    }
+    Changes.Serialize(aWriter, [](const Inventory& acChange, TiltedPhoques::Buffer::Writer& aWriter) { acChange.Serialize(aWriter); });
 }
 
 void RequestCharacterInventoryChanges::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
@@ -18,9 +14,5 @@ void RequestCharacterInventoryChanges::DeserializeRaw(TiltedPhoques::Buffer::Rea
 
     auto count = Serialization::ReadVarInt(aReader) & 0xFF;
 
-    for (auto i = 0u; i < count; ++i)
-    {
-        auto& change = Changes[Serialization::ReadVarInt(aReader) & 0xFFFFFFFF];
-        change.Deserialize(aReader);
-    }
+    Changes.Deserialize(aReader, count, [](Inventory& aChange, TiltedPhoques::Buffer::Reader& aReader) { aChange.Deserialize(aReader); });
 }
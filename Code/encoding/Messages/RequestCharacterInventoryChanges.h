@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Message.h"
+#include <IdMap.h>
 #include <Structs/Inventory.h>
 
 using TiltedPhoques::Map;
@@ -24,5 +25,5 @@ struct RequestCharacterInventoryChanges final : ClientMessage
             GetOpcode() == acRhs.GetOpcode();
     }
     
-    Map<uint32_t, Inventory> Changes;
+    IdMap<Inventory> Changes;
 };
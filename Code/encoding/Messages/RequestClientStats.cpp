@@ -0,0 +1,13 @@
+#include <Messages/RequestClientStats.h>
+
+void RequestClientStats::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Serialization::WriteVarInt(aWriter, FrameTime);
+}
+
+void RequestClientStats::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ClientMessage::DeserializeRaw(aReader);
+
+    FrameTime = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Message.h"
+
+// Periodic report of how busy the client is, used by the server to spread NPC ownership
+struct RequestClientStats final : ClientMessage
+{
+    static constexpr ClientOpcode Opcode = kRequestClientStats;
+
+    RequestClientStats() : ClientMessage(Opcode)
+    {
+    }
+
+    virtual ~RequestClientStats() = default;
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const RequestClientStats& achRhs) const noexcept
+    {
+        return FrameTime == achRhs.FrameTime &&
+            GetOpcode() == achRhs.GetOpcode();
+    }
+
+    // Average frame time in microseconds since the last report
+    uint32_t FrameTime{0};
+};
@@ -8,11 +8,7 @@ void RequestFactionsChanges::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter
 
     aWriter.WriteBits(Changes.size() & 0xFF, 8);
 
-    for (auto& change : Changes)
-    {
-        Serialization::WriteVarInt(aWriter, change.first);
-        change.second.Serialize(aWriter);
-    }
+    Changes.Serialize(aWriter, [](const Factions& acChange, TiltedPhoques::Buffer::Writer& aWriter) { acChange.Serialize(aWriter); });
 }
 
 void RequestFactionsChanges::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
@@ -22,9 +18,5 @@ void RequestFactionsChanges::DeserializeRaw(TiltedPhoques::Buffer::Reader& aRead
     uint64_t count = 0;
     aReader.ReadBits(count, 8);
 
-    for (auto i = 0u; i < count; ++i)
-    {
-        auto& change = Changes[Serialization::ReadVarInt(aReader) & 0xFFFFFFFF];
-        change.Deserialize(aReader);
-    }
+    Changes.Deserialize(aReader, count, [](Factions& aChange, TiltedPhoques::Buffer::Reader& aReader) { aChange.Deserialize(aReader); });
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Message.h"
+#include <IdMap.h>
 #include <Structs/Factions.h>
 
 using TiltedPhoques::Map;
@@ -24,5 +25,5 @@ struct RequestFactionsChanges final : ClientMessage
             GetOpcode() == acRhs.GetOpcode();
     }
     
-    Map<uint32_t, Factions> Changes;
+    IdMap<Factions> Changes;
 };
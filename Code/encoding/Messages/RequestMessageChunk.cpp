@@ -0,0 +1,13 @@
+#include <Messages/RequestMessageChunk.h>
+
+void RequestMessageChunk::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Chunk.Serialize(aWriter);
+}
+
+void RequestMessageChunk::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ClientMessage::DeserializeRaw(aReader);
+
+    Chunk.Deserialize(aReader);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Message.h"
+#include <Structs/MessageChunk.h>
+
+// Part of a message too large for a single packet, the server reassembles it before handling it
+struct RequestMessageChunk final : ClientMessage
+{
+    static constexpr ClientOpcode Opcode = kRequestMessageChunk;
+
+    RequestMessageChunk() : ClientMessage(Opcode)
+    {
+    }
+
+    virtual ~RequestMessageChunk() = default;
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const RequestMessageChunk& achRhs) const noexcept
+    {
+        return Chunk == achRhs.Chunk &&
+            GetOpcode() == achRhs.GetOpcode();
+    }
+
+    MessageChunk Chunk{};
+};
@@ -0,0 +1,13 @@
+#include <Messages/RequestPlayerList.h>
+
+void RequestPlayerList::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Serialization::WriteVarInt(aWriter, Version);
+}
+
+void RequestPlayerList::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ClientMessage::DeserializeRaw(aReader);
+
+    Version = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+}
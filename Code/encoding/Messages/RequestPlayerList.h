@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Message.h"
+
+// Sent when the client missed a player list delta and needs the full list again
+struct RequestPlayerList final : ClientMessage
+{
+    static constexpr ClientOpcode Opcode = kRequestPlayerList;
+
+    RequestPlayerList() : ClientMessage(Opcode)
+    {
+    }
+
+    virtual ~RequestPlayerList() = default;
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const RequestPlayerList& achRhs) const noexcept
+    {
+        return Version == achRhs.Version &&
+            GetOpcode() == achRhs.GetOpcode();
+    }
+
+    uint32_t Version{0};
+};
@@ -0,0 +1,13 @@
+#include <Messages/ServerMessageBatch.h>
+
+void ServerMessageBatch::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Messages.Serialize(aWriter);
+}
+
+void ServerMessageBatch::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ServerMessage::DeserializeRaw(aReader);
+
+    Messages.Deserialize(aReader);
+}
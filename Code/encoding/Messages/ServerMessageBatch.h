@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Message.h"
+#include <Structs/PackedMessages.h>
+
+// Several messages sent in the same frame, packed into one packet
+struct ServerMessageBatch final : ServerMessage
+{
+    static constexpr ServerOpcode Opcode = kServerMessageBatch;
+
+    ServerMessageBatch() : ServerMessage(Opcode)
+    {
+    }
+
+    virtual ~ServerMessageBatch() = default;
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const ServerMessageBatch& achRhs) const noexcept
+    {
+        return Messages == achRhs.Messages &&
+            GetOpcode() == achRhs.GetOpcode();
+    }
+
+    PackedMessages Messages{};
+};
@@ -6,6 +6,7 @@
 
 static std::function<UniquePtr<ServerMessage>(TiltedPhoques::Buffer::Reader& aReader)>
     s_serverMessageExtractor[kServerOpcodeMax];
+static MessageTraits s_serverMessageTraits[kServerOpcodeMax];
 
 namespace details
 {
@@ -22,6 +23,8 @@ static struct ServerMessageFactoryInit
                 return TiltedPhoques::CastUnique<ServerMessage>(std::move(ptr));
             };
 
+            s_serverMessageTraits[T::Opcode] = MessageTraits{T::Delivery, T::Lane};
+
             return false;
         };
 
@@ -41,3 +44,11 @@ UniquePtr<ServerMessage> ServerMessageFactory::Extract(TiltedPhoques::Buffer::Re
     const auto opcode = static_cast<ServerOpcode>(data);
     return s_serverMessageExtractor[opcode](aReader);
 }
+
+MessageTraits ServerMessageFactory::GetTraits(ServerOpcode aOpcode) noexcept
+{
+    if (aOpcode >= kServerOpcodeMax) [[unlikely]]
+        return {};
+
+    return s_serverMessageTraits[aOpcode];
+}
@@ -27,12 +27,19 @@
 #include <Messages/NotifyDeathStateChange.h>
 #include <Messages/NotifyOwnershipTransfer.h>
 #include <Messages/NotifyObjectInventoryChanges.h>
+#include <Messages/NotifyJoinQueue.h>
+#include <Messages/NotifyPlayerListDelta.h>
+#include <Messages/NotifyRelinquishControl.h>
+#include <Messages/NotifyMessageChunk.h>
+#include <Messages/ServerMessageBatch.h>
 
 using TiltedPhoques::UniquePtr;
 
 struct ServerMessageFactory
 {
     UniquePtr<ServerMessage> Extract(TiltedPhoques::Buffer::Reader& aReader) const noexcept;
+    // Delivery class and lane the message type declares
+    [[nodiscard]] static MessageTraits GetTraits(ServerOpcode aOpcode) noexcept;
 
     template <class T> static auto Visit(T&& func)
     {
@@ -43,7 +50,8 @@ struct ServerMessageFactory
                                  NotifyPartyInfo, NotifyPartyInvite, NotifyActorValueChanges,
                                  NotifyActorMaxValueChanges, NotifyHealthChangeBroadcast, NotifySpawnData, NotifyActivate,
                                  NotifyLockChange, AssignObjectsResponse, NotifyDeathStateChange, NotifyOwnershipTransfer,
-                                 NotifyObjectInventoryChanges>;
+                                 NotifyObjectInventoryChanges, NotifyJoinQueue, NotifyPlayerListDelta, NotifyRelinquishControl,
+                                 NotifyMessageChunk, ServerMessageBatch>;
 
         return s_visitor(std::forward<T>(func));
     }
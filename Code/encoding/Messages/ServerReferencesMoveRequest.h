@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Message.h"
+#include <IdMap.h>
 #include <Structs/ReferenceUpdate.h>
 
 using TiltedPhoques::String;
@@ -9,6 +10,8 @@ using TiltedPhoques::Map;
 struct ServerReferencesMoveRequest final : ServerMessage
 {
     static constexpr ServerOpcode Opcode = kServerReferencesMoveRequest;
+    static constexpr EDelivery Delivery = EDelivery::kUnreliable;
+    static constexpr ELane Lane = ELane::kMovement;
 
     ServerReferencesMoveRequest() : ServerMessage(Opcode)
     {
@@ -25,5 +28,5 @@ struct ServerReferencesMoveRequest final : ServerMessage
     }
     
     uint64_t Tick{};
-    Map<uint32_t, ReferenceUpdate> Updates{};
+    IdMap<ReferenceUpdate> Updates{};
 };
@@ -6,6 +6,8 @@
 struct ServerScriptUpdate final : ServerMessage
 {
     static constexpr ServerOpcode Opcode = kServerScriptUpdate;
+    static constexpr EDelivery Delivery = EDelivery::kReliable;
+    static constexpr ELane Lane = ELane::kBulk;
 
     ServerScriptUpdate() : ServerMessage(Opcode)
     {
@@ -6,13 +6,6 @@ void ShiftGridCellRequest::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter)
     PlayerCell.Serialize(aWriter);
     CenterCoords.Serialize(aWriter);
     PlayerCoords.Serialize(aWriter);
-
-    aWriter.WriteBits(Cells.size() & 0xFF, 8);
-
-    for (const auto& cell : Cells)
-    {
-        cell.Serialize(aWriter);
-    }
 }
 
 void ShiftGridCellRequest::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
@@ -23,14 +16,4 @@ void ShiftGridCellRequest::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader
     PlayerCell.Deserialize(aReader);
     CenterCoords.Deserialize(aReader);
     PlayerCoords.Deserialize(aReader);
-
-    uint64_t count = 0;
-    aReader.ReadBits(count, 8);
-
-    Cells.resize(count);
-
-    for (auto i = 0u; i < count; ++i)
-    {
-        Cells[i].Deserialize(aReader);
-    }
 }
@@ -4,8 +4,6 @@
 #include <Structs/GameId.h>
 #include <Structs/GridCellCoords.h>
 
-using TiltedPhoques::Vector;
-
 struct ShiftGridCellRequest final : ClientMessage
 {
     static constexpr ClientOpcode Opcode = kShiftGridCellRequest;
@@ -22,7 +20,9 @@ struct ShiftGridCellRequest final : ClientMessage
     bool operator==(const ShiftGridCellRequest& acRhs) const noexcept
     {
         return WorldSpaceId == acRhs.WorldSpaceId &&
+            PlayerCell == acRhs.PlayerCell &&
             CenterCoords == acRhs.CenterCoords &&
+            PlayerCoords == acRhs.PlayerCoords &&
             GetOpcode() == acRhs.GetOpcode();
     }
     
@@ -30,5 +30,4 @@ struct ShiftGridCellRequest final : ClientMessage
     GameId PlayerCell;
     GridCellCoords CenterCoords;
     GridCellCoords PlayerCoords;
-    Vector<GameId> Cells;
 };
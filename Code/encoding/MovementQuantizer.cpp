@@ -0,0 +1,345 @@
+#include <MovementQuantizer.h>
+#include <Structs/Rotator2_NetQuantize.h>
+#include <TiltedCore/Math.hpp>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define TP_QUANTIZER_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC emits any intrinsic without being told about the instruction set
+#define TP_TARGET_AVX2
+#else
+#define TP_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define TP_QUANTIZER_SIMD 0
+#endif
+
+namespace
+{
+    // Must match Rotator2_NetQuantize
+    constexpr float kTwoPi = 2.f * float(TiltedPhoques::Pi);
+    constexpr float kScalingFactor = float(0xFFFF) / (2.0f * float(TiltedPhoques::Pi));
+
+#if TP_QUANTIZER_SIMD
+    bool HasAvx2() noexcept
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        // The OS has to save the YMM registers too, OSXSAVE and AVX
+        __cpuid(info, 1);
+        constexpr int cOsxSaveAvx = (1 << 27) | (1 << 28);
+        if ((info[2] & cOsxSaveAvx) != cOsxSaveAvx || (_xgetbv(0) & 6) != 6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    // Non finite values become 0 and the rest is clamped, like Vector3_NetQuantize::QuantizeCellRelative does
+    __m128 Sanitize(__m128 aValue) noexcept
+    {
+        const auto cFinite = _mm_cmpeq_ps(_mm_sub_ps(aValue, aValue), _mm_setzero_ps());
+        aValue = _mm_and_ps(aValue, cFinite);
+        aValue = _mm_min_ps(aValue, _mm_set1_ps(Vector3_NetQuantize::kMaxCoordinate));
+        return _mm_max_ps(aValue, _mm_set1_ps(-Vector3_NetQuantize::kMaxCoordinate));
+    }
+
+    // No floor before SSE4.1, truncate and step down the lanes that were rounded up
+    __m128i Floor(__m128 aValue) noexcept
+    {
+        const auto cTruncated = _mm_cvttps_epi32(aValue);
+        const auto cRoundedUp = _mm_cmpgt_ps(_mm_cvtepi32_ps(cTruncated), aValue);
+        return _mm_add_epi32(cTruncated, _mm_castps_si128(cRoundedUp));
+    }
+
+    __m128i QuantizeLanes(__m128 aValue, __m128 aScale, __m128i aMax) noexcept
+    {
+        auto scaled = _mm_max_ps(_mm_mul_ps(aValue, aScale), _mm_setzero_ps());
+        scaled = _mm_min_ps(scaled, _mm_cvtepi32_ps(aMax));
+
+        // Rounds to nearest even, the float max can round above the integer one
+        const auto cRounded = _mm_cvtps_epi32(scaled);
+        const auto cOver = _mm_cmpgt_epi32(cRounded, aMax);
+        return _mm_or_si128(_mm_and_si128(cOver, aMax), _mm_andnot_si128(cOver, cRounded));
+    }
+
+    // Offsets are quantized up to the size of the cell, the lanes that got there move to the origin of the next cell
+    __m128i CarryOffset(__m128i aOffset, __m128i aMaxOffset, __m128i& aCell) noexcept
+    {
+        const auto cOver = _mm_cmpgt_epi32(aOffset, aMaxOffset);
+        aCell = _mm_sub_epi32(aCell, cOver);
+        return _mm_andnot_si128(cOver, aOffset);
+    }
+
+    // Returns the lanes that couldn't be wrapped with a single addition in aMask
+    __m128i PackAngle(__m128 aAngle, __m128& aMask) noexcept
+    {
+        const auto cTwoPi = _mm_set1_ps(kTwoPi);
+        aMask = _mm_or_ps(aMask, _mm_cmpnlt_ps(aAngle, cTwoPi));
+        aMask = _mm_or_ps(aMask, _mm_cmpngt_ps(aAngle, _mm_sub_ps(_mm_setzero_ps(), cTwoPi)));
+
+        const auto cNegative = _mm_cmplt_ps(aAngle, _mm_setzero_ps());
+        const auto cWrapped = _mm_add_ps(aAngle, _mm_and_ps(cNegative, cTwoPi));
+
+        const auto cPacked = _mm_cvttps_epi32(_mm_mul_ps(cWrapped, _mm_set1_ps(kScalingFactor)));
+        return _mm_and_si128(cPacked, _mm_set1_epi32(0xFFFF));
+    }
+
+    TP_TARGET_AVX2 __m256 Sanitize(__m256 aValue) noexcept
+    {
+        const auto cFinite = _mm256_cmp_ps(_mm256_sub_ps(aValue, aValue), _mm256_setzero_ps(), _CMP_EQ_OQ);
+        aValue = _mm256_and_ps(aValue, cFinite);
+        aValue = _mm256_min_ps(aValue, _mm256_set1_ps(Vector3_NetQuantize::kMaxCoordinate));
+        return _mm256_max_ps(aValue, _mm256_set1_ps(-Vector3_NetQuantize::kMaxCoordinate));
+    }
+
+    TP_TARGET_AVX2 __m256i QuantizeLanes(__m256 aValue, __m256 aScale, __m256i aMax) noexcept
+    {
+        auto scaled = _mm256_max_ps(_mm256_mul_ps(aValue, aScale), _mm256_setzero_ps());
+        scaled = _mm256_min_ps(scaled, _mm256_cvtepi32_ps(aMax));
+
+        return _mm256_min_epi32(_mm256_cvtps_epi32(scaled), aMax);
+    }
+
+    TP_TARGET_AVX2 __m256i CarryOffset(__m256i aOffset, __m256i aMaxOffset, __m256i& aCell) noexcept
+    {
+        const auto cOver = _mm256_cmpgt_epi32(aOffset, aMaxOffset);
+        aCell = _mm256_sub_epi32(aCell, cOver);
+        return _mm256_andnot_si256(cOver, aOffset);
+    }
+
+    TP_TARGET_AVX2 __m256i PackAngle(__m256 aAngle, __m256& aMask) noexcept
+    {
+        const auto cTwoPi = _mm256_set1_ps(kTwoPi);
+        aMask = _mm256_or_ps(aMask, _mm256_cmp_ps(aAngle, cTwoPi, _CMP_NLT_UQ));
+        aMask = _mm256_or_ps(aMask, _mm256_cmp_ps(aAngle, _mm256_sub_ps(_mm256_setzero_ps(), cTwoPi), _CMP_NGT_UQ));
+
+        const auto cNegative = _mm256_cmp_ps(aAngle, _mm256_setzero_ps(), _CMP_LT_OQ);
+        const auto cWrapped = _mm256_add_ps(aAngle, _mm256_and_ps(cNegative, cTwoPi));
+
+        const auto cPacked = _mm256_cvttps_epi32(_mm256_mul_ps(cWrapped, _mm256_set1_ps(kScalingFactor)));
+        return _mm256_and_si256(cPacked, _mm256_set1_epi32(0xFFFF));
+    }
+#endif
+}
+
+MovementQuantizer::EPath MovementQuantizer::GetBestPath() noexcept
+{
+#if TP_QUANTIZER_SIMD
+    static const EPath s_path = HasAvx2() ? EPath::kAvx2 : EPath::kSse2;
+    return s_path;
+#else
+    return EPath::kScalar;
+#endif
+}
+
+void MovementQuantizer::Clear() noexcept
+{
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_rotationX.clear();
+    m_rotationY.clear();
+}
+
+size_t MovementQuantizer::Add(const glm::vec3& acPosition, float aRotationX, float aRotationY) noexcept
+{
+    m_x.push_back(acPosition.x);
+    m_y.push_back(acPosition.y);
+    m_z.push_back(acPosition.z);
+    m_rotationX.push_back(aRotationX);
+    m_rotationY.push_back(aRotationY);
+
+    return m_x.size() - 1;
+}
+
+void MovementQuantizer::Quantize(uint32_t aFractionBits) noexcept
+{
+    Quantize(GetBestPath(), aFractionBits);
+}
+
+void MovementQuantizer::Quantize(EPath aPath, uint32_t aFractionBits) noexcept
+{
+    aFractionBits = std::min(aFractionBits, Vector3_NetQuantize::kMaxFractionBits);
+
+    const auto cCount = m_x.size();
+    m_cellX.resize(cCount);
+    m_cellY.resize(cCount);
+    m_offsetX.resize(cCount);
+    m_offsetY.resize(cCount);
+    m_height.resize(cCount);
+    m_negative.resize(cCount);
+    m_rotation.resize(cCount);
+
+    switch (aPath)
+    {
+    case EPath::kAvx2: QuantizeAvx2(aFractionBits); break;
+    case EPath::kSse2: QuantizeSse2(aFractionBits); break;
+    default: QuantizeScalar(0, aFractionBits); break;
+    }
+}
+
+Vector3_NetQuantize::CellRelative MovementQuantizer::GetPosition(size_t aIndex) const noexcept
+{
+    Vector3_NetQuantize::CellRelative position;
+    position.CellX = m_cellX[aIndex];
+    position.CellY = m_cellY[aIndex];
+    position.OffsetX = m_offsetX[aIndex];
+    position.OffsetY = m_offsetY[aIndex];
+    position.Height = m_height[aIndex];
+    position.Negative = m_negative[aIndex] != 0;
+
+    return position;
+}
+
+void MovementQuantizer::QuantizeScalar(size_t aBegin, uint32_t aFractionBits) noexcept
+{
+    for (size_t i = aBegin; i < m_x.size(); ++i)
+    {
+        Vector3_NetQuantize position;
+        position = glm::vec3(m_x[i], m_y[i], m_z[i]);
+
+        const auto cPosition = position.QuantizeCellRelative(aFractionBits);
+        m_cellX[i] = cPosition.CellX;
+        m_cellY[i] = cPosition.CellY;
+        m_offsetX[i] = cPosition.OffsetX;
+        m_offsetY[i] = cPosition.OffsetY;
+        m_height[i] = cPosition.Height;
+        m_negative[i] = cPosition.Negative ? 1 : 0;
+
+        m_rotation[i] = Rotator2_NetQuantize::Pack(m_rotationX[i], m_rotationY[i]);
+    }
+}
+
+#if TP_QUANTIZER_SIMD
+
+void MovementQuantizer::QuantizeSse2(uint32_t aFractionBits) noexcept
+{
+    const auto cScale = _mm_set1_ps(static_cast<float>(1u << aFractionBits));
+    const auto cMaxOffset = _mm_set1_epi32((1 << (Vector3_NetQuantize::kCellOffsetBits + aFractionBits)) - 1);
+    const auto cCellOffset = _mm_set1_epi32(1 << (Vector3_NetQuantize::kCellOffsetBits + aFractionBits));
+    const auto cMaxHeight = _mm_set1_epi32((1 << (Vector3_NetQuantize::kHeightBits + aFractionBits)) - 1);
+    const auto cCellSize = _mm_set1_ps(Vector3_NetQuantize::kCellSize);
+    const auto cInverseCellSize = _mm_set1_ps(1.f / Vector3_NetQuantize::kCellSize);
+    const auto cSignMask = _mm_set1_ps(-0.f);
+
+    const auto cCount = m_x.size() & ~size_t(3);
+    for (size_t i = 0; i < cCount; i += 4)
+    {
+        const auto cX = Sanitize(_mm_loadu_ps(&m_x[i]));
+        const auto cY = Sanitize(_mm_loadu_ps(&m_y[i]));
+        const auto cZ = Sanitize(_mm_loadu_ps(&m_z[i]));
+
+        // Dividing by a power of two is exact, multiplying by its inverse gives the same result
+        auto cellX = Floor(_mm_mul_ps(cX, cInverseCellSize));
+        auto cellY = Floor(_mm_mul_ps(cY, cInverseCellSize));
+
+        const auto cOffsetX = _mm_sub_ps(cX, _mm_mul_ps(_mm_cvtepi32_ps(cellX), cCellSize));
+        const auto cOffsetY = _mm_sub_ps(cY, _mm_mul_ps(_mm_cvtepi32_ps(cellY), cCellSize));
+
+        const auto cQuantizedX = CarryOffset(QuantizeLanes(cOffsetX, cScale, cCellOffset), cMaxOffset, cellX);
+        const auto cQuantizedY = CarryOffset(QuantizeLanes(cOffsetY, cScale, cCellOffset), cMaxOffset, cellY);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&m_cellX[i]), cellX);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&m_cellY[i]), cellY);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&m_offsetX[i]), cQuantizedX);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&m_offsetY[i]), cQuantizedY);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&m_height[i]), QuantizeLanes(_mm_andnot_ps(cSignMask, cZ), cScale, cMaxHeight));
+
+        const auto cNegative = _mm_castps_si128(_mm_cmplt_ps(cZ, _mm_setzero_ps()));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&m_negative[i]), _mm_srli_epi32(cNegative, 31));
+
+        auto outOfRange = _mm_setzero_ps();
+        const auto cRotationX = PackAngle(_mm_loadu_ps(&m_rotationX[i]), outOfRange);
+        const auto cRotationY = PackAngle(_mm_loadu_ps(&m_rotationY[i]), outOfRange);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&m_rotation[i]), _mm_or_si128(cRotationX, _mm_slli_epi32(cRotationY, 16)));
+
+        // Angles more than a turn away from the range are rare, leave them to the exact scalar wrap
+        if (const auto cMask = _mm_movemask_ps(outOfRange))
+        {
+            for (size_t j = 0; j < 4; ++j)
+            {
+                if (cMask & (1 << j))
+                    m_rotation[i + j] = Rotator2_NetQuantize::Pack(m_rotationX[i + j], m_rotationY[i + j]);
+            }
+        }
+    }
+
+    QuantizeScalar(cCount, aFractionBits);
+}
+
+TP_TARGET_AVX2 void MovementQuantizer::QuantizeAvx2(uint32_t aFractionBits) noexcept
+{
+    const auto cScale = _mm256_set1_ps(static_cast<float>(1u << aFractionBits));
+    const auto cMaxOffset = _mm256_set1_epi32((1 << (Vector3_NetQuantize::kCellOffsetBits + aFractionBits)) - 1);
+    const auto cCellOffset = _mm256_set1_epi32(1 << (Vector3_NetQuantize::kCellOffsetBits + aFractionBits));
+    const auto cMaxHeight = _mm256_set1_epi32((1 << (Vector3_NetQuantize::kHeightBits + aFractionBits)) - 1);
+    const auto cCellSize = _mm256_set1_ps(Vector3_NetQuantize::kCellSize);
+    const auto cInverseCellSize = _mm256_set1_ps(1.f / Vector3_NetQuantize::kCellSize);
+    const auto cSignMask = _mm256_set1_ps(-0.f);
+
+    const auto cCount = m_x.size() & ~size_t(7);
+    for (size_t i = 0; i < cCount; i += 8)
+    {
+        const auto cX = Sanitize(_mm256_loadu_ps(&m_x[i]));
+        const auto cY = Sanitize(_mm256_loadu_ps(&m_y[i]));
+        const auto cZ = Sanitize(_mm256_loadu_ps(&m_z[i]));
+
+        auto cellX = _mm256_cvttps_epi32(_mm256_floor_ps(_mm256_mul_ps(cX, cInverseCellSize)));
+        auto cellY = _mm256_cvttps_epi32(_mm256_floor_ps(_mm256_mul_ps(cY, cInverseCellSize)));
+
+        const auto cOffsetX = _mm256_sub_ps(cX, _mm256_mul_ps(_mm256_cvtepi32_ps(cellX), cCellSize));
+        const auto cOffsetY = _mm256_sub_ps(cY, _mm256_mul_ps(_mm256_cvtepi32_ps(cellY), cCellSize));
+
+        const auto cQuantizedX = CarryOffset(QuantizeLanes(cOffsetX, cScale, cCellOffset), cMaxOffset, cellX);
+        const auto cQuantizedY = CarryOffset(QuantizeLanes(cOffsetY, cScale, cCellOffset), cMaxOffset, cellY);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&m_cellX[i]), cellX);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&m_cellY[i]), cellY);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&m_offsetX[i]), cQuantizedX);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&m_offsetY[i]), cQuantizedY);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&m_height[i]), QuantizeLanes(_mm256_andnot_ps(cSignMask, cZ), cScale, cMaxHeight));
+
+        const auto cNegative = _mm256_castps_si256(_mm256_cmp_ps(cZ, _mm256_setzero_ps(), _CMP_LT_OQ));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&m_negative[i]), _mm256_srli_epi32(cNegative, 31));
+
+        auto outOfRange = _mm256_setzero_ps();
+        const auto cRotationX = PackAngle(_mm256_loadu_ps(&m_rotationX[i]), outOfRange);
+        const auto cRotationY = PackAngle(_mm256_loadu_ps(&m_rotationY[i]), outOfRange);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&m_rotation[i]), _mm256_or_si256(cRotationX, _mm256_slli_epi32(cRotationY, 16)));
+
+        if (const auto cMask = _mm256_movemask_ps(outOfRange))
+        {
+            for (size_t j = 0; j < 8; ++j)
+            {
+                if (cMask & (1 << j))
+                    m_rotation[i + j] = Rotator2_NetQuantize::Pack(m_rotationX[i + j], m_rotationY[i + j]);
+            }
+        }
+    }
+
+    QuantizeScalar(cCount, aFractionBits);
+}
+
+#else
+
+void MovementQuantizer::QuantizeSse2(uint32_t aFractionBits) noexcept
+{
+    QuantizeScalar(0, aFractionBits);
+}
+
+void MovementQuantizer::QuantizeAvx2(uint32_t aFractionBits) noexcept
+{
+    QuantizeScalar(0, aFractionBits);
+}
+
+#endif
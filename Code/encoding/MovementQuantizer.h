@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Structs/Vector3_NetQuantize.h>
+#include <TiltedCore/Stl.hpp>
+
+// Quantizes the positions and rotations of many entities in one pass, so a snapshot sent to every player only
+// quantizes each entity once instead of once per recipient. Entities are stored as a structure of arrays and processed
+// eight or four at a time with AVX2 or SSE2 when the CPU has them. Results are bit for bit what
+// Vector3_NetQuantize::QuantizeCellRelative and Rotator2_NetQuantize::Pack return.
+struct MovementQuantizer
+{
+    enum class EPath
+    {
+        kScalar,
+        kSse2,
+        kAvx2
+    };
+
+    // Fastest path the CPU running this supports
+    [[nodiscard]] static EPath GetBestPath() noexcept;
+
+    void Clear() noexcept;
+    // Returns the index of the entity, aRotationX and aRotationY are the two angles of a Rotator2_NetQuantize
+    size_t Add(const glm::vec3& acPosition, float aRotationX, float aRotationY) noexcept;
+
+    void Quantize(uint32_t aFractionBits = Vector3_NetQuantize::kDefaultFractionBits) noexcept;
+    // Forces a path, the requested path must be supported by the CPU
+    void Quantize(EPath aPath, uint32_t aFractionBits = Vector3_NetQuantize::kDefaultFractionBits) noexcept;
+
+    [[nodiscard]] size_t Size() const noexcept { return m_x.size(); }
+    // Only valid after Quantize
+    [[nodiscard]] Vector3_NetQuantize::CellRelative GetPosition(size_t aIndex) const noexcept;
+    [[nodiscard]] uint32_t GetRotation(size_t aIndex) const noexcept { return m_rotation[aIndex]; }
+
+private:
+
+    void QuantizeScalar(size_t aBegin, uint32_t aFractionBits) noexcept;
+    void QuantizeSse2(uint32_t aFractionBits) noexcept;
+    void QuantizeAvx2(uint32_t aFractionBits) noexcept;
+
+    // Input
+    Vector<float> m_x;
+    Vector<float> m_y;
+    Vector<float> m_z;
+    Vector<float> m_rotationX;
+    Vector<float> m_rotationY;
+
+    // Output
+    Vector<int32_t> m_cellX;
+    Vector<int32_t> m_cellY;
+    Vector<uint32_t> m_offsetX;
+    Vector<uint32_t> m_offsetY;
+    Vector<uint32_t> m_height;
+    Vector<uint32_t> m_negative;
+    Vector<uint32_t> m_rotation;
+};
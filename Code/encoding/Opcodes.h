@@ -29,6 +29,10 @@ enum ClientOpcode : unsigned char
     kRequestObjectInventoryChanges,
     kRequestCharacterInventoryChanges,
     kRequestFireProjectile,
+    kRequestPlayerList,
+    kRequestClientStats,
+    kRequestMessageChunk,
+    kClientMessageBatch,
     kClientOpcodeMax
 };
 
@@ -59,5 +63,10 @@ enum ServerOpcode : unsigned char
     kNotifyObjectInventoryChanges,
     kNotifyCharacterInventoryChanges,
     kNotifyFireProjectile,
+    kNotifyJoinQueue,
+    kNotifyPlayerListDelta,
+    kNotifyRelinquishControl,
+    kNotifyMessageChunk,
+    kServerMessageBatch,
     kServerOpcodeMax
 };
@@ -141,7 +141,7 @@ void ActionEvent::GenerateDifferential(const ActionEvent& aPrevious, TiltedPhoqu
     }
 }
 
-void ActionEvent::ApplyDifferential(TiltedPhoques::Buffer::Reader& aReader) noexcept
+bool ActionEvent::ApplyDifferential(TiltedPhoques::Buffer::Reader& aReader) noexcept
 {
     uint64_t flags = 0;
 
@@ -199,8 +199,10 @@ void ActionEvent::ApplyDifferential(TiltedPhoques::Buffer::Reader& aReader) noex
 
     if (flags & kVariables)
     {
-        Variables.ApplyDiff(aReader);
+        return Variables.ApplyDiff(aReader);
     }
+
+    return true;
 }
 
 void ActionEvent::Save(std::ostream& aOutput) const
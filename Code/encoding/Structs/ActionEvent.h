@@ -35,5 +35,6 @@ struct ActionEvent
     void Save(std::ostream&) const;
 
     void GenerateDifferential(const ActionEvent& aPrevious, TiltedPhoques::Buffer::Writer& aWriter) const noexcept;
-    void ApplyDifferential(TiltedPhoques::Buffer::Reader& aReader) noexcept;
+    // Returns false if the variables couldn't be read, what follows in the reader can't be trusted
+    bool ApplyDifferential(TiltedPhoques::Buffer::Reader& aReader) noexcept;
 };
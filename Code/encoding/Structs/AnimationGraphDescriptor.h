@@ -1,10 +1,20 @@
 #pragma once
 
 #include <TiltedCore/Stl.hpp>
+#include <cmath>
 #include <cstdint>
+#include <functional>
 
 struct AnimationGraphDescriptor
 {
+    // How a synced float is quantized on the wire, values outside of [Min, Max] and a Precision of 0 are sent as is
+    struct FloatQuantization
+    {
+        float Min{0.f};
+        float Max{0.f};
+        float Precision{0.f};
+    };
+
     AnimationGraphDescriptor() = default;
 
     template <std::size_t N, std::size_t O, std::size_t P>
@@ -17,26 +27,56 @@ struct AnimationGraphDescriptor
         BooleanLookUpTable.assign(acBooleanList, acBooleanList + N);
         FloatLookupTable.assign(acFloatList, acFloatList + O);
         IntegerLookupTable.assign(acIntegerList, acIntegerList + P);
+
+        for (const auto& cTable : {std::cref(BooleanLookUpTable), std::cref(FloatLookupTable), std::cref(IntegerLookupTable)})
+        {
+            for (const auto cIdx : cTable.get())
+            {
+                if ((cIdx >> 6) >= SyncedMask.size())
+                    SyncedMask.resize((cIdx >> 6) + 1, 0);
+
+                SyncedMask[cIdx >> 6] |= 1ull << (cIdx & 63);
+            }
+        }
     }
 
-    bool IsSynced(uint32_t aIdx) const
+    // Same as above with a quantization for each float
+    template <std::size_t N, std::size_t O, std::size_t P>
+    AnimationGraphDescriptor(const uint32_t (&acBooleanList)[N], const uint32_t (&acFloatList)[O],
+                             const FloatQuantization (&acFloatQuantizations)[O], const uint32_t (&acIntegerList)[P])
+        : AnimationGraphDescriptor(acBooleanList, acFloatList, acIntegerList)
     {
-        auto itor = std::find(std::begin(BooleanLookUpTable), std::end(BooleanLookUpTable), aIdx);
-        if (itor != std::end(BooleanLookUpTable))
-            return true;
+        for (const auto& cQuantization : acFloatQuantizations)
+        {
+            FloatQuantizations.push_back(cQuantization);
 
-        itor = std::find(std::begin(FloatLookupTable), std::end(FloatLookupTable), aIdx);
-        if (itor != std::end(FloatLookupTable))
-            return true;
+            uint32_t bits = 0;
+            if (cQuantization.Precision > 0.f && cQuantization.Max > cQuantization.Min)
+            {
+                const auto cSteps = static_cast<uint64_t>(std::ceil((cQuantization.Max - cQuantization.Min) / cQuantization.Precision));
+                while (bits < 32 && (cSteps >> bits) != 0)
+                    ++bits;
+            }
 
-        itor = std::find(std::begin(IntegerLookupTable), std::end(IntegerLookupTable), aIdx);
-        if (itor != std::end(IntegerLookupTable))
-            return true;
+            FloatBits.push_back(static_cast<uint8_t>(bits));
+        }
+    }
 
-        return false;
+    bool IsSynced(uint32_t aIdx) const
+    {
+        const auto cWord = aIdx >> 6;
+        return cWord < SyncedMask.size() && ((SyncedMask[cWord] >> (aIdx & 63)) & 1) != 0;
     }
 
     TiltedPhoques::Vector<uint32_t> BooleanLookUpTable;
     TiltedPhoques::Vector<uint32_t> FloatLookupTable;
     TiltedPhoques::Vector<uint32_t> IntegerLookupTable;
+    // Empty when the floats are all sent as is, otherwise one per entry of FloatLookupTable
+    TiltedPhoques::Vector<FloatQuantization> FloatQuantizations;
+    // Bits used by each quantized float, 0 when it is sent as is
+    TiltedPhoques::Vector<uint8_t> FloatBits;
+    // One bit per variable index of the graph, set for the synced ones
+    TiltedPhoques::Vector<uint64_t> SyncedMask;
+    // Stands for the key on the wire, 0 until registered
+    uint32_t Id{0};
 };
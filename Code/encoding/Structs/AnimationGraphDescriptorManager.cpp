@@ -1,5 +1,5 @@
 #include <Structs/AnimationGraphDescriptorManager.h>
-#include <iostream>
+#include <algorithm>
 
 AnimationGraphDescriptorManager& AnimationGraphDescriptorManager::Get() noexcept
 {
@@ -9,11 +9,22 @@ AnimationGraphDescriptorManager& AnimationGraphDescriptorManager::Get() noexcept
 
 const AnimationGraphDescriptor* AnimationGraphDescriptorManager::GetDescriptor(uint64_t aKey) const noexcept
 {
-    const auto it = m_descriptors.find(aKey);
-    if (it != std::end(m_descriptors))
-        return &it->second;
+    if (m_slots.empty())
+        return nullptr;
 
-    return nullptr;
+    const auto cId = m_slots[(aKey * m_seed) >> m_shift];
+    if (cId == 0 || m_keys[cId - 1] != aKey)
+        return nullptr;
+
+    return &m_descriptors[cId - 1];
+}
+
+uint64_t AnimationGraphDescriptorManager::GetKey(uint32_t aId) const noexcept
+{
+    if (aId == 0 || aId > m_keys.size())
+        return 0;
+
+    return m_keys[aId - 1];
 }
 
 AnimationGraphDescriptorManager::Builder::Builder(AnimationGraphDescriptorManager& aManager, uint64_t aKey,
@@ -24,9 +35,53 @@ AnimationGraphDescriptorManager::Builder::Builder(AnimationGraphDescriptorManage
 
 void AnimationGraphDescriptorManager::Register(uint64_t aKey, AnimationGraphDescriptor aAnimationGraphDescriptor) noexcept
 {
-    if (m_descriptors.count(aKey))
+    if (GetDescriptor(aKey))
         return;
 
-    m_descriptors[aKey] = std::move(aAnimationGraphDescriptor);
+    m_keys.push_back(aKey);
+    aAnimationGraphDescriptor.Id = static_cast<uint32_t>(m_keys.size());
+
+    m_descriptors.push_back(std::move(aAnimationGraphDescriptor));
+
+    BuildLookup();
 }
 
+void AnimationGraphDescriptorManager::BuildLookup() noexcept
+{
+    // Four slots per key make a random seed collision free often enough that only a few are tried, give up on a size
+    // after a while and try a larger one. Seeds are deterministic so every run ends up with the same table.
+    uint32_t bits = 2;
+    while ((1ull << bits) < m_keys.size() * 4)
+        ++bits;
+
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+
+    for (;; ++bits)
+    {
+        m_slots.assign(1ull << bits, 0);
+        m_shift = 64 - bits;
+
+        for (uint32_t attempt = 0; attempt < 64; ++attempt)
+        {
+            // splitmix64, odd so no key bits are lost
+            state += 0x9E3779B97F4A7C15ull;
+            auto seed = state;
+            seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ull;
+            seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBull;
+            m_seed = (seed ^ (seed >> 31)) | 1;
+
+            std::fill(std::begin(m_slots), std::end(m_slots), 0);
+
+            bool collision = false;
+            for (uint32_t i = 0; i < m_keys.size() && !collision; ++i)
+            {
+                auto& slot = m_slots[(m_keys[i] * m_seed) >> m_shift];
+                collision = slot != 0;
+                slot = i + 1;
+            }
+
+            if (!collision)
+                return;
+        }
+    }
+}
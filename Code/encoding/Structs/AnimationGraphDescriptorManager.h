@@ -2,14 +2,14 @@
 
 #include <Structs/AnimationGraphDescriptor.h>
 
-using TiltedPhoques::Map;
-
 struct AnimationGraphDescriptorManager
 {
     TP_NOCOPYMOVE(AnimationGraphDescriptorManager);
 
     static AnimationGraphDescriptorManager& Get() noexcept;
     const AnimationGraphDescriptor* GetDescriptor(uint64_t aKey) const noexcept;
+    // Ids follow the registration order, which is the same for everyone running the same build, 0 if unknown
+    [[nodiscard]] uint64_t GetKey(uint32_t aId) const noexcept;
 
     struct Builder
     {
@@ -25,5 +25,14 @@ private:
 
     AnimationGraphDescriptorManager() noexcept;
 
-    Map<uint64_t, AnimationGraphDescriptor> m_descriptors;
+    void BuildLookup() noexcept;
+
+    // In registration order, the id of a descriptor is its index + 1
+    TiltedPhoques::Vector<AnimationGraphDescriptor> m_descriptors;
+    TiltedPhoques::Vector<uint64_t> m_keys;
+    // Perfect hash of the keys, rebuilt on registration: the slot of a key is (key * m_seed) >> m_shift and holds the
+    // id of the only descriptor that can have that key, or 0
+    TiltedPhoques::Vector<uint32_t> m_slots;
+    uint64_t m_seed{0};
+    uint32_t m_shift{63};
 };
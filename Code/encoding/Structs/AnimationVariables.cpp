@@ -1,12 +1,147 @@
 #include <Structs/AnimationVariables.h>
+#include <Structs/AnimationGraphDescriptorManager.h>
 #include <TiltedCore/Serialization.hpp>
+#include <bitset>
 #include <iostream>
 
+using TiltedPhoques::Serialization;
+
+namespace
+{
+    uint32_t BitWidth(uint64_t aValue) noexcept
+    {
+        uint32_t bits = 0;
+        for (; aValue != 0; aValue >>= 1)
+            ++bits;
+
+        return bits;
+    }
+
+    uint64_t BooleanMask(uint32_t aCount) noexcept
+    {
+        return aCount >= 64 ? ~0ull : (1ull << aCount) - 1;
+    }
+
+    // The descriptor the variables are sent with, only if they were read with it
+    const AnimationGraphDescriptor* GetWireDescriptor(const AnimationVariables& acVariables) noexcept
+    {
+        if (acVariables.DescriptorKey == 0)
+            return nullptr;
+
+        const auto* pDescriptor = AnimationGraphDescriptorManager::Get().GetDescriptor(acVariables.DescriptorKey);
+        if (!pDescriptor || pDescriptor->Id == 0 ||
+            pDescriptor->IntegerLookupTable.size() != acVariables.Integers.size() ||
+            pDescriptor->FloatLookupTable.size() != acVariables.Floats.size())
+            return nullptr;
+
+        return pDescriptor;
+    }
+
+    // Flipped booleans go as a list of indices when there are only a few of them, as the whole mask otherwise
+    void WriteBooleanChanges(uint64_t aChanges, uint32_t aCount, TiltedPhoques::Buffer::Writer& aWriter)
+    {
+        const auto cIndexBits = BitWidth(aCount - 1);
+        const auto cFlips = static_cast<uint32_t>(std::bitset<64>(aChanges).count());
+        const bool cSparse = cIndexBits > 0 && (cFlips + 1) * cIndexBits < aCount;
+
+        aWriter.WriteBits(cSparse ? 1 : 0, 1);
+
+        if (!cSparse)
+        {
+            aWriter.WriteBits(aChanges, aCount);
+            return;
+        }
+
+        aWriter.WriteBits(cFlips - 1, cIndexBits);
+
+        for (uint32_t i = 0; i < aCount; ++i)
+        {
+            if (aChanges & (1ull << i))
+                aWriter.WriteBits(i, cIndexBits);
+        }
+    }
+
+    uint64_t ReadBooleanChanges(uint32_t aCount, TiltedPhoques::Buffer::Reader& aReader)
+    {
+        uint64_t sparse = 0;
+        aReader.ReadBits(sparse, 1);
+
+        uint64_t changes = 0;
+        if (!sparse)
+        {
+            aReader.ReadBits(changes, aCount);
+            return changes & BooleanMask(aCount);
+        }
+
+        const auto cIndexBits = BitWidth(aCount - 1);
+
+        uint64_t flips = 0;
+        aReader.ReadBits(flips, cIndexBits);
+
+        for (uint64_t i = 0; i <= flips; ++i)
+        {
+            uint64_t index = 0;
+            aReader.ReadBits(index, cIndexBits);
+            changes |= 1ull << (index & 63);
+        }
+
+        return changes & BooleanMask(aCount);
+    }
+
+    void WriteFloat(float aValue, const AnimationGraphDescriptor* apDescriptor, size_t aIndex, TiltedPhoques::Buffer::Writer& aWriter)
+    {
+        const uint32_t cBits = apDescriptor && aIndex < apDescriptor->FloatBits.size() ? apDescriptor->FloatBits[aIndex] : 0;
+        if (cBits)
+        {
+            // Values outside of the declared range are rare but legal, they escape to the full float
+            const auto& cQuantization = apDescriptor->FloatQuantizations[aIndex];
+            const bool cInRange = aValue >= cQuantization.Min && aValue <= cQuantization.Max;
+
+            aWriter.WriteBits(cInRange ? 1 : 0, 1);
+
+            if (cInRange)
+            {
+                const auto cStep = std::round((aValue - cQuantization.Min) / cQuantization.Precision);
+                aWriter.WriteBits(static_cast<uint64_t>(cStep), cBits);
+                return;
+            }
+        }
+
+        aWriter.WriteBits(*reinterpret_cast<const uint32_t*>(&aValue), 32);
+    }
+
+    float ReadFloat(const AnimationGraphDescriptor* apDescriptor, size_t aIndex, TiltedPhoques::Buffer::Reader& aReader)
+    {
+        const uint32_t cBits = apDescriptor && aIndex < apDescriptor->FloatBits.size() ? apDescriptor->FloatBits[aIndex] : 0;
+        if (cBits)
+        {
+            uint64_t inRange = 0;
+            aReader.ReadBits(inRange, 1);
+
+            if (inRange)
+            {
+                const auto& cQuantization = apDescriptor->FloatQuantizations[aIndex];
+
+                uint64_t step = 0;
+                aReader.ReadBits(step, cBits);
+
+                return cQuantization.Min + static_cast<float>(step) * cQuantization.Precision;
+            }
+        }
+
+        uint64_t tmp = 0;
+        aReader.ReadBits(tmp, 32);
+        uint32_t data = tmp & 0xFFFFFFFF;
+        return *reinterpret_cast<float*>(&data);
+    }
+}
+
 bool AnimationVariables::operator==(const AnimationVariables& acRhs) const noexcept
 {
     return Booleans == acRhs.Booleans &&
         Integers == acRhs.Integers &&
-        Floats == acRhs.Floats;
+        Floats == acRhs.Floats &&
+        DescriptorKey == acRhs.DescriptorKey;
 }
 
 bool AnimationVariables::operator!=(const AnimationVariables& acRhs) const noexcept
@@ -30,43 +165,55 @@ void AnimationVariables::Save(std::ostream& aOutput) const
 
 void AnimationVariables::GenerateDiff(const AnimationVariables& aPrevious, TiltedPhoques::Buffer::Writer& aWriter) const
 {
+    const auto* pDescriptor = GetWireDescriptor(*this);
+    const auto cKey = pDescriptor ? DescriptorKey : 0;
+
+    // The receiver starts over when the graph changes, so does the diff
+    const AnimationVariables cEmpty{};
+    const auto* pPrevious = GetWireDescriptor(aPrevious);
+    const auto& cPrevious = (pPrevious ? aPrevious.DescriptorKey : 0) == cKey ? aPrevious : cEmpty;
+
+    // The receiver zeroes what it has when the counts change, compare against zeroes as well
+    const auto cSameIntegers = cPrevious.Integers.size() == Integers.size();
+    const auto cSameFloats = cPrevious.Floats.size() == Floats.size();
+
+    const auto cBooleanCount = pDescriptor ? static_cast<uint32_t>(pDescriptor->BooleanLookUpTable.size()) : 64u;
+    const auto cBooleanChanges = (Booleans ^ cPrevious.Booleans) & BooleanMask(cBooleanCount);
+
     uint64_t changes = 0;
     uint32_t idx = 0;
 
-    if(Booleans != aPrevious.Booleans)
+    if (cBooleanChanges != 0)
     {
         changes |= (1ull << idx);
     }
     ++idx;
 
-    auto integers = aPrevious.Integers;
-    if (integers.empty())
-        integers.assign(Integers.size(), 0);
-
     for (auto i = 0u; i < Integers.size(); ++i)
     {
-        if (Integers[i] != integers[i])
+        if (Integers[i] != (cSameIntegers ? cPrevious.Integers[i] : 0))
         {
             changes |= (1ull << idx);
         }
         ++idx;
     }
 
-    auto floats = aPrevious.Floats;
-    if (floats.empty())
-        floats.assign(Floats.size(), 0.f);
-
     for (auto i = 0u; i < Floats.size(); ++i)
     {
-        if (Floats[i] != floats[i])
+        if (Floats[i] != (cSameFloats ? cPrevious.Floats[i] : 0.f))
         {
             changes |= (1ull << idx);
         }
         ++idx;
     }
 
-    TiltedPhoques::Serialization::WriteVarInt(aWriter, Integers.size());
-    TiltedPhoques::Serialization::WriteVarInt(aWriter, Floats.size());
+    // The descriptor already knows the counts
+    Serialization::WriteVarInt(aWriter, pDescriptor ? pDescriptor->Id : 0);
+    if (!pDescriptor)
+    {
+        Serialization::WriteVarInt(aWriter, Integers.size());
+        Serialization::WriteVarInt(aWriter, Floats.size());
+    }
 
     const auto cDiffBitCount = 1 + Integers.size() + Floats.size();
 
@@ -75,7 +222,7 @@ void AnimationVariables::GenerateDiff(const AnimationVariables& aPrevious, Tilte
     idx = 0;
     if (changes & (1ull << idx))
     {
-        aWriter.WriteBits(Booleans, 64);
+        WriteBooleanChanges(cBooleanChanges, cBooleanCount, aWriter);
     }
     ++idx;
 
@@ -83,35 +230,66 @@ void AnimationVariables::GenerateDiff(const AnimationVariables& aPrevious, Tilte
     {
         if (changes & (1ull << idx))
         {
-            TiltedPhoques::Serialization::WriteVarInt(aWriter, value & 0xFFFFFFFF);
+            Serialization::WriteVarInt(aWriter, value & 0xFFFFFFFF);
         }
         ++idx;
     }
 
-    for (const auto value : Floats)
+    for (auto i = 0u; i < Floats.size(); ++i)
     {
         if (changes & (1ull << idx))
         {
-            aWriter.WriteBits(*reinterpret_cast<const uint32_t*>(&value), 32);
+            WriteFloat(Floats[i], pDescriptor, i, aWriter);
         }
         ++idx;
     }
 }
 
-void AnimationVariables::ApplyDiff(TiltedPhoques::Buffer::Reader& aReader)
+bool AnimationVariables::ApplyDiff(TiltedPhoques::Buffer::Reader& aReader) noexcept
 {
-    const auto cIntegersSize = TiltedPhoques::Serialization::ReadVarInt(aReader);
+    const auto cId = static_cast<uint32_t>(Serialization::ReadVarInt(aReader));
+
+    const AnimationGraphDescriptor* pDescriptor = nullptr;
+    uint64_t key = 0;
+
+    if (cId != 0)
+    {
+        const auto& cManager = AnimationGraphDescriptorManager::Get();
+        key = cManager.GetKey(cId);
+        pDescriptor = cManager.GetDescriptor(key);
+
+        // Nothing tells how long the diff is without the descriptor
+        if (!pDescriptor)
+        {
+            *this = AnimationVariables{};
+            return false;
+        }
+    }
+
+    if (key != DescriptorKey)
+    {
+        *this = AnimationVariables{};
+        DescriptorKey = key;
+    }
+
+    const auto cIntegersSize = pDescriptor ? pDescriptor->IntegerLookupTable.size() : Serialization::ReadVarInt(aReader);
     if (cIntegersSize > 0xFF)
-        throw std::runtime_error("Too many integers received !");
+    {
+        *this = AnimationVariables{};
+        return false;
+    }
 
     if (Integers.size() != cIntegersSize)
     {
         Integers.assign(cIntegersSize, 0);
     }
 
-    const auto cFloatsSize = TiltedPhoques::Serialization::ReadVarInt(aReader);
+    const auto cFloatsSize = pDescriptor ? pDescriptor->FloatLookupTable.size() : Serialization::ReadVarInt(aReader);
     if (cFloatsSize > 0xFF)
-        throw std::runtime_error("Too many floats received !");
+    {
+        *this = AnimationVariables{};
+        return false;
+    }
 
     if (Floats.size() != cFloatsSize)
     {
@@ -119,6 +297,7 @@ void AnimationVariables::ApplyDiff(TiltedPhoques::Buffer::Reader& aReader)
     }
 
     const auto cDiffBitCount = 1 + Integers.size() + Floats.size();
+    const auto cBooleanCount = pDescriptor ? static_cast<uint32_t>(pDescriptor->BooleanLookUpTable.size()) : 64u;
 
     uint64_t changes = 0;
     uint32_t idx = 0;
@@ -127,7 +306,7 @@ void AnimationVariables::ApplyDiff(TiltedPhoques::Buffer::Reader& aReader)
 
     if (changes & (1ull << idx))
     {
-        aReader.ReadBits(Booleans, 64);
+        Booleans ^= ReadBooleanChanges(cBooleanCount, aReader);
     }
     ++idx;
 
@@ -135,21 +314,19 @@ void AnimationVariables::ApplyDiff(TiltedPhoques::Buffer::Reader& aReader)
     {
         if (changes & (1ull << idx))
         {
-            value = TiltedPhoques::Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+            value = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
         }
         ++idx;
     }
 
-
-    for (auto& value : Floats)
+    for (auto i = 0u; i < Floats.size(); ++i)
     {
         if (changes & (1ull << idx))
         {
-            uint64_t tmp = 0;
-            aReader.ReadBits(tmp, 32);
-            uint32_t data = tmp & 0xFFFFFFFF;
-            value = *reinterpret_cast<float*>(&data);
+            Floats[i] = ReadFloat(pDescriptor, i, aReader);
         }
         ++idx;
     }
+
+    return true;
 }
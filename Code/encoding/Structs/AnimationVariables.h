@@ -11,6 +11,9 @@ struct AnimationVariables
     uint64_t Booleans{ 0 };
     Vector<uint32_t> Integers{};
     Vector<float> Floats{};
+    // Graph descriptor the variables were read with, 0 if unknown. A known descriptor lets the diff skip the counts
+    // and quantize the floats it declares a range for.
+    uint64_t DescriptorKey{ 0 };
 
     bool operator==(const AnimationVariables& acRhs) const noexcept;
     bool operator!=(const AnimationVariables& acRhs) const noexcept;
@@ -19,5 +22,7 @@ struct AnimationVariables
     void Save(std::ostream&) const;
 
     void GenerateDiff(const AnimationVariables& aPrevious, TiltedPhoques::Buffer::Writer& aWriter) const;
-    void ApplyDiff(TiltedPhoques::Buffer::Reader& aReader);
+    // Returns false if the diff can't be read, an unknown descriptor or too many variables, the variables are reset and
+    // whatever follows in the reader can't be trusted either
+    [[nodiscard]] bool ApplyDiff(TiltedPhoques::Buffer::Reader& aReader) noexcept;
 };
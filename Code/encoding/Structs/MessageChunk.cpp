@@ -0,0 +1,44 @@
+#include <Structs/MessageChunk.h>
+#include <TiltedCore/Serialization.hpp>
+
+using TiltedPhoques::Serialization;
+
+bool MessageChunk::operator==(const MessageChunk& acRhs) const noexcept
+{
+    return StreamId == acRhs.StreamId &&
+        TotalSize == acRhs.TotalSize &&
+        Offset == acRhs.Offset &&
+        Data == acRhs.Data;
+}
+
+bool MessageChunk::operator!=(const MessageChunk& acRhs) const noexcept
+{
+    return !this->operator==(acRhs);
+}
+
+void MessageChunk::Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Serialization::WriteVarInt(aWriter, StreamId);
+    Serialization::WriteVarInt(aWriter, TotalSize);
+    Serialization::WriteVarInt(aWriter, Offset);
+    Serialization::WriteVarInt(aWriter, Data.size());
+    aWriter.WriteBytes(Data.data(), Data.size());
+}
+
+void MessageChunk::Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    StreamId = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+    TotalSize = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+    Offset = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+
+    // Don't let a bogus length allocate more than a chunk can hold
+    const auto cLength = Serialization::ReadVarInt(aReader);
+    if (cLength > kMaxSize)
+    {
+        Data.clear();
+        return;
+    }
+
+    Data.resize(cLength);
+    aReader.ReadBytes(Data.data(), cLength);
+}
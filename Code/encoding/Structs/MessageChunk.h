@@ -0,0 +1,28 @@
+#pragma once
+
+#include <TiltedCore/Stl.hpp>
+#include <TiltedCore/Buffer.hpp>
+
+using TiltedPhoques::Vector;
+using TiltedPhoques::Buffer;
+
+// Part of a serialized message too large to go out in a single packet, see MessageStream.h
+struct MessageChunk
+{
+    static constexpr size_t kMaxSize = 16 * 1024;
+
+    uint32_t StreamId{};
+    // Size of the whole serialized message
+    uint32_t TotalSize{};
+    uint32_t Offset{};
+    Vector<uint8_t> Data{};
+
+    MessageChunk() = default;
+    ~MessageChunk() = default;
+
+    bool operator==(const MessageChunk& acRhs) const noexcept;
+    bool operator!=(const MessageChunk& acRhs) const noexcept;
+
+    void Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept;
+    void Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept;
+};
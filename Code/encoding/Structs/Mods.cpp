@@ -14,6 +14,39 @@ bool Mods::operator!=(const Mods& acRhs) const noexcept
     return !this->operator==(acRhs);
 }
 
+uint64_t Mods::GetHash() const noexcept
+{
+    // FNV-1a
+    constexpr uint64_t cPrime = 0x100000001B3ull;
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    const auto hashString = [&hash](const String& acString) {
+        for (const auto c : acString)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= cPrime;
+        }
+
+        // Separator so "ab" + "c" doesn't hash like "a" + "bc"
+        hash ^= 0xFF;
+        hash *= cPrime;
+    };
+
+    for (auto& entry : StandardMods)
+        hashString(entry.Filename);
+
+    hash ^= StandardMods.size();
+    hash *= cPrime;
+
+    for (auto& entry : LiteMods)
+        hashString(entry.Filename);
+
+    hash ^= LiteMods.size();
+    hash *= cPrime;
+
+    return hash;
+}
+
 void Mods::Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
 {
     const uint8_t standardCount = StandardMods.size() & 0xFF;
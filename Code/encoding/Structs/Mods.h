@@ -34,6 +34,9 @@ struct Mods
     bool operator==(const Mods& acRhs) const noexcept;
     bool operator!=(const Mods& acRhs) const noexcept;
 
+    // Hash of the load order, only filenames are used so the client and the server agree on it
+    [[nodiscard]] uint64_t GetHash() const noexcept;
+
     void Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept;
     void Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept;
 };
@@ -5,8 +5,8 @@ using TiltedPhoques::Serialization;
 
 bool Movement::operator==(const Movement& acRhs) const noexcept
 {
-    return CellId == acRhs.CellId &&
-        WorldSpaceId == acRhs.WorldSpaceId &&
+    return HasCell == acRhs.HasCell &&
+        (!HasCell || (CellId == acRhs.CellId && WorldSpaceId == acRhs.WorldSpaceId)) &&
         Position == acRhs.Position &&
         Rotation == acRhs.Rotation &&
         Variables == acRhs.Variables &&
@@ -20,25 +20,56 @@ bool Movement::operator!=(const Movement& acRhs) const noexcept
 
 void Movement::Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
 {
-    CellId.Serialize(aWriter);
-    WorldSpaceId.Serialize(aWriter);
-    Position.Serialize(aWriter);
-    Rotation.Serialize(aWriter);
+    aWriter.WriteBits(HasCell ? 1 : 0, 1);
+    if (HasCell)
+    {
+        CellId.Serialize(aWriter);
+        WorldSpaceId.Serialize(aWriter);
+    }
+
+    if (QuantizedPosition)
+        Vector3_NetQuantize::SerializeCellRelative(aWriter, *QuantizedPosition);
+    else
+        Position.SerializeCellRelative(aWriter);
+
+    if (QuantizedRotation)
+        aWriter.WriteBits(*QuantizedRotation, 32);
+    else
+        Rotation.Serialize(aWriter);
+
     Variables.GenerateDiff(AnimationVariables{}, aWriter);
     aWriter.WriteBits(*reinterpret_cast<const uint32_t*>(&Direction), 32);
 }
 
-void Movement::Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept
+bool Movement::Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept
 {
-    CellId.Deserialize(aReader);
-    WorldSpaceId.Deserialize(aReader);
-    Position.Deserialize(aReader);
+    uint64_t hasCell = 0;
+    aReader.ReadBits(hasCell, 1);
+    HasCell = hasCell != 0;
+
+    if (HasCell)
+    {
+        CellId.Deserialize(aReader);
+        WorldSpaceId.Deserialize(aReader);
+    }
+    else
+    {
+        CellId = {};
+        WorldSpaceId = {};
+    }
+
+    Position.DeserializeCellRelative(aReader);
     Rotation.Deserialize(aReader);
+    QuantizedPosition.reset();
+    QuantizedRotation.reset();
     Variables = AnimationVariables{};
-    Variables.ApplyDiff(aReader);
+    if (!Variables.ApplyDiff(aReader))
+        return false;
 
     uint64_t tmp = 0;
     aReader.ReadBits(tmp, 32);
     uint32_t tmp32 = tmp & 0xFFFFFFFF;
     Direction = *reinterpret_cast<float*>(&tmp32);
+
+    return true;
 }
@@ -5,6 +5,7 @@
 #include <Structs/Vector3_NetQuantize.h>
 #include <Structs/Rotator2_NetQuantize.h>
 #include <Structs/AnimationVariables.h>
+#include <optional>
 
 using TiltedPhoques::Buffer;
 
@@ -17,12 +18,20 @@ struct Movement
     bool operator!=(const Movement& acRhs) const noexcept;
 
     void Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept;
-    void Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept;
+    // Returns false if the movement couldn't be read, the update has to be dropped
+    bool Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept;
 
+    // Cell and worldspace are only sent when HasCell is set, the receiver keeps the last ones it got otherwise
+    bool HasCell{false};
     GameId CellId{};
     GameId WorldSpaceId{};
     Vector3_NetQuantize Position{};
     Rotator2_NetQuantize Rotation{};
     AnimationVariables Variables{};
     float Direction{};
+
+    // Position and Rotation quantized ahead of time along with other entities, Serialize writes these instead of
+    // quantizing again. Neither sent nor compared, whoever sets them has to keep them in sync with the real values.
+    std::optional<Vector3_NetQuantize::CellRelative> QuantizedPosition{};
+    std::optional<uint32_t> QuantizedRotation{};
 };
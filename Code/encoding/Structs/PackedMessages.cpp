@@ -0,0 +1,59 @@
+#include <Structs/PackedMessages.h>
+#include <TiltedCore/Serialization.hpp>
+#include <algorithm>
+
+using TiltedPhoques::Serialization;
+
+bool PackedMessages::Append(const uint8_t* apMessage, size_t aSize, size_t aMaxSize) noexcept
+{
+    uint8_t prefix[4];
+    size_t prefixSize = 0;
+
+    auto length = aSize;
+    do
+    {
+        prefix[prefixSize] = static_cast<uint8_t>(length & 0x7F);
+        length >>= 7;
+        if (length)
+            prefix[prefixSize] |= 0x80;
+        ++prefixSize;
+    } while (length && prefixSize < sizeof(prefix));
+
+    if (aSize == 0 || length || Data.size() + prefixSize + aSize > std::min(aMaxSize, kMaxSize))
+        return false;
+
+    Data.insert(std::end(Data), prefix, prefix + prefixSize);
+    Data.insert(std::end(Data), apMessage, apMessage + aSize);
+
+    return true;
+}
+
+bool PackedMessages::operator==(const PackedMessages& acRhs) const noexcept
+{
+    return Data == acRhs.Data;
+}
+
+bool PackedMessages::operator!=(const PackedMessages& acRhs) const noexcept
+{
+    return !this->operator==(acRhs);
+}
+
+void PackedMessages::Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Serialization::WriteVarInt(aWriter, Data.size());
+    aWriter.WriteBytes(Data.data(), Data.size());
+}
+
+void PackedMessages::Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    // Don't let a bogus length allocate more than a batch can hold
+    const auto cLength = Serialization::ReadVarInt(aReader);
+    if (cLength > kMaxSize)
+    {
+        Data.clear();
+        return;
+    }
+
+    Data.resize(cLength);
+    aReader.ReadBytes(Data.data(), cLength);
+}
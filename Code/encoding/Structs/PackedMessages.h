@@ -0,0 +1,59 @@
+#pragma once
+
+#include <TiltedCore/Stl.hpp>
+#include <TiltedCore/Buffer.hpp>
+
+using TiltedPhoques::Vector;
+using TiltedPhoques::Buffer;
+
+// Serialized messages packed back to back, each one prefixed with its length as a varint
+struct PackedMessages
+{
+    static constexpr size_t kMaxSize = 16 * 1024;
+
+    Vector<uint8_t> Data{};
+
+    PackedMessages() = default;
+    ~PackedMessages() = default;
+
+    // Returns false if the message doesn't fit in aMaxSize, which can't be more than kMaxSize
+    [[nodiscard]] bool Append(const uint8_t* apMessage, size_t aSize, size_t aMaxSize = kMaxSize) noexcept;
+    // Calls aFunctor(const uint8_t* apMessage, size_t aSize) for each message, returns false if the data is malformed
+    template <class T> [[nodiscard]] bool Visit(const T& aFunctor) const noexcept;
+
+    bool operator==(const PackedMessages& acRhs) const noexcept;
+    bool operator!=(const PackedMessages& acRhs) const noexcept;
+
+    void Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept;
+    void Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept;
+};
+
+template <class T>
+bool PackedMessages::Visit(const T& aFunctor) const noexcept
+{
+    size_t position = 0;
+    while (position < Data.size())
+    {
+        size_t length = 0;
+        uint32_t shift = 0;
+        uint8_t byte;
+
+        do
+        {
+            if (position >= Data.size() || shift > 21)
+                return false;
+
+            byte = Data[position++];
+            length |= static_cast<size_t>(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        if (length == 0 || length > Data.size() - position)
+            return false;
+
+        aFunctor(Data.data() + position, length);
+        position += length;
+    }
+
+    return true;
+}
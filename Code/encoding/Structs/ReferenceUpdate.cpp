@@ -1,6 +1,5 @@
 #include <Structs/ReferenceUpdate.h>
 #include <TiltedCore/Serialization.hpp>
-#include <stdexcept>
 
 using TiltedPhoques::Serialization;
 
@@ -27,18 +26,22 @@ void ReferenceUpdate::Serialize(TiltedPhoques::Buffer::Writer& aWriter) const no
     }
 }
 
-void ReferenceUpdate::Deserialize(TiltedPhoques::Buffer::Reader& aReader)
+bool ReferenceUpdate::Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept
 {
-    UpdatedMovement.Deserialize(aReader);
+    if (!UpdatedMovement.Deserialize(aReader))
+        return false;
 
     const auto count = Serialization::ReadVarInt(aReader);
     if (count > 0x100)
-        throw std::runtime_error("Too many reference updates received !");
+        return false;
 
     ActionEvents.resize(count);
 
     for (auto i = 0u; i < count; ++i)
     {
-        ActionEvents[i].ApplyDifferential(aReader);
+        if (!ActionEvents[i].ApplyDifferential(aReader))
+            return false;
     }
+
+    return true;
 }
@@ -16,7 +16,8 @@ struct ReferenceUpdate
     bool operator!=(const ReferenceUpdate& acRhs) const noexcept;
 
     void Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept;
-    void Deserialize(TiltedPhoques::Buffer::Reader& aReader);
+    // Returns false if the update couldn't be read, nothing after it in the reader can be read either
+    bool Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept;
 
     Movement UpdatedMovement{};
     Vector<ActionEvent> ActionEvents{};
@@ -40,6 +40,11 @@ void Rotator2_NetQuantize::Unpack(uint32_t aValue) noexcept
 }
 
 uint32_t Rotator2_NetQuantize::Pack() const noexcept
+{
+    return Pack(x, y);
+}
+
+uint32_t Rotator2_NetQuantize::Pack(float aX, float aY) noexcept
 {
     uint32_t data = 0;
 
@@ -54,8 +59,8 @@ uint32_t Rotator2_NetQuantize::Pack() const noexcept
         return angle;
     };
 
-    uint32_t ix = static_cast<uint32_t>(WrapAngle(x) * cScalingFactory) & 0xFFFF;
-    uint32_t iy = static_cast<uint32_t>(WrapAngle(y) * cScalingFactory) & 0xFFFF;
+    uint32_t ix = static_cast<uint32_t>(WrapAngle(aX) * cScalingFactory) & 0xFFFF;
+    uint32_t iy = static_cast<uint32_t>(WrapAngle(aY) * cScalingFactory) & 0xFFFF;
 
     data |= ix;
     data |= iy << 16;
@@ -21,5 +21,7 @@ struct Rotator2_NetQuantize : glm::vec2
     void Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept;
 
     [[nodiscard]] uint32_t Pack() const noexcept;
+    // Same as Pack for angles that aren't stored in a rotator
+    [[nodiscard]] static uint32_t Pack(float aX, float aY) noexcept;
     void Unpack(uint32_t aValue) noexcept;
 };
@@ -15,15 +15,13 @@ bool Scripts::operator!=(const Scripts& acRhs) const noexcept
 
 void Scripts::Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
 {
-    aWriter.WriteBits(Data.size(), 16);
+    Serialization::WriteVarInt(aWriter, Data.size());
     aWriter.WriteBytes(Data.data(), Data.size());
 }
 
 void Scripts::Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept
 {
-    uint64_t tmp = 0;
-    aReader.ReadBits(tmp, 16);
-
-    Data.resize(tmp & 0xFFFF);
-    aReader.ReadBytes(Data.data(), Data.size());
+    const auto dataLength = Serialization::ReadVarInt(aReader);
+    Data.resize(dataLength);
+    aReader.ReadBytes(Data.data(), dataLength);
 }
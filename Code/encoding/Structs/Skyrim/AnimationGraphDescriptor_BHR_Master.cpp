@@ -218,6 +218,34 @@ AnimationGraphDescriptor_BHR_Master::AnimationGraphDescriptor_BHR_Master(Animati
             kTurnDeltaTarget,
             kPitchDeltaTarget,
             kFlightPitchBlendTarget,},
+            // Float quantizations, min, max and precision
+            {{-3.2f, 3.2f, 0.001f},
+            {-3.2f, 3.2f, 0.001f},
+            {0.f, 360.f, 0.001f},
+            {0.f, 4096.f, 0.01f},
+            {0.f, 4096.f, 0.01f},
+            {-3.2f, 3.2f, 0.001f},
+            {-3.2f, 3.2f, 0.001f},
+            {0.f, 4096.f, 0.01f},
+            {0.f, 4096.f, 0.01f},
+            {},
+            {},
+            {-1.f, 1.f, 0.001f},
+            {0.f, 360.f, 0.001f},
+            {0.f, 1.f, 0.001f},
+            {0.f, 1.f, 0.001f},
+            {0.f, 1.f, 0.001f},
+            {0.f, 1.f, 0.001f},
+            {-3.2f, 3.2f, 0.001f},
+            {0.f, 65536.f, 0.5f},
+            {-3.2f, 3.2f, 0.001f},
+            {0.f, 1.f, 0.001f},
+            {0.f, 1.f, 0.001f},
+            {0.f, 1.f, 0.0001f},
+            {0.f, 360.f, 0.001f},
+            {-3.2f, 3.2f, 0.001f},
+            {-3.2f, 3.2f, 0.001f},
+            {-1.f, 1.f, 0.001f},},
             // Integers
             {kiSyncIdleLocomotion,
             kiSyncTurnState,
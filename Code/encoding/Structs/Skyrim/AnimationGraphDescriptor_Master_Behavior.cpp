@@ -394,6 +394,12 @@ AnimationGraphDescriptor_Master_Behavior::AnimationGraphDescriptor_Master_Behavi
             kweapAdj,
             kSpeed,
         },
+        // Float quantizations, min, max and precision
+        {{0.f, 360.f, 0.001f},
+            {0.f, 2048.f, 0.01f},
+            {},
+            {0.f, 2048.f, 0.01f},
+        },
         {kTurnDelta,
             kiRightHandEquipped,
             kiLeftHandEquipped,
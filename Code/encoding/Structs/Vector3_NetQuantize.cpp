@@ -1,8 +1,58 @@
 #include <Structs/Vector3_NetQuantize.h>
+#include <Structs/GridCellCoords.h>
 #include <TiltedCore/Serialization.hpp>
+#include <algorithm>
+#include <cmath>
 
 using TiltedPhoques::Serialization;
 
+namespace
+{
+    uint64_t ZigZag(int32_t aValue) noexcept
+    {
+        return (static_cast<uint32_t>(aValue) << 1) ^ static_cast<uint32_t>(aValue >> 31);
+    }
+
+    int32_t UnZigZag(uint64_t aValue) noexcept
+    {
+        const auto cValue = static_cast<uint32_t>(aValue);
+        return static_cast<int32_t>((cValue >> 1) ^ (~(cValue & 1) + 1));
+    }
+
+    // Rounds to the nearest step, ties to even, the same way the batch quantizer's SIMD paths do
+    uint32_t Quantize(float aValue, float aScale, uint32_t aMax) noexcept
+    {
+        const auto cScaled = std::min(std::max(aValue * aScale, 0.f), static_cast<float>(aMax));
+        return std::min(static_cast<uint32_t>(std::nearbyint(cScaled)), aMax);
+    }
+
+    // An offset that rounds up to the size of the cell is the origin of the next cell, clamping it would move it
+    void QuantizeOffset(float aOffset, float aScale, uint32_t aMaxOffset, int32_t& aCell, uint32_t& aQuantized) noexcept
+    {
+        aQuantized = Quantize(aOffset, aScale, aMaxOffset + 1);
+        if (aQuantized > aMaxOffset)
+        {
+            ++aCell;
+            aQuantized = 0;
+        }
+    }
+}
+
+bool Vector3_NetQuantize::CellRelative::operator==(const CellRelative& acRhs) const noexcept
+{
+    return CellX == acRhs.CellX &&
+        CellY == acRhs.CellY &&
+        OffsetX == acRhs.OffsetX &&
+        OffsetY == acRhs.OffsetY &&
+        Height == acRhs.Height &&
+        Negative == acRhs.Negative;
+}
+
+bool Vector3_NetQuantize::CellRelative::operator!=(const CellRelative& acRhs) const noexcept
+{
+    return !this->operator==(acRhs);
+}
+
 bool Vector3_NetQuantize::operator==(const Vector3_NetQuantize& acRhs) const noexcept
 {
     return Pack() == acRhs.Pack();
@@ -32,6 +82,72 @@ void Vector3_NetQuantize::Deserialize(TiltedPhoques::Buffer::Reader& aReader) no
     Unpack(data);
 }
 
+void Vector3_NetQuantize::SerializeCellRelative(TiltedPhoques::Buffer::Writer& aWriter, uint32_t aFractionBits) const noexcept
+{
+    SerializeCellRelative(aWriter, QuantizeCellRelative(aFractionBits), aFractionBits);
+}
+
+Vector3_NetQuantize::CellRelative Vector3_NetQuantize::QuantizeCellRelative(uint32_t aFractionBits) const noexcept
+{
+    aFractionBits = std::min(aFractionBits, kMaxFractionBits);
+
+    const auto cX = std::clamp(std::isfinite(x) ? x : 0.f, -kMaxCoordinate, kMaxCoordinate);
+    const auto cY = std::clamp(std::isfinite(y) ? y : 0.f, -kMaxCoordinate, kMaxCoordinate);
+    const auto cZ = std::clamp(std::isfinite(z) ? z : 0.f, -kMaxCoordinate, kMaxCoordinate);
+
+    const auto cCell = GridCellCoords::CalculateGridCellCoords(cX, cY);
+
+    const auto cScale = static_cast<float>(1u << aFractionBits);
+    const auto cMaxOffset = (1u << (kCellOffsetBits + aFractionBits)) - 1;
+
+    CellRelative position;
+    position.CellX = cCell.X;
+    position.CellY = cCell.Y;
+    QuantizeOffset(cX - static_cast<float>(cCell.X) * kCellSize, cScale, cMaxOffset, position.CellX, position.OffsetX);
+    QuantizeOffset(cY - static_cast<float>(cCell.Y) * kCellSize, cScale, cMaxOffset, position.CellY, position.OffsetY);
+    position.Height = Quantize(std::abs(cZ), cScale, (1u << (kHeightBits + aFractionBits)) - 1);
+    position.Negative = cZ < 0.f;
+
+    return position;
+}
+
+void Vector3_NetQuantize::SerializeCellRelative(TiltedPhoques::Buffer::Writer& aWriter, const CellRelative& acPosition,
+                                                uint32_t aFractionBits) noexcept
+{
+    aFractionBits = std::min(aFractionBits, kMaxFractionBits);
+
+    Serialization::WriteVarInt(aWriter, ZigZag(acPosition.CellX));
+    Serialization::WriteVarInt(aWriter, ZigZag(acPosition.CellY));
+
+    const auto cOffsetBits = kCellOffsetBits + aFractionBits;
+    aWriter.WriteBits(acPosition.OffsetX, cOffsetBits);
+    aWriter.WriteBits(acPosition.OffsetY, cOffsetBits);
+
+    aWriter.WriteBits(acPosition.Negative ? 1 : 0, 1);
+    aWriter.WriteBits(acPosition.Height, kHeightBits + aFractionBits);
+}
+
+void Vector3_NetQuantize::DeserializeCellRelative(TiltedPhoques::Buffer::Reader& aReader, uint32_t aFractionBits) noexcept
+{
+    aFractionBits = std::min(aFractionBits, kMaxFractionBits);
+
+    const auto cCellX = UnZigZag(Serialization::ReadVarInt(aReader));
+    const auto cCellY = UnZigZag(Serialization::ReadVarInt(aReader));
+
+    const auto cScale = 1.f / static_cast<float>(1u << aFractionBits);
+    const auto cOffsetBits = kCellOffsetBits + aFractionBits;
+
+    uint64_t offsetX = 0, offsetY = 0, sign = 0, height = 0;
+    aReader.ReadBits(offsetX, cOffsetBits);
+    aReader.ReadBits(offsetY, cOffsetBits);
+    aReader.ReadBits(sign, 1);
+    aReader.ReadBits(height, kHeightBits + aFractionBits);
+
+    x = static_cast<float>(cCellX) * kCellSize + static_cast<float>(offsetX) * cScale;
+    y = static_cast<float>(cCellY) * kCellSize + static_cast<float>(offsetY) * cScale;
+    z = (sign ? -1.f : 1.f) * static_cast<float>(height) * cScale;
+}
+
 void Vector3_NetQuantize::Unpack(uint64_t aValue) noexcept
 {
     int32_t xSign = (aValue & 1) != 0;
@@ -7,6 +7,31 @@ using TiltedPhoques::Buffer;
 
 struct Vector3_NetQuantize : glm::vec3
 {
+    // Bits kept below the unit by the cell relative encoding, a quarter of a unit is well below what players notice
+    static constexpr uint32_t kDefaultFractionBits = 2;
+    static constexpr uint32_t kMaxFractionBits = 8;
+    static constexpr float kCellSize = 4096.f;
+    // Offset inside a cell, 4096 units
+    static constexpr uint32_t kCellOffsetBits = 12;
+    // Height is absolute, the sign is stored apart
+    static constexpr uint32_t kHeightBits = 17;
+    // Anything outside of this is garbage, keep the cell math from overflowing
+    static constexpr float kMaxCoordinate = 16777216.f;
+
+    // A position the way the cell relative encoding sends it
+    struct CellRelative
+    {
+        bool operator==(const CellRelative& acRhs) const noexcept;
+        bool operator!=(const CellRelative& acRhs) const noexcept;
+
+        int32_t CellX{0};
+        int32_t CellY{0};
+        uint32_t OffsetX{0};
+        uint32_t OffsetY{0};
+        uint32_t Height{0};
+        bool Negative{false};
+    };
+
     Vector3_NetQuantize() = default;
     ~Vector3_NetQuantize() = default;
 
@@ -18,6 +43,16 @@ struct Vector3_NetQuantize : glm::vec3
     void Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept;
     void Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept;
 
+    // Encodes the position relative to the origin of its 4096 units grid cell, the cell coordinates are small varints
+    // and the offset inside the cell keeps aFractionBits bits of precision below the unit anywhere in the world
+    void SerializeCellRelative(TiltedPhoques::Buffer::Writer& aWriter, uint32_t aFractionBits = kDefaultFractionBits) const noexcept;
+    void DeserializeCellRelative(TiltedPhoques::Buffer::Reader& aReader, uint32_t aFractionBits = kDefaultFractionBits) noexcept;
+
+    // The two halves of SerializeCellRelative, for positions that were quantized ahead of time
+    [[nodiscard]] CellRelative QuantizeCellRelative(uint32_t aFractionBits = kDefaultFractionBits) const noexcept;
+    static void SerializeCellRelative(TiltedPhoques::Buffer::Writer& aWriter, const CellRelative& acPosition,
+                                      uint32_t aFractionBits = kDefaultFractionBits) noexcept;
+
     [[nodiscard]] uint64_t Pack() const noexcept;
     void Unpack(uint64_t aValue) noexcept;
 };
@@ -2,32 +2,132 @@
 
 #include <Components.h>
 
+static constexpr size_t kMaxManifests = 256;
+// Names are sent by clients, don't let made up ones fill the table. A full load order is 254 plugins and 4096 lite ones.
+static constexpr size_t kMaxMods = 16384;
+// Ids go on the wire as 16 bits and are never given twice
+static constexpr uint32_t kMaxModIds = 0x10000;
+
 uint32_t ModsComponent::AddStandard(const String& acpFilename) noexcept
 {
-    const auto itor = m_standardMods.find(acpFilename);
-    if (itor != std::end(m_standardMods))
+    return Add(m_standardMods, acpFilename, false);
+}
+
+uint32_t ModsComponent::AddLite(const String& acpFilename) noexcept
+{
+    return Add(m_liteMods, acpFilename, true);
+}
+
+uint32_t ModsComponent::Add(TModList& aList, const String& acpFilename, bool aLite) noexcept
+{
+    const auto itor = aList.find(acpFilename);
+    if (itor != std::end(aList))
     {
-        itor.value().refCount++;
-        return itor->second.id;
+        m_entries[itor->second].refCount++;
+        return itor->second;
     }
 
     const auto id = m_seed++;
-    m_standardMods.emplace(acpFilename, Entry{ id, 1 });
+
+    aList.emplace(acpFilename, id);
+    m_entries.emplace(id, Entry{acpFilename, aLite, 1});
 
     return id;
 }
 
-uint32_t ModsComponent::AddLite(const String& acpFilename) noexcept
+void ModsComponent::Release(const Vector<uint16_t>& acIds) noexcept
 {
-    const auto itor = m_liteMods.find(acpFilename);
-    if (itor != std::end(m_liteMods))
+    for (const auto id : acIds)
     {
-        itor.value().refCount++;
-        return itor->second.id;
+        const auto itor = m_entries.find(id);
+        if (itor == std::end(m_entries))
+            continue;
+
+        auto& entry = itor.value();
+        if (entry.refCount > 1)
+        {
+            --entry.refCount;
+            continue;
+        }
+
+        Erase(id);
     }
+}
 
-    const auto id = m_seed++;
-    m_liteMods.emplace(acpFilename, Entry{ id, 1 });
+void ModsComponent::Erase(uint32_t aId) noexcept
+{
+    const auto itor = m_entries.find(aId);
+    if (itor == std::end(m_entries))
+        return;
 
-    return id;
+    auto& list = itor->second.Lite ? m_liteMods : m_standardMods;
+    list.erase(itor->second.Filename);
+    m_entries.erase(itor);
+
+    // The id itself is never given to another mod, state keyed by game ids of this mod can outlive its players. The
+    // manifests using it would hand it out again though.
+    for (auto manifest = std::begin(m_manifests); manifest != std::end(m_manifests);)
+    {
+        const auto& cIds = manifest->second.Ids;
+        if (std::find(std::begin(cIds), std::end(cIds), aId) != std::end(cIds))
+            manifest = m_manifests.erase(manifest);
+        else
+            ++manifest;
+    }
+}
+
+const ModsComponent::Manifest* ModsComponent::Resolve(const Mods& acMods) noexcept
+{
+    size_t newMods = 0;
+    for (auto& standardMod : acMods.StandardMods)
+        newMods += m_standardMods.contains(standardMod.Filename) ? 0 : 1;
+    for (auto& liteMod : acMods.LiteMods)
+        newMods += m_liteMods.contains(liteMod.Filename) ? 0 : 1;
+
+    if (m_entries.size() + newMods > kMaxMods || m_seed + newMods > kMaxModIds)
+        return nullptr;
+
+    // Don't trust the hash sent by the client, a wrong one would poison the cache for everyone
+    const auto cHash = acMods.GetHash();
+
+    if (m_manifests.size() >= kMaxManifests && !m_manifests.contains(cHash))
+        m_manifests.clear();
+
+    auto& manifest = m_manifests[cHash];
+    manifest = Manifest{};
+
+    // Note: to lower traffic we only send the mod ids the user can fix in order as other ids will lead to a null form id anyway
+    for (auto& standardMod : acMods.StandardMods)
+    {
+        const auto id = static_cast<uint16_t>(AddStandard(standardMod.Filename));
+
+        manifest.ServerMods.StandardMods.push_back({standardMod.Filename, id});
+        manifest.Filenames.push_back(standardMod.Filename);
+        manifest.Ids.push_back(id);
+    }
+
+    for (auto& liteMod : acMods.LiteMods)
+    {
+        const auto id = static_cast<uint16_t>(AddLite(liteMod.Filename));
+
+        manifest.ServerMods.LiteMods.push_back({liteMod.Filename, id});
+        manifest.Filenames.push_back(liteMod.Filename);
+        manifest.Ids.push_back(id);
+    }
+
+    return &manifest;
+}
+
+const ModsComponent::Manifest* ModsComponent::Acquire(uint64_t aHash) noexcept
+{
+    const auto itor = m_manifests.find(aHash);
+    if (itor == std::end(m_manifests))
+        return nullptr;
+
+    // Manifests go away with any of their mods, every id is still in the table
+    auto& manifest = itor.value();
+    for (const auto id : manifest.Ids)
+        m_entries[id].refCount++;
+
+    return &manifest;
 }
@@ -4,24 +4,49 @@
 #error Include Components.h instead
 #endif
 
+#include <Structs/Mods.h>
+
 struct ModsComponent
 {
     struct Entry
     {
-        uint32_t id;
+        String Filename;
+        bool Lite;
         uint32_t refCount;
     };
 
+    // A resolved load order, most players share the same one so it is cached by hash
+    struct Manifest
+    {
+        Mods ServerMods;
+        Vector<String> Filenames;
+        Vector<uint16_t> Ids;
+    };
+
     uint32_t AddStandard(const String& acpFilename) noexcept;
     uint32_t AddLite(const String& acpFilename) noexcept;
+    void Release(const Vector<uint16_t>& acIds) noexcept;
+
+    // Adds every mod of the list and caches the result, the returned pointer is valid until the next call. nullptr if
+    // the list would take the table past its limits, the player has to be turned away.
+    const Manifest* Resolve(const Mods& acMods) noexcept;
+    // Takes a reference on every mod of a known manifest, nullptr if the hash was never resolved
+    const Manifest* Acquire(uint64_t aHash) noexcept;
+    [[nodiscard]] bool HasManifest(uint64_t aHash) const noexcept { return m_manifests.contains(aHash); }
 
     const auto& GetStandardMods() const noexcept { return m_standardMods; }
     const auto& GetLiteMods() const noexcept { return m_liteMods; }
 
-    using TModList = Map<String, Entry>; 
+    using TModList = Map<String, uint32_t>; 
 private:
 
+    uint32_t Add(TModList& aList, const String& acpFilename, bool aLite) noexcept;
+    // Forgets a mod nobody has loaded anymore along with the manifests that use it
+    void Erase(uint32_t aId) noexcept;
+
     uint32_t m_seed = 0;
-    Map<String, Entry> m_standardMods;
-    Map<String, Entry> m_liteMods;
+    TModList m_standardMods;
+    TModList m_liteMods;
+    Map<uint32_t, Entry> m_entries;
+    Map<uint64_t, Manifest> m_manifests;
 };
@@ -5,6 +5,7 @@
 #endif
 
 #include <Structs/AnimationVariables.h>
+#include <Structs/Vector3_NetQuantize.h>
 
 struct MovementComponent
 {
@@ -14,5 +15,15 @@ struct MovementComponent
     AnimationVariables Variables;
     float Direction;
 
-    bool Sent;
+    // Position and rotation as they go on the wire, refreshed once per snapshot for the entities that moved
+    struct Quantized
+    {
+        glm::vec3 Position{};
+        glm::vec3 Rotation{};
+        Vector3_NetQuantize::CellRelative CellRelative{};
+        uint32_t PackedRotation{0};
+        bool Valid{false};
+    };
+
+    Quantized Wire{};
 };
@@ -0,0 +1,18 @@
+#include <stdafx.h>
+
+#include <Components.h>
+#include <Game/Player.h>
+
+void OwnerComponent::SetOwner(Player* apPlayer) noexcept
+{
+    if (pOwner == apPlayer)
+        return;
+
+    if (pOwner)
+        pOwner->RemoveOwnedEntity(Entity);
+
+    pOwner = apPlayer;
+
+    if (pOwner)
+        pOwner->AddOwnedEntity(Entity);
+}
@@ -7,7 +7,7 @@
 struct Player;
 struct OwnerComponent
 {
-    OwnerComponent(Player* apPlayer) : pOwner(apPlayer)
+    OwnerComponent(entt::entity aEntity, Player* apPlayer) : Entity(aEntity), pOwner(apPlayer)
     {}
 
 
@@ -16,11 +16,10 @@ struct OwnerComponent
         return reinterpret_cast<Player*>(pOwner);    
     }
 
-    void SetOwner(Player* apPlayer)
-    {
-        pOwner = apPlayer;
-    }
+    // Keeps the owners' entity lists in sync, the registry takes care of it when the component is added or removed
+    void SetOwner(Player* apPlayer) noexcept;
 
+    entt::entity Entity;
     Player* pOwner;
     Vector<const Player*> InvalidOwners{};
     
@@ -1,12 +1,17 @@
 #pragma once
 
-#include "Structs/GameId.h"
+#include <Components.h>
 
+struct Player;
+
+// Triggered after a player's cell changed, the new cell is the one the player holds now
 struct PlayerLeaveCellEvent
 {
-    PlayerLeaveCellEvent(const GameId aOldCell)
-        : OldCell(aOldCell)
+    PlayerLeaveCellEvent(Player* apPlayer, const CellIdComponent& acOldCell)
+        : pPlayer(apPlayer)
+        , OldCell(acOldCell)
     {}
 
-    GameId OldCell;
+    Player* pPlayer;
+    CellIdComponent OldCell;
 };
@@ -0,0 +1,137 @@
+#include <stdafx.h>
+
+#include <Game/CellRegistry.h>
+#include <Components.h>
+
+namespace
+{
+    constexpr double kEvictionDelay = 30.0;
+
+    const Vector<entt::entity> s_noObjects{};
+}
+
+void CellRegistry::Move(const CellIdComponent& acOldCell, const CellIdComponent& acNewCell) noexcept
+{
+    // Take the new references first so cells shared by both grids never look empty
+    if (acNewCell)
+        ForEachCell(acNewCell, [this](const CellKey& acKey) { Acquire(acKey); });
+
+    if (acOldCell)
+        ForEachCell(acOldCell, [this](const CellKey& acKey) { Release(acKey); });
+}
+
+void CellRegistry::AddObject(entt::entity aEntity, const CellIdComponent& acCell) noexcept
+{
+    const auto key = GetKey(acCell);
+
+    auto& entry = m_cells[key];
+    entry.Objects.push_back(aEntity);
+
+    // Nobody is there to keep it alive, let it expire like any other empty cell
+    if (entry.Occupants == 0 && entry.Objects.size() == 1)
+    {
+        entry.EmptySince = m_time;
+        m_emptyCells.push_back(key);
+    }
+}
+
+const Vector<entt::entity>& CellRegistry::GetObjects(const CellIdComponent& acCell) const noexcept
+{
+    const auto itor = m_cells.find(GetKey(acCell));
+    return itor != std::end(m_cells) ? itor->second.Objects : s_noObjects;
+}
+
+bool CellRegistry::IsOccupied(const CellIdComponent& acCell) const noexcept
+{
+    const auto itor = m_cells.find(GetKey(acCell));
+    return itor != std::end(m_cells) && itor->second.Occupants > 0;
+}
+
+Vector<entt::entity> CellRegistry::Update(float aDelta) noexcept
+{
+    m_time += aDelta;
+
+    Vector<entt::entity> evicted;
+
+    for (auto keyItor = std::begin(m_emptyCells); keyItor != std::end(m_emptyCells);)
+    {
+        auto itor = m_cells.find(*keyItor);
+
+        // Someone came back or the cell was already dropped
+        if (itor == std::end(m_cells) || itor->second.Occupants > 0)
+        {
+            keyItor = m_emptyCells.erase(keyItor);
+            continue;
+        }
+
+        if (m_time - itor->second.EmptySince < kEvictionDelay)
+        {
+            ++keyItor;
+            continue;
+        }
+
+        auto& objects = itor.value().Objects;
+        evicted.insert(std::end(evicted), std::begin(objects), std::end(objects));
+
+        m_cells.erase(itor);
+        keyItor = m_emptyCells.erase(keyItor);
+    }
+
+    return evicted;
+}
+
+CellKey CellRegistry::GetKey(const CellIdComponent& acCell) noexcept
+{
+    if (acCell.WorldSpaceId == GameId{})
+        return {acCell.Cell, {0, 0}, false};
+
+    return {acCell.WorldSpaceId, acCell.CenterCoords, true};
+}
+
+template<class T>
+void CellRegistry::ForEachCell(const CellIdComponent& acCell, const T& acFunctor) noexcept
+{
+    auto key = GetKey(acCell);
+    if (!key.Exterior)
+    {
+        acFunctor(key);
+        return;
+    }
+
+    const auto center = key.Coords;
+    constexpr int32_t cDistance = GridCellCoords::m_gridsToLoad / 2;
+
+    for (int32_t x = -cDistance; x <= cDistance; ++x)
+    {
+        for (int32_t y = -cDistance; y <= cDistance; ++y)
+        {
+            key.Coords = GridCellCoords(center.X + x, center.Y + y);
+            acFunctor(key);
+        }
+    }
+}
+
+void CellRegistry::Acquire(const CellKey& acKey) noexcept
+{
+    ++m_cells[acKey].Occupants;
+}
+
+void CellRegistry::Release(const CellKey& acKey) noexcept
+{
+    auto itor = m_cells.find(acKey);
+    if (itor == std::end(m_cells) || itor->second.Occupants == 0)
+        return;
+
+    auto& entry = itor.value();
+    if (--entry.Occupants > 0)
+        return;
+
+    if (entry.Objects.empty())
+    {
+        m_cells.erase(itor);
+        return;
+    }
+
+    entry.EmptySince = m_time;
+    m_emptyCells.push_back(acKey);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Structs/GameId.h>
+#include <Structs/GridCellCoords.h>
+
+struct CellIdComponent;
+
+struct CellKey
+{
+    GameId Id{};
+    GridCellCoords Coords{0, 0};
+    bool Exterior{false};
+
+    bool operator==(const CellKey& acRhs) const noexcept
+    {
+        return Exterior == acRhs.Exterior && Id == acRhs.Id && Coords == acRhs.Coords;
+    }
+};
+
+namespace std
+{
+    template <> class hash<CellKey>
+    {
+      public:
+        size_t operator()(const CellKey& acKey) const
+        {
+            const auto coords = (static_cast<size_t>(static_cast<uint32_t>(acKey.Coords.X)) << 1) ^
+                                (static_cast<size_t>(static_cast<uint32_t>(acKey.Coords.Y)) << 17);
+            return hash<GameId>()(acKey.Id) ^ coords ^ static_cast<size_t>(acKey.Exterior);
+        }
+    };
+}
+
+// Tracks which cells players have loaded and the objects living in them.
+// Interior cells are keyed by their cell id, exterior cells by worldspace and cell coordinates. A player in an exterior
+// holds a reference on every cell of the grid around them, which matches what their game has loaded.
+// Once the last player leaves, the cell's objects are kept for a grace period so stepping out and back in doesn't throw
+// their state away only to have it uploaded again.
+struct CellRegistry
+{
+    CellRegistry() noexcept = default;
+    ~CellRegistry() noexcept = default;
+
+    TP_NOCOPYMOVE(CellRegistry);
+
+    // Moves a player's references from one cell to another, empty cell components are ignored
+    void Move(const CellIdComponent& acOldCell, const CellIdComponent& acNewCell) noexcept;
+
+    void AddObject(entt::entity aEntity, const CellIdComponent& acCell) noexcept;
+    [[nodiscard]] const Vector<entt::entity>& GetObjects(const CellIdComponent& acCell) const noexcept;
+    [[nodiscard]] bool IsOccupied(const CellIdComponent& acCell) const noexcept;
+
+    // Returns the objects of cells that stayed empty for the whole grace period, they are no longer tracked
+    [[nodiscard]] Vector<entt::entity> Update(float aDelta) noexcept;
+
+    [[nodiscard]] static CellKey GetKey(const CellIdComponent& acCell) noexcept;
+
+private:
+
+    struct Entry
+    {
+        uint32_t Occupants{0};
+        double EmptySince{0.0};
+        Vector<entt::entity> Objects;
+    };
+
+    template<class T>
+    void ForEachCell(const CellIdComponent& acCell, const T& acFunctor) noexcept;
+
+    void Acquire(const CellKey& acKey) noexcept;
+    void Release(const CellKey& acKey) noexcept;
+
+    Map<CellKey, Entry> m_cells;
+    // Cells whose last occupant left, checked every update until they are evicted or occupied again
+    Vector<CellKey> m_emptyCells;
+    double m_time{0.0};
+};
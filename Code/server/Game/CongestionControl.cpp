@@ -0,0 +1,178 @@
+#include <stdafx.h>
+
+#include <Game/CongestionControl.h>
+#include <GameServer.h>
+
+#include <steam/steamnetworkingsockets.h>
+
+namespace
+{
+    // A connection is congested once it has more than this much data waiting to go out
+    constexpr float kMaxQueueDelay = 0.2f;
+    constexpr uint32_t kMinQueueLimit = 8 * 1024;
+    // Held snapshots still go out this often, movement slows down for congested players but doesn't stop
+    constexpr double kMaxHoldTime = 0.25;
+    // Bulk payloads are reliable, they can't wait forever either
+    constexpr double kMaxBulkHoldTime = 2.0;
+    constexpr uint32_t kMaxHeldBulkBytes = 1 << 20;
+    // Congested connections are logged at most this often
+    constexpr double kLogInterval = 30.0;
+
+    bool HasActions(const ServerReferencesMoveRequest& acMessage) noexcept
+    {
+        return std::any_of(std::begin(acMessage.Updates), std::end(acMessage.Updates),
+                           [](const auto& acEntry) { return !acEntry.second.ActionEvents.empty(); });
+    }
+}
+
+CongestionControl::CongestionControl(GameServer& aServer) noexcept
+    : m_server(aServer)
+{
+}
+
+void CongestionControl::Refresh(ConnectionId_t aConnectionId, Connection& aConnection) const noexcept
+{
+    SteamNetworkingQuickConnectionStatus status{};
+    if (!SteamNetworkingSockets()->GetQuickConnectionStatus(aConnectionId, &status))
+        return;
+
+    auto& stats = aConnection.Statistics;
+    stats.QueuedBytes = static_cast<uint32_t>(std::max(status.m_cbPendingReliable, 0) + std::max(status.m_cbPendingUnreliable, 0));
+    stats.SendRate = static_cast<uint32_t>(std::max(status.m_nSendRateBytesPerSecond, 0));
+    stats.Ping = status.m_nPing;
+
+    const auto cLimit = std::max(static_cast<uint32_t>(static_cast<float>(stats.SendRate) * kMaxQueueDelay), kMinQueueLimit);
+
+    // Leave the congested state only once the queue drained well below the limit so we don't flip every tick
+    if (stats.Congested)
+        stats.Congested = stats.QueuedBytes > cLimit / 2;
+    else
+        stats.Congested = stats.QueuedBytes > cLimit;
+}
+
+void CongestionControl::Update(float aDelta) noexcept
+{
+    m_time += aDelta;
+
+    for (auto itor = std::begin(m_connections); itor != std::end(m_connections); ++itor)
+    {
+        auto& connection = itor.value();
+        if (connection.Held.Updates.empty() && connection.HeldBulk.empty())
+            continue;
+
+        Refresh(itor->first, connection);
+
+        if (!connection.Held.Updates.empty() && (!connection.Statistics.Congested || m_time - connection.HeldSince >= kMaxHoldTime))
+            Flush(itor->first, connection);
+
+        if (!connection.HeldBulk.empty() && (!connection.Statistics.Congested || m_time - connection.HeldBulkSince >= kMaxBulkHoldTime))
+            FlushBulk(itor->first, connection);
+    }
+
+    if (m_time >= m_nextLog)
+    {
+        m_nextLog = m_time + kLogInterval;
+        LogCongestedConnections();
+    }
+}
+
+void CongestionControl::SendMovement(ConnectionId_t aConnectionId, const ServerReferencesMoveRequest& acMessage) noexcept
+{
+    auto& connection = m_connections[aConnectionId];
+    Refresh(aConnectionId, connection);
+
+    auto& held = connection.Held;
+
+    if (!connection.Statistics.Congested && held.Updates.empty())
+    {
+        // Animation actions are events, a lost one isn't fixed by the next snapshot
+        m_server.Send(aConnectionId, acMessage, HasActions(acMessage) ? EDelivery::kReliable : ServerReferencesMoveRequest::Delivery,
+                      ServerReferencesMoveRequest::Lane);
+        return;
+    }
+
+    if (held.Updates.empty())
+        connection.HeldSince = m_time;
+    else
+        ++connection.Statistics.HeldSnapshots;
+
+    held.Tick = acMessage.Tick;
+
+    for (const auto& [serverId, update] : acMessage.Updates)
+    {
+        auto [itor, inserted] = held.Updates.try_emplace(serverId, update);
+        if (inserted)
+            continue;
+
+        // Actions are events, they can't be replaced by the newer ones
+        auto& heldUpdate = itor->second;
+        heldUpdate.UpdatedMovement = update.UpdatedMovement;
+        heldUpdate.ActionEvents.insert(std::end(heldUpdate.ActionEvents), std::begin(update.ActionEvents), std::end(update.ActionEvents));
+
+        ++connection.Statistics.ReplacedUpdates;
+    }
+}
+
+void CongestionControl::Flush(ConnectionId_t aConnectionId, Connection& aConnection) noexcept
+{
+    const auto cDelivery = HasActions(aConnection.Held) ? EDelivery::kReliable : ServerReferencesMoveRequest::Delivery;
+    m_server.Send(aConnectionId, aConnection.Held, cDelivery, ServerReferencesMoveRequest::Lane);
+    aConnection.Held.Updates.clear();
+}
+
+bool CongestionControl::HoldBulk(ConnectionId_t aConnectionId, const uint8_t* apData, size_t aSize) noexcept
+{
+    auto& connection = m_connections[aConnectionId];
+    Refresh(aConnectionId, connection);
+
+    auto& stats = connection.Statistics;
+
+    // Once something waits everything after it has to wait too, bulk messages stay in order
+    if (connection.HeldBulk.empty() && !stats.Congested)
+        return false;
+
+    if (stats.HeldBulkBytes + aSize > kMaxHeldBulkBytes)
+        FlushBulk(aConnectionId, connection);
+
+    if (connection.HeldBulk.empty())
+        connection.HeldBulkSince = m_time;
+
+    connection.HeldBulk.emplace_back(apData, apData + aSize);
+    stats.HeldBulkBytes += static_cast<uint32_t>(aSize);
+
+    return true;
+}
+
+void CongestionControl::FlushBulk(ConnectionId_t aConnectionId, Connection& aConnection) noexcept
+{
+    for (auto& packet : aConnection.HeldBulk)
+        m_server.SendRaw(aConnectionId, packet.data(), packet.size(), EDelivery::kReliable);
+
+    aConnection.HeldBulk.clear();
+    aConnection.Statistics.HeldBulkBytes = 0;
+}
+
+void CongestionControl::Remove(ConnectionId_t aConnectionId) noexcept
+{
+    m_connections.erase(aConnectionId);
+}
+
+const CongestionControl::Stats* CongestionControl::GetStats(ConnectionId_t aConnectionId) const noexcept
+{
+    const auto itor = m_connections.find(aConnectionId);
+    return itor != std::end(m_connections) ? &itor->second.Statistics : nullptr;
+}
+
+void CongestionControl::LogCongestedConnections() const noexcept
+{
+    for (const auto& [connectionId, connection] : m_connections)
+    {
+        const auto& stats = connection.Statistics;
+        if (!stats.Congested)
+            continue;
+
+        spdlog::info("Connection {:x} is congested: {} bytes queued, {} B/s, {} ms, {} updates replaced, {} snapshots held, {} bulk bytes held",
+                     connectionId, stats.QueuedBytes, stats.SendRate, stats.Ping, stats.ReplacedUpdates, stats.HeldSnapshots,
+                     stats.HeldBulkBytes);
+    }
+}
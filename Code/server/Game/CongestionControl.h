@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Messages/ServerReferencesMoveRequest.h>
+
+using TiltedPhoques::ConnectionId_t;
+
+struct GameServer;
+
+// Watches how backed up each connection is, using the transport's queued bytes and send rate estimate.
+// While a connection is congested its movement snapshots are held back and merged: a newer update for an entity
+// replaces the one waiting, so the player catches up on the latest state instead of replaying stale ones. Every
+// other message carries state that can't be rebuilt later, state goes out right away while bulk payloads wait for
+// the connection to drain so they don't delay what the player needs now.
+struct CongestionControl
+{
+    struct Stats
+    {
+        uint32_t QueuedBytes{0};
+        uint32_t SendRate{0};
+        int32_t Ping{0};
+        bool Congested{false};
+        // Entity updates overwritten by a newer one before they could be sent
+        uint64_t ReplacedUpdates{0};
+        // Snapshots merged into a held one instead of being sent
+        uint64_t HeldSnapshots{0};
+        uint32_t HeldBulkBytes{0};
+    };
+
+    explicit CongestionControl(GameServer& aServer) noexcept;
+    ~CongestionControl() noexcept = default;
+
+    TP_NOCOPYMOVE(CongestionControl);
+
+    // Refreshes the connection states and sends the held snapshots that can go out
+    void Update(float aDelta) noexcept;
+    void SendMovement(ConnectionId_t aConnectionId, const ServerReferencesMoveRequest& acMessage) noexcept;
+    // Keeps a copy of a serialized bulk packet if it has to wait, returns false if it can be sent right away
+    [[nodiscard]] bool HoldBulk(ConnectionId_t aConnectionId, const uint8_t* apData, size_t aSize) noexcept;
+    void Remove(ConnectionId_t aConnectionId) noexcept;
+
+    [[nodiscard]] const Stats* GetStats(ConnectionId_t aConnectionId) const noexcept;
+
+private:
+
+    struct Connection
+    {
+        Stats Statistics;
+        ServerReferencesMoveRequest Held;
+        double HeldSince{0.0};
+        Vector<Vector<uint8_t>> HeldBulk;
+        double HeldBulkSince{0.0};
+    };
+
+    void Refresh(ConnectionId_t aConnectionId, Connection& aConnection) const noexcept;
+    void Flush(ConnectionId_t aConnectionId, Connection& aConnection) noexcept;
+    void FlushBulk(ConnectionId_t aConnectionId, Connection& aConnection) noexcept;
+    void LogCongestedConnections() const noexcept;
+
+    GameServer& m_server;
+    double m_time{0.0};
+    double m_nextLog{0.0};
+    Map<ConnectionId_t, Connection> m_connections;
+};
@@ -0,0 +1,119 @@
+#include <stdafx.h>
+
+#include <Game/DormantCharacterStore.h>
+#include <Components.h>
+#include <World.h>
+
+#include <MessageStream.h>
+
+#include <TiltedCore/ViewBuffer.hpp>
+
+namespace
+{
+    constexpr double kDormantLifetime = 300.0;
+    constexpr size_t kMaxDormantCharacters = 4096;
+    // A dormant character is only worth keeping if it is cheaper than the client uploading it again
+    constexpr size_t kMaxDormantSize = 1 << 16;
+}
+
+bool DormantCharacterStore::Store(const World& acWorld, entt::entity aEntity) noexcept
+{
+    const auto* pFormIdComponent = acWorld.try_get<FormIdComponent>(aEntity);
+    const auto* pCharacterComponent = acWorld.try_get<CharacterComponent>(aEntity);
+    if (!pFormIdComponent || !pCharacterComponent)
+        return false;
+
+    if (m_characters.size() >= kMaxDormantCharacters && !Contains(pFormIdComponent->Id))
+        return false;
+
+    const auto cSerialize = [&acWorld, aEntity](Buffer::Writer& aWriter) { Write(acWorld, aEntity, aWriter); };
+
+    Vector<uint8_t> data;
+    if (!MessageStream::Serialize(data, cSerialize) || data.size() > kMaxDormantSize)
+        return false;
+
+    auto& entry = m_characters[pFormIdComponent->Id];
+    entry.Data = std::move(data);
+    entry.ExpiresAt = m_time + kDormantLifetime;
+
+    return true;
+}
+
+void DormantCharacterStore::Write(const World& acWorld, entt::entity aEntity, Buffer::Writer& aWriter) noexcept
+{
+    const auto& characterComponent = acWorld.get<CharacterComponent>(aEntity);
+
+    aWriter.WriteBits(characterComponent.ChangeFlags, 32);
+    Serialization::WriteString(aWriter, characterComponent.SaveBuffer);
+    characterComponent.BaseId.Id.Serialize(aWriter);
+    characterComponent.FaceTints.Serialize(aWriter);
+    characterComponent.FactionsContent.Serialize(aWriter);
+    Serialization::WriteBool(aWriter, characterComponent.IsDead);
+
+    const auto* pInventoryComponent = acWorld.try_get<InventoryComponent>(aEntity);
+    Serialization::WriteBool(aWriter, pInventoryComponent != nullptr);
+    if (pInventoryComponent)
+        pInventoryComponent->Content.Serialize(aWriter);
+
+    const auto* pActorValuesComponent = acWorld.try_get<ActorValuesComponent>(aEntity);
+    Serialization::WriteBool(aWriter, pActorValuesComponent != nullptr);
+    if (pActorValuesComponent)
+        pActorValuesComponent->CurrentActorValues.Serialize(aWriter);
+}
+
+bool DormantCharacterStore::Restore(World& aWorld, entt::entity aEntity, const GameId& acId) noexcept
+{
+    const auto itor = m_characters.find(acId);
+    if (itor == std::end(m_characters))
+        return false;
+
+    auto& data = itor.value().Data;
+    TiltedPhoques::ViewBuffer buffer(data.data(), data.size());
+    Buffer::Reader reader(&buffer);
+
+    auto& characterComponent = aWorld.emplace_or_replace<CharacterComponent>(aEntity);
+
+    uint64_t changeFlags = 0;
+    reader.ReadBits(changeFlags, 32);
+    characterComponent.ChangeFlags = changeFlags & 0xFFFFFFFF;
+    characterComponent.SaveBuffer = Serialization::ReadString(reader);
+    characterComponent.BaseId.Id.Deserialize(reader);
+    characterComponent.FaceTints.Deserialize(reader);
+    characterComponent.FactionsContent.Deserialize(reader);
+    characterComponent.IsDead = Serialization::ReadBool(reader);
+
+    auto& inventoryComponent = aWorld.emplace_or_replace<InventoryComponent>(aEntity);
+    if (Serialization::ReadBool(reader))
+        inventoryComponent.Content.Deserialize(reader);
+
+    auto& actorValuesComponent = aWorld.emplace_or_replace<ActorValuesComponent>(aEntity);
+    if (Serialization::ReadBool(reader))
+        actorValuesComponent.CurrentActorValues.Deserialize(reader);
+
+    m_characters.erase(itor);
+
+    return true;
+}
+
+void DormantCharacterStore::Remove(const GameId& acId) noexcept
+{
+    m_characters.erase(acId);
+}
+
+bool DormantCharacterStore::Contains(const GameId& acId) const noexcept
+{
+    return m_characters.find(acId) != std::end(m_characters);
+}
+
+void DormantCharacterStore::Update(float aDelta) noexcept
+{
+    m_time += aDelta;
+
+    for (auto itor = std::begin(m_characters); itor != std::end(m_characters);)
+    {
+        if (itor->second.ExpiresAt <= m_time)
+            itor = m_characters.erase(itor);
+        else
+            ++itor;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Structs/GameId.h>
+
+struct World;
+
+// Characters nobody can own are packed here instead of being thrown away, so the next player entering the cell can
+// take them over with a brief assignment request instead of uploading their whole state again.
+// Only references from the game's data are kept, custom and temporary forms can't be matched again.
+struct DormantCharacterStore
+{
+    DormantCharacterStore() noexcept = default;
+    ~DormantCharacterStore() noexcept = default;
+
+    TP_NOCOPYMOVE(DormantCharacterStore);
+
+    // Packs the character's persistent state, returns false if it can't be kept
+    bool Store(const World& acWorld, entt::entity aEntity) noexcept;
+    // Adds the stored state to an entity that has its form id, returns false if nothing is stored for that id
+    bool Restore(World& aWorld, entt::entity aEntity, const GameId& acId) noexcept;
+
+    // Drops the stored state, for when a client uploads the character again
+    void Remove(const GameId& acId) noexcept;
+
+    [[nodiscard]] bool Contains(const GameId& acId) const noexcept;
+    [[nodiscard]] size_t Size() const noexcept { return m_characters.size(); }
+
+    void Update(float aDelta) noexcept;
+
+private:
+
+    static void Write(const World& acWorld, entt::entity aEntity, TiltedPhoques::Buffer::Writer& aWriter) noexcept;
+
+    struct Entry
+    {
+        Vector<uint8_t> Data;
+        double ExpiresAt;
+    };
+
+    Map<GameId, Entry> m_characters;
+    double m_time{0.0};
+};
@@ -1 +0,0 @@
-#include "Map.h"
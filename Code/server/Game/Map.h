@@ -1,6 +0,0 @@
-#pragma once
-
-struct Map
-{
-
-};
@@ -0,0 +1,116 @@
+#include <stdafx.h>
+
+#include <Game/MessageStreams.h>
+#include <GameServer.h>
+
+namespace
+{
+    constexpr double kLogInterval = 30.0;
+}
+
+MessageStreams::MessageStreams(GameServer& aServer) noexcept
+    : m_server(aServer)
+{
+}
+
+void MessageStreams::Update(float aDelta) noexcept
+{
+    m_time += aDelta;
+
+    for (auto itor = std::begin(m_connections); itor != std::end(m_connections); ++itor)
+    {
+        auto& writer = itor.value().Writer;
+        if (writer.IsIdle())
+            continue;
+
+        const auto cConnectionId = itor->first;
+        writer.Update(aDelta, m_rate, [this, cConnectionId](const uint8_t* apPacket, size_t aSize) {
+            m_server.SendRaw(cConnectionId, apPacket, aSize, EDelivery::kReliable);
+        });
+    }
+
+    if (m_time >= m_nextLog)
+    {
+        m_nextLog = m_time + kLogInterval;
+        LogStreams();
+    }
+}
+
+bool MessageStreams::Queue(ConnectionId_t aConnectionId, const uint8_t* apPacket, size_t aSize) noexcept
+{
+    const auto itor = m_connections.find(aConnectionId);
+    if (itor == std::end(m_connections) && aSize <= MessageStream::kChunkSize)
+        return false;
+
+    auto& writer = itor != std::end(m_connections) ? itor.value().Writer : m_connections[aConnectionId].Writer;
+    const bool cWasIdle = writer.IsIdle();
+
+    if (!writer.Queue(apPacket, aSize))
+        return false;
+
+    if (aSize > MessageStream::kChunkSize)
+        spdlog::debug("Streaming a {} bytes message to {:x}{}", aSize - 1, aConnectionId, cWasIdle ? "" : " behind another one");
+
+    return true;
+}
+
+const Vector<uint8_t>* MessageStreams::Receive(ConnectionId_t aConnectionId, const MessageChunk& acChunk) noexcept
+{
+    auto& reader = m_connections[aConnectionId].Reader;
+
+    switch (reader.Add(acChunk))
+    {
+    case MessageStreamReader::EResult::kComplete:
+        return &reader.GetMessage();
+    case MessageStreamReader::EResult::kInvalid:
+        spdlog::warn("Dropped an invalid message stream from {:x}", aConnectionId);
+        break;
+    default:
+        break;
+    }
+
+    return nullptr;
+}
+
+void MessageStreams::Remove(ConnectionId_t aConnectionId) noexcept
+{
+    m_connections.erase(aConnectionId);
+}
+
+bool MessageStreams::IsStreaming(ConnectionId_t aConnectionId) const noexcept
+{
+    const auto itor = m_connections.find(aConnectionId);
+    return itor != std::end(m_connections) && !itor->second.Writer.IsIdle();
+}
+
+MessageStreams::Stats MessageStreams::GetStats(ConnectionId_t aConnectionId) const noexcept
+{
+    Stats stats;
+
+    const auto itor = m_connections.find(aConnectionId);
+    if (itor == std::end(m_connections))
+        return stats;
+
+    const auto& connection = itor->second;
+    stats.Outgoing = connection.Writer.GetStats();
+    stats.OutgoingProgress = connection.Writer.GetProgress();
+    stats.ReceivedMessages = connection.Reader.GetReceivedMessages();
+    stats.ReceivedBytes = connection.Reader.GetReceivedBytes();
+    stats.ReceivingSize = connection.Reader.GetTotalSize();
+
+    return stats;
+}
+
+void MessageStreams::LogStreams() const noexcept
+{
+    for (const auto& [connectionId, connection] : m_connections)
+    {
+        const auto& writer = connection.Writer;
+        if (writer.IsIdle())
+            continue;
+
+        spdlog::info("Connection {:x} is streaming: {:.0f}% of the current message, {} bytes queued, {} bytes and {} messages sent",
+                     connectionId, writer.GetProgress() * 100.f, writer.GetStats().QueuedBytes, writer.GetStats().SentBytes,
+                     writer.GetStats().SentMessages);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <MessageStream.h>
+#include <Messages/NotifyMessageChunk.h>
+
+using TiltedPhoques::ConnectionId_t;
+
+struct GameServer;
+
+// Large messages streamed to and from each connection, see MessageStream.h for how they are split.
+struct MessageStreams
+{
+    struct Stats
+    {
+        MessageStreamWriter<NotifyMessageChunk>::Stats Outgoing;
+        float OutgoingProgress{0.f};
+        uint64_t ReceivedMessages{0};
+        uint32_t ReceivedBytes{0};
+        uint32_t ReceivingSize{0};
+    };
+
+    explicit MessageStreams(GameServer& aServer) noexcept;
+    ~MessageStreams() noexcept = default;
+
+    TP_NOCOPYMOVE(MessageStreams);
+
+    void SetRate(uint32_t aBytesPerSecond) noexcept { m_rate = aBytesPerSecond; }
+    // Sends the chunks the rate allows for each connection
+    void Update(float aDelta) noexcept;
+    // Takes a serialized reliable packet if it is too large or has to wait behind a stream, returns false if it can be sent right away
+    [[nodiscard]] bool Queue(ConnectionId_t aConnectionId, const uint8_t* apPacket, size_t aSize) noexcept;
+    // Returns the reassembled message once its last chunk arrived, null otherwise
+    [[nodiscard]] const Vector<uint8_t>* Receive(ConnectionId_t aConnectionId, const MessageChunk& acChunk) noexcept;
+    void Remove(ConnectionId_t aConnectionId) noexcept;
+
+    [[nodiscard]] bool IsStreaming(ConnectionId_t aConnectionId) const noexcept;
+
+    [[nodiscard]] Stats GetStats(ConnectionId_t aConnectionId) const noexcept;
+
+private:
+
+    struct Connection
+    {
+        MessageStreamWriter<NotifyMessageChunk> Writer;
+        MessageStreamReader Reader;
+    };
+
+    void LogStreams() const noexcept;
+
+    GameServer& m_server;
+    uint32_t m_rate{512 * 1024};
+    double m_time{0.0};
+    double m_nextLog{0.0};
+    Map<ConnectionId_t, Connection> m_connections;
+};
@@ -1,26 +1,27 @@
 #pragma once
 
+// Iterates the entities owned by a player that also have all the requested components.
+// Walks the player's own entity list instead of every owned entity in the world, find is a couple of lookups.
 template<class... T>
 struct OwnerView
 {
     using TView = entt::basic_view<entt::entity, entt::exclude_t<>, OwnerComponent, T...>;
+    using TEntities = Vector<entt::entity>;
 
     struct iterator
     {
-        iterator(Player* apPlayer, typename TView::iterator aItor, typename TView::iterator aEnd, const TView& aView) 
-            : m_pPlayer{apPlayer}
-            , m_itor{aItor}
+        iterator(typename TEntities::const_iterator aItor, typename TEntities::const_iterator aEnd, const TView& aView)
+            : m_itor{aItor}
             , m_end{aEnd}
             , m_view{aView}
         {
+            SkipInvalid();
         }
 
         iterator& operator++()
         {
-            do
-            {
-                m_itor++;
-            } while (m_itor != m_end && m_view.template get<OwnerComponent>(*m_itor).GetOwner() != m_pPlayer);
+            ++m_itor;
+            SkipInvalid();
 
             return *this;
         }
@@ -35,9 +36,9 @@ struct OwnerView
             return m_itor == acRhs.m_itor;
         }
 
-        decltype(auto) operator*()
+        [[nodiscard]] decltype(auto) operator*() const
         {
-            return m_itor.operator*();
+            return *m_itor;
         }
 
         [[nodiscard]] decltype(auto) operator->() const
@@ -45,15 +46,16 @@ struct OwnerView
             return m_itor.operator->();
         }
 
-        [[nodiscard]] decltype(auto) operator*() const
+      private:
+
+        void SkipInvalid()
         {
-            return m_itor.operator*();
+            while (m_itor != m_end && !m_view.contains(*m_itor))
+                ++m_itor;
         }
 
-      private:
-        Player* m_pPlayer;
-        typename TView::iterator m_itor;
-        typename TView::iterator m_end;
+        typename TEntities::const_iterator m_itor;
+        typename TEntities::const_iterator m_end;
         const TView& m_view;
     };
 
@@ -61,10 +63,10 @@ struct OwnerView
     decltype(auto) begin() const;
     decltype(auto) end() const;
 
-    template<class... Components> 
+    template<class... Components>
     decltype(auto) get(entt::entity aEntity);
 
-    template<class... Components> 
+    template<class... Components>
     decltype(auto) get(entt::entity aEntity) const;
 
     OwnerView(entt::registry& aRegistry, Player* apPlayer);
@@ -76,44 +78,49 @@ private:
 };
 
 
-template <class... T> 
-OwnerView<T...>::OwnerView(entt::registry& aRegistry, Player* apPlayer) 
+template <class... T>
+OwnerView<T...>::OwnerView(entt::registry& aRegistry, Player* apPlayer)
     : m_view(aRegistry.view<OwnerComponent, T...>())
     , m_pPlayer(apPlayer)
 {
 }
 
-template <class... T> 
+template <class... T>
 decltype(auto) OwnerView<T...>::find(entt::entity aEntity) const
 {
-    auto it = m_view.find(aEntity);
-    if (m_view.template get<OwnerComponent>(*it).GetOwner() == m_pPlayer)
-        return iterator(m_pPlayer, it, std::end(m_view), m_view);
+    const auto& entities = m_pPlayer->GetOwnedEntities();
+
+    // Reject anything that isn't ours without touching the list
+    if (!m_view.contains(aEntity) || m_view.template get<OwnerComponent>(aEntity).GetOwner() != m_pPlayer)
+        return end();
 
-    return end();
+    const auto cIndex = m_pPlayer->GetOwnedIndex(aEntity);
+    return iterator(std::begin(entities) + cIndex, std::end(entities), m_view);
 }
 
-template <class... T> 
+template <class... T>
 decltype(auto) OwnerView<T...>::begin() const
 {
-    return iterator(m_pPlayer, std::begin(m_view), std::end(m_view), m_view);
+    const auto& entities = m_pPlayer->GetOwnedEntities();
+    return iterator(std::begin(entities), std::end(entities), m_view);
 }
 
-template <class... T> 
+template <class... T>
 decltype(auto) OwnerView<T...>::end() const
 {
-    return iterator(m_pPlayer, std::end(m_view), std::end(m_view), m_view);
+    const auto& entities = m_pPlayer->GetOwnedEntities();
+    return iterator(std::end(entities), std::end(entities), m_view);
 }
 
-template <class... T> 
-template <class... Components> 
+template <class... T>
+template <class... Components>
 decltype(auto) OwnerView<T...>::get(entt::entity aEntity)
 {
     return m_view.template get<Components...>(aEntity);
 }
 
-template <class... T> 
-template <class... Components> 
+template <class... T>
+template <class... Components>
 decltype(auto) OwnerView<T...>::get(entt::entity aEntity) const
 {
     return m_view.template get<Components...>(aEntity);
@@ -0,0 +1,182 @@
+#include <stdafx.h>
+
+#include <Game/OwnershipBalancer.h>
+#include <Components.h>
+#include <World.h>
+
+namespace
+{
+    constexpr double kRebalanceInterval = 5.0;
+    constexpr double kTransferCooldown = 30.0;
+    constexpr uint32_t kMaxTransfersPerPass = 8;
+
+    // One owned entity costs 1, everything else is expressed relative to that
+    constexpr float kFrameTimeTarget = 16667.f;
+    constexpr float kFrameTimeCost = 1.f / 2000.f;
+    constexpr float kDistanceCost = 1.f / 4096.f;
+    constexpr float kMaxDistanceCost = 4.f;
+
+    // How much cheaper the new owner must be before an entity is moved
+    constexpr float kHysteresis = 3.f;
+
+    template<class T>
+    uint32_t GetCount(const T& acCounts, const Player* apPlayer) noexcept
+    {
+        const auto itor = acCounts.find(apPlayer);
+        return itor != std::end(acCounts) ? itor->second : 0;
+    }
+}
+
+OwnershipBalancer::OwnershipBalancer(World& aWorld) noexcept
+    : m_world(aWorld)
+{
+}
+
+Player* OwnershipBalancer::SelectOwner(entt::entity aEntity) noexcept
+{
+    const auto& ownerComponent = m_world.get<OwnerComponent>(aEntity);
+    const auto& cellIdComponent = m_world.get<CellIdComponent>(aEntity);
+
+    const auto counts = CountOwned();
+
+    Player* pBest = nullptr;
+    float bestCost = std::numeric_limits<float>::max();
+
+    for (auto pPlayer : m_world.GetPlayerManager())
+    {
+        if (ownerComponent.GetOwner() == pPlayer || !IsEligible(pPlayer, ownerComponent, cellIdComponent))
+            continue;
+
+        const auto cost = GetCost(pPlayer, GetCount(counts, pPlayer) + 1, aEntity);
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            pBest = pPlayer;
+        }
+    }
+
+    if (pBest)
+        m_lastTransfers[aEntity] = m_time;
+
+    return pBest;
+}
+
+Vector<OwnershipBalancer::Transfer> OwnershipBalancer::Update(float aDelta) noexcept
+{
+    m_time += aDelta;
+
+    Vector<Transfer> transfers;
+
+    if (m_time < m_nextRebalance)
+        return transfers;
+
+    m_nextRebalance = m_time + kRebalanceInterval;
+
+    for (auto itor = std::begin(m_lastTransfers); itor != std::end(m_lastTransfers);)
+    {
+        if (m_time - itor->second >= kTransferCooldown)
+            itor = m_lastTransfers.erase(itor);
+        else
+            ++itor;
+    }
+
+    auto counts = CountOwned();
+
+    const auto view = m_world.view<OwnerComponent, CharacterComponent, CellIdComponent>();
+    for (auto entity : view)
+    {
+        if (transfers.size() >= kMaxTransfersPerPass)
+            break;
+
+        const auto& ownerComponent = view.get<OwnerComponent>(entity);
+        auto* pOwner = ownerComponent.GetOwner();
+
+        // A hand off is already in flight, or this is a player's own character
+        if (!pOwner || !ownerComponent.InvalidOwners.empty() || pOwner->GetCharacter() == entity)
+            continue;
+
+        if (m_lastTransfers.find(entity) != std::end(m_lastTransfers))
+            continue;
+
+        const auto& cellIdComponent = view.get<CellIdComponent>(entity);
+
+        const auto currentCost = GetCost(pOwner, GetCount(counts, pOwner), entity);
+
+        Player* pBest = nullptr;
+        float bestCost = currentCost - kHysteresis;
+
+        for (auto pPlayer : m_world.GetPlayerManager())
+        {
+            if (pPlayer == pOwner || !IsEligible(pPlayer, ownerComponent, cellIdComponent))
+                continue;
+
+            const auto cost = GetCost(pPlayer, GetCount(counts, pPlayer) + 1, entity);
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                pBest = pPlayer;
+            }
+        }
+
+        if (!pBest)
+            continue;
+
+        // Keep the counts current so the rest of the pass doesn't pile everything on the same player
+        --counts[pOwner];
+        ++counts[pBest];
+
+        m_lastTransfers[entity] = m_time;
+        transfers.push_back({entity, pOwner, pBest});
+    }
+
+    return transfers;
+}
+
+bool OwnershipBalancer::IsEligible(const Player* apPlayer, const OwnerComponent& acOwnerComponent, const CellIdComponent& acCellIdComponent) noexcept
+{
+    for (const auto pInvalidOwner : acOwnerComponent.InvalidOwners)
+    {
+        if (pInvalidOwner == apPlayer)
+            return false;
+    }
+
+    const auto& playerCell = apPlayer->GetCellComponent();
+    if (playerCell.WorldSpaceId == GameId{})
+        return playerCell.Cell == acCellIdComponent.Cell;
+
+    return GridCellCoords::IsCellInGridCell(acCellIdComponent.CenterCoords, playerCell.CenterCoords);
+}
+
+float OwnershipBalancer::GetCost(const Player* apPlayer, uint32_t aOwnedCount, entt::entity aEntity) const noexcept
+{
+    float cost = static_cast<float>(aOwnedCount);
+
+    const auto frameTime = static_cast<float>(apPlayer->GetFrameTime());
+    if (frameTime > kFrameTimeTarget)
+        cost += (frameTime - kFrameTimeTarget) * kFrameTimeCost;
+
+    const auto character = apPlayer->GetCharacter();
+    if (character && character != aEntity)
+    {
+        const auto* pPlayerMovement = m_world.try_get<MovementComponent>(*character);
+        const auto* pEntityMovement = m_world.try_get<MovementComponent>(aEntity);
+
+        if (pPlayerMovement && pEntityMovement)
+        {
+            const auto distance = glm::distance(pPlayerMovement->Position, pEntityMovement->Position);
+            cost += std::min(distance * kDistanceCost, kMaxDistanceCost);
+        }
+    }
+
+    return cost;
+}
+
+OwnershipBalancer::TOwnedCounts OwnershipBalancer::CountOwned() const noexcept
+{
+    TOwnedCounts counts;
+
+    for (auto pPlayer : m_world.GetPlayerManager())
+        counts[pPlayer] = static_cast<uint32_t>(pPlayer->GetOwnedEntities().size());
+
+    return counts;
+}
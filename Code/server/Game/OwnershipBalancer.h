@@ -0,0 +1,45 @@
+#pragma once
+
+struct World;
+struct Player;
+struct OwnerComponent;
+struct CellIdComponent;
+
+// Decides which player simulates an NPC. The cost of a player grows with the number of entities they already own,
+// the frame time their client reports and the distance between their character and the NPC. Periodic rebalancing
+// only moves an NPC when the new owner is cheaper by a margin, so players walking along a grid cell boundary don't
+// make ownership bounce back and forth.
+struct OwnershipBalancer
+{
+    struct Transfer
+    {
+        entt::entity Entity;
+        Player* pFrom;
+        Player* pTo;
+    };
+
+    explicit OwnershipBalancer(World& aWorld) noexcept;
+    ~OwnershipBalancer() noexcept = default;
+
+    TP_NOCOPYMOVE(OwnershipBalancer);
+
+    // Cheapest player able to take an entity its owner gave up, nullptr if nobody can
+    [[nodiscard]] Player* SelectOwner(entt::entity aEntity) noexcept;
+
+    // Returns the transfers the caller should apply, empty between rebalance passes
+    [[nodiscard]] Vector<Transfer> Update(float aDelta) noexcept;
+
+private:
+
+    using TOwnedCounts = Map<const Player*, uint32_t>;
+
+    [[nodiscard]] static bool IsEligible(const Player* apPlayer, const OwnerComponent& acOwnerComponent, const CellIdComponent& acCellIdComponent) noexcept;
+    [[nodiscard]] float GetCost(const Player* apPlayer, uint32_t aOwnedCount, entt::entity aEntity) const noexcept;
+    [[nodiscard]] TOwnedCounts CountOwned() const noexcept;
+
+    World& m_world;
+    double m_time{0.0};
+    double m_nextRebalance{0.0};
+    // Time at which an entity moved last, entities that just moved are left alone for a while
+    Map<entt::entity, double> m_lastTransfers;
+};
@@ -22,7 +22,10 @@ Player::Player(Player&& aRhs) noexcept
     , m_character{std::exchange(aRhs.m_character, std::nullopt)}
     , m_mods{std::exchange(aRhs.m_mods, {})}
     , m_modIds{std::exchange(aRhs.m_modIds, {})}
+    , m_ownedEntities{std::exchange(aRhs.m_ownedEntities, {})}
+    , m_ownedIndices{std::exchange(aRhs.m_ownedIndices, {})}
     , m_discordId{std::exchange(aRhs.m_discordId, 0)}
+    , m_frameTime{std::exchange(aRhs.m_frameTime, 0)}
     , m_endpoint{std::exchange(aRhs.m_endpoint, {})}
     , m_username{std::exchange(aRhs.m_username, {})}
     , m_party{std::exchange(aRhs.m_party, {})}
@@ -81,6 +84,43 @@ void Player::SetCharacter(entt::entity aCharacter) noexcept
     m_character = aCharacter;
 }
 
+void Player::SetFrameTime(uint32_t aFrameTime) noexcept
+{
+    m_frameTime = aFrameTime;
+}
+
+size_t Player::GetOwnedIndex(entt::entity aEntity) const noexcept
+{
+    const auto itor = m_ownedIndices.find(aEntity);
+    return itor != std::end(m_ownedIndices) ? itor->second : m_ownedEntities.size();
+}
+
+void Player::AddOwnedEntity(entt::entity aEntity) noexcept
+{
+    if (!m_ownedIndices.emplace(aEntity, m_ownedEntities.size()).second)
+        return;
+
+    m_ownedEntities.push_back(aEntity);
+}
+
+void Player::RemoveOwnedEntity(entt::entity aEntity) noexcept
+{
+    // Order doesn't matter, swap with the last one so removal doesn't shift the whole list
+    const auto itor = m_ownedIndices.find(aEntity);
+    if (itor == std::end(m_ownedIndices))
+        return;
+
+    const auto cIndex = itor->second;
+    m_ownedIndices.erase(itor);
+
+    const auto cLast = m_ownedEntities.back();
+    m_ownedEntities[cIndex] = cLast;
+    m_ownedEntities.pop_back();
+
+    if (cLast != aEntity)
+        m_ownedIndices[cLast] = cIndex;
+}
+
 void Player::SetCellComponent(const CellIdComponent& aCellComponent) noexcept
 {
     m_cell = aCellComponent;
@@ -90,3 +130,8 @@ void Player::Send(const ServerMessage& acServerMessage) const
 {
     GameServer::Get()->Send(GetConnectionId(), acServerMessage);
 }
+
+void Player::SendMovement(const ServerReferencesMoveRequest& acMessage) const
+{
+    GameServer::Get()->SendMovement(GetConnectionId(), acMessage);
+}
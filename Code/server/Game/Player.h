@@ -3,6 +3,7 @@
 #include <Components.h>
 
 struct ServerMessage;
+struct ServerReferencesMoveRequest;
 struct Player
 {
     Player(ConnectionId_t aConnectionId);
@@ -19,6 +20,14 @@ struct Player
     [[nodiscard]]std::optional<entt::entity> GetCharacter() const noexcept { return m_character; }
     [[nodiscard]] PartyComponent& GetParty() noexcept { return m_party; }
     [[nodiscard]] const String& GetUsername() const noexcept { return m_username; }
+    [[nodiscard]] const String& GetEndpoint() const noexcept { return m_endpoint; }
+    [[nodiscard]] uint64_t GetDiscordId() const noexcept { return m_discordId; }
+    [[nodiscard]] const Vector<String>& GetMods() const noexcept { return m_mods; }
+    [[nodiscard]] const Vector<uint16_t>& GetModIds() const noexcept { return m_modIds; }
+    [[nodiscard]] uint32_t GetFrameTime() const noexcept { return m_frameTime; }
+    [[nodiscard]] const Vector<entt::entity>& GetOwnedEntities() const noexcept { return m_ownedEntities; }
+    // Position in GetOwnedEntities, the size of the list when the entity isn't owned by this player
+    [[nodiscard]] size_t GetOwnedIndex(entt::entity aEntity) const noexcept;
 
     [[nodiscard]] CellIdComponent& GetCellComponent() noexcept;
     [[nodiscard]] const CellIdComponent& GetCellComponent() const noexcept;
@@ -31,10 +40,16 @@ struct Player
     void SetMods(Vector<String> aMods) noexcept;
     void SetModIds(Vector<uint16_t> aModIds) noexcept;
     void SetCharacter(entt::entity aCharacter) noexcept;
+    void SetFrameTime(uint32_t aFrameTime) noexcept;
+
+    // Only OwnerComponent and the registry hooks should call these, they keep the list in sync with the owner
+    void AddOwnedEntity(entt::entity aEntity) noexcept;
+    void RemoveOwnedEntity(entt::entity aEntity) noexcept;
 
     void SetCellComponent(const CellIdComponent& aCellComponent) noexcept;
 
     void Send(const ServerMessage& acServerMessage) const;
+    void SendMovement(const ServerReferencesMoveRequest& acMessage) const;
 
 private:
 
@@ -43,7 +58,10 @@ private:
     std::optional<entt::entity> m_character;
     Vector<String> m_mods;
     Vector<uint16_t> m_modIds;
+    Vector<entt::entity> m_ownedEntities;
+    Map<entt::entity, size_t> m_ownedIndices;
     uint64_t m_discordId{0};
+    uint32_t m_frameTime{0};
     String m_endpoint;
     String m_username;
     PartyComponent m_party;
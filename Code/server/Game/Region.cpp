@@ -1 +1,20 @@
-#include "Region.h"
+#include <stdafx.h>
+
+#include <Game/Region.h>
+#include <Components.h>
+
+Region::Region(const CellIdComponent& acPlayerCell) noexcept
+    : m_cell(acPlayerCell.Cell)
+    , m_worldSpaceId(acPlayerCell.WorldSpaceId)
+    , m_centerCoords(acPlayerCell.CenterCoords)
+    , m_exterior(acPlayerCell.WorldSpaceId != GameId{})
+{
+}
+
+bool Region::Contains(const CellIdComponent& acCell) const noexcept
+{
+    if (!m_exterior)
+        return m_cell != GameId{} && acCell.Cell == m_cell;
+
+    return acCell.WorldSpaceId == m_worldSpaceId && GridCellCoords::IsCellInGridCell(acCell.CenterCoords, m_centerCoords);
+}
@@ -1,12 +1,23 @@
 #pragma once
 
-struct Cell;
+#include <Structs/GameId.h>
+#include <Structs/GridCellCoords.h>
 
+struct CellIdComponent;
+
+// Area a player has loaded, the grid around them outside or a single cell when inside
 struct Region
 {
+    Region() noexcept = default;
+    explicit Region(const CellIdComponent& acPlayerCell) noexcept;
 
+    [[nodiscard]] bool Contains(const CellIdComponent& acCell) const noexcept;
+    [[nodiscard]] bool IsExterior() const noexcept { return m_exterior; }
 
 private:
 
-    //Map<glm::ivec2, Cell> m_cells;
+    GameId m_cell{};
+    GameId m_worldSpaceId{};
+    GridCellCoords m_centerCoords{};
+    bool m_exterior{false};
 };
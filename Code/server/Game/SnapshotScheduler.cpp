@@ -0,0 +1,213 @@
+#include <stdafx.h>
+
+#include <Game/SnapshotScheduler.h>
+#include <Game/Player.h>
+
+#include <World.h>
+#include <Components.h>
+
+#include <Messages/ServerReferencesMoveRequest.h>
+#include <MessageStream.h>
+#include <TiltedCore/Serialization.hpp>
+
+namespace
+{
+    constexpr uint32_t kDefaultBudget = 64 * 1024;
+    // Unused budget carries over up to this many seconds worth
+    constexpr float kMaxBurst = 0.25f;
+    constexpr float kPlayerWeight = 4.f;
+    constexpr float kNpcWeight = 1.f;
+    // Distance at which an entity gains priority half as fast, about half a cell
+    constexpr float kDistanceFalloff = 2048.f;
+}
+
+SnapshotScheduler::SnapshotScheduler(World& aWorld) noexcept
+    : m_world(aWorld)
+    , m_bytesPerSecond(kDefaultBudget)
+    // Updates carry every action queued while they waited, anything up to what can be sent at all has to be measured
+    , m_scratch(MessageStream::kMaxMessageSize)
+{
+}
+
+void SnapshotScheduler::SetBudget(uint32_t aBytesPerSecond) noexcept
+{
+    // Anything lower couldn't even fit a single update within the burst
+    m_bytesPerSecond = std::max(aBytesPerSecond, 1024u);
+}
+
+const SnapshotScheduler::Baseline& SnapshotScheduler::GetBaseline(const Player& acPlayer, entt::entity aEntity) noexcept
+{
+    return m_clients[acPlayer.GetId()].Entries[aEntity].Sent;
+}
+
+void SnapshotScheduler::Queue(const Player& acPlayer, entt::entity aEntity, const Vector<ActionEvent>& acActions) noexcept
+{
+    auto& entry = m_clients[acPlayer.GetId()].Entries[aEntity];
+    entry.Pending = true;
+    entry.Actions.insert(std::end(entry.Actions), std::begin(acActions), std::end(acActions));
+}
+
+float SnapshotScheduler::GetWeight(const Player& acPlayer, entt::entity aEntity) const noexcept
+{
+    const auto* pOwner = m_world.get<OwnerComponent>(aEntity).GetOwner();
+    const bool isPlayer = pOwner && pOwner->GetCharacter() == aEntity;
+
+    auto weight = isPlayer ? kPlayerWeight : kNpcWeight;
+
+    const auto character = acPlayer.GetCharacter();
+    if (const auto* pPlayerMovement = character ? m_world.try_get<MovementComponent>(*character) : nullptr)
+    {
+        const auto& movement = m_world.get<MovementComponent>(aEntity);
+        weight /= 1.f + glm::distance(pPlayerMovement->Position, movement.Position) / kDistanceFalloff;
+    }
+
+    return weight;
+}
+
+void SnapshotScheduler::Schedule(const Player& acPlayer, float aDelta, ServerReferencesMoveRequest& aMessage) noexcept
+{
+    auto& client = m_clients[acPlayer.GetId()];
+    client.Seen = true;
+
+    const auto cRate = static_cast<float>(m_bytesPerSecond);
+    client.Credit = std::min(client.Credit + cRate * aDelta, cRate * kMaxBurst);
+
+    m_candidates.clear();
+
+    for (auto itor = std::begin(client.Entries); itor != std::end(client.Entries);)
+    {
+        const auto entity = itor->first;
+        if (!m_world.valid(entity) || !m_world.all_of<MovementComponent, OwnerComponent>(entity))
+        {
+            itor = client.Entries.erase(itor);
+            continue;
+        }
+
+        auto& entry = itor.value();
+        if (entry.Pending)
+        {
+            // Waiting makes an entity more urgent the longer it wasn't sent
+            const auto cWaited = static_cast<float>(m_time - entry.LastSent);
+            entry.Priority += GetWeight(acPlayer, entity) * (1.f + cWaited) * aDelta;
+
+            m_candidates.emplace_back(entry.Priority, entity);
+        }
+
+        ++itor;
+    }
+
+    std::sort(std::begin(m_candidates), std::end(m_candidates), [](const auto& acLhs, const auto& acRhs) {
+        return acLhs.first > acRhs.first;
+    });
+
+    for (const auto& [priority, entity] : m_candidates)
+    {
+        auto& entry = client.Entries[entity];
+        const auto& movementComponent = m_world.get<MovementComponent>(entity);
+
+        ReferenceUpdate update;
+        auto& movement = update.UpdatedMovement;
+
+        movement.Position = movementComponent.Position;
+
+        movement.Rotation.x = movementComponent.Rotation.x;
+        movement.Rotation.y = movementComponent.Rotation.z;
+
+        const auto& cWire = movementComponent.Wire;
+        if (cWire.Valid && cWire.Position == movementComponent.Position && cWire.Rotation == movementComponent.Rotation)
+        {
+            movement.QuantizedPosition = cWire.CellRelative;
+            movement.QuantizedRotation = cWire.PackedRotation;
+        }
+
+        movement.Direction = movementComponent.Direction;
+        movement.Variables = movementComponent.Variables;
+
+        update.ActionEvents = entry.Actions;
+
+        Buffer::Writer writer(&m_scratch);
+        Serialization::WriteVarInt(writer, World::ToInteger(entity));
+        update.Serialize(writer);
+
+        // Keep going in priority order only, skipping to smaller updates would starve the big ones. The first one goes
+        // out as soon as there is any credit, even if it runs into debt, or an update larger than the burst would block
+        // everything behind it forever.
+        const auto cSize = static_cast<float>(writer.Size());
+        if (cSize > client.Credit && (!aMessage.Updates.empty() || client.Credit <= 0.f))
+            break;
+
+        client.Credit -= cSize;
+
+        aMessage.Updates[World::ToInteger(entity)] = std::move(update);
+
+        entry.Priority = 0.f;
+        entry.LastSent = m_time;
+        entry.Actions.clear();
+        entry.Pending = false;
+
+        // The player now extrapolates from this one
+        auto& sent = entry.Sent;
+        sent.PreviousTick = sent.Tick;
+        sent.PreviousPosition = sent.Position;
+        sent.Tick = aMessage.Tick;
+        sent.Position = movementComponent.Position;
+        sent.Rotation = movementComponent.Rotation;
+        sent.Variables = movementComponent.Variables;
+        sent.Direction = movementComponent.Direction;
+    }
+}
+
+void SnapshotScheduler::Update(float aDelta) noexcept
+{
+    m_time += aDelta;
+
+    QuantizeMovements();
+
+    for (auto itor = std::begin(m_clients); itor != std::end(m_clients);)
+    {
+        if (!itor->second.Seen)
+        {
+            itor = m_clients.erase(itor);
+            continue;
+        }
+
+        itor.value().Seen = false;
+        ++itor;
+    }
+}
+
+void SnapshotScheduler::QuantizeMovements() noexcept
+{
+    m_quantizer.Clear();
+    m_quantizedEntities.clear();
+
+    const auto movementView = m_world.view<MovementComponent>();
+    for (auto entity : movementView)
+    {
+        const auto& movementComponent = movementView.get<MovementComponent>(entity);
+        const auto& cWire = movementComponent.Wire;
+        if (cWire.Valid && cWire.Position == movementComponent.Position && cWire.Rotation == movementComponent.Rotation)
+            continue;
+
+        // Only pitch and yaw are sent, see Schedule
+        m_quantizer.Add(movementComponent.Position, movementComponent.Rotation.x, movementComponent.Rotation.z);
+        m_quantizedEntities.push_back(entity);
+    }
+
+    if (m_quantizedEntities.empty())
+        return;
+
+    m_quantizer.Quantize();
+
+    for (size_t i = 0; i < m_quantizedEntities.size(); ++i)
+    {
+        auto& movementComponent = m_world.get<MovementComponent>(m_quantizedEntities[i]);
+        auto& wire = movementComponent.Wire;
+
+        wire.Position = movementComponent.Position;
+        wire.Rotation = movementComponent.Rotation;
+        wire.CellRelative = m_quantizer.GetPosition(i);
+        wire.PackedRotation = m_quantizer.GetRotation(i);
+        wire.Valid = true;
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Structs/ActionEvent.h>
+#include <Structs/AnimationVariables.h>
+#include <MovementQuantizer.h>
+
+struct World;
+struct Player;
+struct ServerReferencesMoveRequest;
+
+// Spreads movement updates over time so that no player is sent more than their byte budget on average. An entity
+// waiting for a slot gains priority every snapshot, faster when it's close to the player, when it hasn't been sent for
+// a while and for player characters, so everything gets through eventually while large crowds only slow down the far
+// away NPCs instead of flooding weak links with reliable bursts.
+struct SnapshotScheduler
+{
+    explicit SnapshotScheduler(World& aWorld) noexcept;
+    ~SnapshotScheduler() noexcept = default;
+
+    TP_NOCOPYMOVE(SnapshotScheduler);
+
+    // What a player was last scheduled of an entity, they extrapolate the position from the last two
+    struct Baseline
+    {
+        uint64_t Tick{0};
+        glm::vec3 Position{};
+        glm::vec3 Rotation{};
+        AnimationVariables Variables{};
+        float Direction{0.f};
+        uint64_t PreviousTick{0};
+        glm::vec3 PreviousPosition{};
+    };
+
+    void SetBudget(uint32_t aBytesPerSecond) noexcept;
+    [[nodiscard]] uint32_t GetBudget() const noexcept { return m_bytesPerSecond; }
+
+    // Call these in between two Update calls
+    [[nodiscard]] const Baseline& GetBaseline(const Player& acPlayer, entt::entity aEntity) noexcept;
+    // The entity changed in a way the player should hear about, actions are kept until it is sent
+    void Queue(const Player& acPlayer, entt::entity aEntity, const Vector<ActionEvent>& acActions) noexcept;
+    // Fills the message with the most important updates that fit in what the player may receive in aDelta seconds
+    void Schedule(const Player& acPlayer, float aDelta, ServerReferencesMoveRequest& aMessage) noexcept;
+    // Starts a new snapshot, drops the state of the players that were not scheduled in the previous one and quantizes
+    // the entities that moved so building each player's message doesn't have to
+    void Update(float aDelta) noexcept;
+
+private:
+
+    struct Entry
+    {
+        float Priority{0.f};
+        double LastSent{0.0};
+        Vector<ActionEvent> Actions;
+        bool Pending{false};
+        Baseline Sent{};
+    };
+
+    struct Client
+    {
+        Map<entt::entity, Entry> Entries;
+        float Credit{0.f};
+        bool Seen{false};
+    };
+
+    [[nodiscard]] float GetWeight(const Player& acPlayer, entt::entity aEntity) const noexcept;
+    void QuantizeMovements() noexcept;
+
+    World& m_world;
+    uint32_t m_bytesPerSecond;
+    double m_time{0.0};
+    // Keyed by player id, pointers get reused once a player leaves
+    Map<uint32_t, Client> m_clients;
+    Vector<std::pair<float, entt::entity>> m_candidates;
+    TiltedPhoques::Buffer m_scratch;
+    MovementQuantizer m_quantizer;
+    Vector<entt::entity> m_quantizedEntities;
+};
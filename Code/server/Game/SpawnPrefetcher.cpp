@@ -0,0 +1,187 @@
+#include <stdafx.h>
+
+#include <Game/SpawnPrefetcher.h>
+#include <Game/Region.h>
+#include <Game/Player.h>
+
+#include <World.h>
+#include <Components.h>
+#include <GameServer.h>
+
+#include <Messages/CharacterSpawnRequest.h>
+
+namespace
+{
+    constexpr double kPassInterval = 0.5;
+    // How far ahead the position is extrapolated, about half a cell at a gallop
+    constexpr float kLookAhead = 3.f;
+    constexpr float kSmoothing = 0.5f;
+    // Anything faster is a teleport or a load screen, not movement worth predicting
+    constexpr float kMaxSpeed = 8000.f;
+    constexpr double kResendDelay = 20.0;
+    // Prefetching is a nice to have, it must not crowd out the traffic the player needs right now
+    constexpr uint32_t kMaxSpawnsPerPass = 4;
+
+    int32_t Step(int32_t aFrom, int32_t aTo) noexcept
+    {
+        return aFrom + (aTo > aFrom) - (aTo < aFrom);
+    }
+}
+
+SpawnPrefetcher::SpawnPrefetcher(World& aWorld) noexcept
+    : m_world(aWorld)
+{
+}
+
+void SpawnPrefetcher::Update(float aDelta) noexcept
+{
+    m_time += aDelta;
+
+    if (m_time - m_lastPass < kPassInterval)
+        return;
+
+    const auto cElapsed = static_cast<float>(m_time - m_lastPass);
+    m_lastPass = m_time;
+
+    for (auto* pPlayer : m_world.GetPlayerManager())
+    {
+        auto& state = m_states[pPlayer->GetId()];
+        state.LastSeen = m_time;
+
+        for (auto itor = std::begin(state.Sent); itor != std::end(state.Sent);)
+        {
+            if (itor->second.Time + kResendDelay <= m_time || !m_world.valid(itor->first))
+                itor = state.Sent.erase(itor);
+            else
+                ++itor;
+        }
+
+        GridCellCoords center;
+        if (Predict(*pPlayer, state, cElapsed, center))
+            Prefetch(*pPlayer, state, center);
+    }
+
+    for (auto itor = std::begin(m_states); itor != std::end(m_states);)
+    {
+        if (itor->second.LastSeen < m_time)
+            itor = m_states.erase(itor);
+        else
+            ++itor;
+    }
+}
+
+bool SpawnPrefetcher::Predict(const Player& acPlayer, State& aState, float aElapsed, GridCellCoords& aCenter) const noexcept
+{
+    const auto& cellComponent = acPlayer.GetCellComponent();
+    const auto character = acPlayer.GetCharacter();
+
+    // Interiors don't have a grid
+    const auto* pMovement = character ? m_world.try_get<MovementComponent>(*character) : nullptr;
+    if (!pMovement || cellComponent.WorldSpaceId == GameId{})
+    {
+        aState.HasSample = false;
+        return false;
+    }
+
+    const glm::vec2 position(pMovement->Position.x, pMovement->Position.y);
+
+    if (aState.HasSample)
+    {
+        const auto velocity = (position - aState.LastPosition) / aElapsed;
+
+        if (glm::length(velocity) > kMaxSpeed)
+            aState.Velocity = {};
+        else
+            aState.Velocity += (velocity - aState.Velocity) * kSmoothing;
+    }
+
+    aState.LastPosition = position;
+    aState.HasSample = true;
+
+    const auto predicted = position + aState.Velocity * kLookAhead;
+    const auto predictedCell = GridCellCoords::CalculateGridCellCoords(predicted.x, predicted.y);
+    const auto& currentCenter = cellComponent.CenterCoords;
+
+    if (predictedCell == currentCenter)
+        return false;
+
+    // The grid moves one cell at a time, only the next step is worth sending
+    aCenter = GridCellCoords(Step(currentCenter.X, predictedCell.X), Step(currentCenter.Y, predictedCell.Y));
+
+    return true;
+}
+
+void SpawnPrefetcher::Prefetch(const Player& acPlayer, State& aState, const GridCellCoords& acCenter) const noexcept
+{
+    const auto& cellComponent = acPlayer.GetCellComponent();
+
+    const Region currentRegion(cellComponent);
+    const Region nextRegion(CellIdComponent{{}, cellComponent.WorldSpaceId, acCenter});
+
+    uint32_t budget = kMaxSpawnsPerPass;
+
+    auto characterView = m_world.view<CellIdComponent, CharacterComponent, OwnerComponent>();
+    for (auto character : characterView)
+    {
+        if (characterView.get<OwnerComponent>(character).GetOwner() == &acPlayer)
+            continue;
+
+        const auto& characterCellComponent = characterView.get<CellIdComponent>(character);
+        if (!nextRegion.Contains(characterCellComponent) || currentRegion.Contains(characterCellComponent))
+            continue;
+
+        if (aState.Sent.contains(character))
+            continue;
+
+        CharacterSpawnRequest spawnMessage;
+        CharacterService::Serialize(m_world, character, &spawnMessage);
+        spawnMessage.Prefetch = true;
+
+        // Only a head start, it must not compete with what the player needs right now
+        GameServer::Get()->Send(acPlayer.GetConnectionId(), spawnMessage, CharacterSpawnRequest::Delivery, ELane::kBulk);
+
+        aState.Sent[character] = Locate(character);
+
+        if (--budget == 0)
+            break;
+    }
+}
+
+bool SpawnPrefetcher::TakeSent(const Player& acPlayer, const entt::entity aEntity,
+                               const GridCellCoords& acCenter) noexcept
+{
+    const auto stateItor = m_states.find(acPlayer.GetId());
+    if (stateItor == std::end(m_states))
+        return false;
+
+    auto& sent = stateItor.value().Sent;
+
+    const auto itor = sent.find(aEntity);
+    if (itor == std::end(sent))
+        return false;
+
+    const auto cSent = itor->second;
+    sent.erase(itor);
+
+    // Only if the character stayed where the prefetch put it, the client would not find it in its grid otherwise
+    const auto cCurrent = Locate(aEntity);
+    return cSent.Cell == cCurrent.Cell && cSent.Coords == cCurrent.Coords &&
+           GridCellCoords::IsCellInGridCell(cSent.Coords, acCenter);
+}
+
+SpawnPrefetcher::SentSpawn SpawnPrefetcher::Locate(const entt::entity aEntity) const noexcept
+{
+    SentSpawn spawn{m_time, {}, {}};
+
+    if (const auto* pCellIdComponent = m_world.try_get<CellIdComponent>(aEntity))
+        spawn.Cell = pCellIdComponent->Cell;
+
+    // Same computation as the client does on the position it receives
+    if (const auto* pMovementComponent = m_world.try_get<MovementComponent>(aEntity))
+    {
+        const auto& position = pMovementComponent->Position;
+        spawn.Coords = GridCellCoords::CalculateGridCellCoords(position.x, position.y);
+    }
+
+    return spawn;
+}
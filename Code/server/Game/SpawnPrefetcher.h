@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Structs/GameId.h>
+#include <Structs/GridCellCoords.h>
+
+struct World;
+struct Player;
+
+// Guesses the grid cell a player is about to enter from the recent movement of their character and sends them the
+// characters of the cells that will come into view ahead of time. The client keeps these until its grid actually
+// shifts, so fast travellers (horses, carriages) don't wait for a round trip to see who is around.
+struct SpawnPrefetcher
+{
+    explicit SpawnPrefetcher(World& aWorld) noexcept;
+    ~SpawnPrefetcher() noexcept = default;
+
+    TP_NOCOPYMOVE(SpawnPrefetcher);
+
+    void Update(float aDelta) noexcept;
+
+    // Whether the client already has the character from a prefetch made where it still stands and spawns it once
+    // its grid centers on acCenter, the regular spawn on the grid shift can then be skipped. The entry is consumed
+    // either way.
+    [[nodiscard]] bool TakeSent(const Player& acPlayer, entt::entity aEntity, const GridCellCoords& acCenter) noexcept;
+
+private:
+
+    struct SentSpawn
+    {
+        double Time{0.0};
+        // Where the prefetched data put the character, the client only uses it once its grid reaches that spot
+        GameId Cell{};
+        GridCellCoords Coords{};
+    };
+
+    struct State
+    {
+        glm::vec2 LastPosition{};
+        glm::vec2 Velocity{};
+        bool HasSample{false};
+        double LastSeen{0.0};
+        // Characters prefetched recently, they are not sent again for a while
+        Map<entt::entity, SentSpawn> Sent;
+    };
+
+    // Center of the grid the player moves to next, false if they are expected to stay in the current one
+    [[nodiscard]] bool Predict(const Player& acPlayer, State& aState, float aElapsed, GridCellCoords& aCenter) const noexcept;
+    void Prefetch(const Player& acPlayer, State& aState, const GridCellCoords& acCenter) const noexcept;
+    [[nodiscard]] SentSpawn Locate(entt::entity aEntity) const noexcept;
+
+    World& m_world;
+    double m_time{0.0};
+    double m_lastPass{0.0};
+    // Keyed by player id, pointers get reused once a player leaves
+    Map<uint32_t, State> m_states;
+};
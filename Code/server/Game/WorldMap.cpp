@@ -0,0 +1,238 @@
+#include <stdafx.h>
+
+#include <Game/WorldMap.h>
+#include <Components.h>
+
+#if TP_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr uint32_t kMagic = 'T' | ('P' << 8) | ('W' << 16) | ('M' << 24);
+    constexpr uint16_t kVersion = 1;
+
+#pragma pack(push, 1)
+    struct Header
+    {
+        uint32_t Magic;
+        uint16_t Version;
+        uint16_t MasterCount;
+        uint32_t WorldSpaceCount;
+        uint32_t Reserved;
+    };
+
+    struct WorldSpaceEntry
+    {
+        uint32_t Master;
+        uint32_t BaseId;
+        int16_t MinX;
+        int16_t MinY;
+        uint16_t Width;
+        uint16_t Height;
+        uint32_t CellOffset;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(Header) == 16);
+    static_assert(sizeof(WorldSpaceEntry) == 20);
+
+    uint64_t MakeKey(uint32_t aMaster, uint32_t aBaseId) noexcept
+    {
+        return (static_cast<uint64_t>(aMaster) << 32) | aBaseId;
+    }
+}
+
+WorldMap::~WorldMap() noexcept
+{
+    Unload();
+}
+
+bool WorldMap::Load(const std::filesystem::path& acPath) noexcept
+{
+    Unload();
+
+#if TP_PLATFORM_WINDOWS
+    const auto hFile = CreateFileW(acPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(hFile, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    const auto hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    // The mapping keeps the file alive
+    CloseHandle(hFile);
+    if (!hMapping)
+        return false;
+
+    m_pData = static_cast<const uint8_t*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_pData)
+    {
+        CloseHandle(hMapping);
+        return false;
+    }
+
+    m_pHandle = hMapping;
+    m_size = static_cast<size_t>(size.QuadPart);
+#else
+    const auto fd = open(acPath.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    auto* pData = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file alive
+    close(fd);
+    if (pData == MAP_FAILED)
+        return false;
+
+    m_pData = static_cast<const uint8_t*>(pData);
+    m_size = static_cast<size_t>(info.st_size);
+#endif
+
+    if (!Parse())
+    {
+        spdlog::error("World map {} is corrupted, cell relevance falls back to client data", acPath.string());
+        Unload();
+        return false;
+    }
+
+    spdlog::info("Loaded world map {} with {} worldspaces", acPath.string(), m_worldSpaces.size());
+
+    return true;
+}
+
+bool WorldMap::Parse() noexcept
+{
+    if (m_size < sizeof(Header))
+        return false;
+
+    Header header;
+    std::memcpy(&header, m_pData, sizeof(header));
+
+    if (header.Magic != kMagic || header.Version != kVersion)
+        return false;
+
+    size_t offset = sizeof(Header);
+
+    m_masters.reserve(header.MasterCount);
+    for (auto i = 0u; i < header.MasterCount; ++i)
+    {
+        if (offset + 2 > m_size)
+            return false;
+
+        const bool lite = m_pData[offset] != 0;
+        const size_t length = m_pData[offset + 1];
+        offset += 2;
+
+        if (offset + length > m_size)
+            return false;
+
+        m_masters.push_back({String(reinterpret_cast<const char*>(m_pData + offset), length), lite});
+        offset += length;
+    }
+
+    // Worldspace entries are 4 byte aligned
+    offset = (offset + 3) & ~static_cast<size_t>(3);
+
+    if (offset + static_cast<size_t>(header.WorldSpaceCount) * sizeof(WorldSpaceEntry) > m_size)
+        return false;
+
+    m_worldSpaces.reserve(header.WorldSpaceCount);
+    for (auto i = 0u; i < header.WorldSpaceCount; ++i, offset += sizeof(WorldSpaceEntry))
+    {
+        WorldSpaceEntry entry;
+        std::memcpy(&entry, m_pData + offset, sizeof(entry));
+
+        const size_t cellCount = static_cast<size_t>(entry.Width) * entry.Height;
+        if (entry.Master == 0 || entry.Master > m_masters.size() || entry.CellOffset % alignof(Cell) != 0 ||
+            entry.CellOffset > m_size || cellCount > (m_size - entry.CellOffset) / sizeof(Cell))
+            return false;
+
+        const auto* pCells = reinterpret_cast<const Cell*>(m_pData + entry.CellOffset);
+        for (auto j = 0u; j < cellCount; ++j)
+        {
+            if (pCells[j].Master > m_masters.size())
+                return false;
+        }
+
+        m_worldSpaces[MakeKey(entry.Master, entry.BaseId)] = CellGrid(pCells, entry.MinX, entry.MinY, entry.Width, entry.Height);
+    }
+
+    return true;
+}
+
+void WorldMap::Unload() noexcept
+{
+    if (m_pData)
+    {
+#if TP_PLATFORM_WINDOWS
+        UnmapViewOfFile(m_pData);
+        CloseHandle(m_pHandle);
+#else
+        munmap(const_cast<uint8_t*>(m_pData), m_size);
+#endif
+    }
+
+    m_pData = nullptr;
+    m_pHandle = nullptr;
+    m_size = 0;
+    m_masters.clear();
+    m_worldSpaces.clear();
+}
+
+bool WorldMap::ResolveMaster(uint32_t aMaster, const ModsComponent& acMods, uint32_t& aModId) const noexcept
+{
+    const auto& master = m_masters[aMaster - 1];
+    const auto& mods = master.Lite ? acMods.GetLiteMods() : acMods.GetStandardMods();
+
+    const auto itor = mods.find(master.Filename);
+    if (itor == std::end(mods))
+        return false;
+
+    aModId = itor->second;
+    return true;
+}
+
+bool WorldMap::GetCellId(const GameId& acWorldSpaceId, const GridCellCoords& acCoords, const ModsComponent& acMods, GameId& aCellId) const noexcept
+{
+    if (!IsLoaded())
+        return false;
+
+    // Mod ids are handed out as players join, only a handful of masters own worldspaces so matching them is cheap
+    for (auto i = 1u; i <= m_masters.size(); ++i)
+    {
+        uint32_t modId;
+        if (!ResolveMaster(i, acMods, modId) || modId != acWorldSpaceId.ModId)
+            continue;
+
+        const auto itor = m_worldSpaces.find(MakeKey(i, acWorldSpaceId.BaseId));
+        if (itor == std::end(m_worldSpaces))
+            continue;
+
+        const auto* pCell = itor->second.At(acCoords.X, acCoords.Y);
+        if (!pCell || !ResolveMaster(pCell->Master, acMods, modId))
+            return false;
+
+        aCellId = GameId(modId, pCell->BaseId);
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <CellGrid.h>
+#include <Structs/GameId.h>
+#include <Structs/GridCellCoords.h>
+
+struct ModsComponent;
+
+// Exterior cell tables of every worldspace, generated offline from the game's masters with
+// Tools/Scripts/generate_world_map.py. The file is mapped in memory and the tables are used in place.
+struct WorldMap
+{
+    WorldMap() noexcept = default;
+    ~WorldMap() noexcept;
+
+    TP_NOCOPYMOVE(WorldMap);
+
+    bool Load(const std::filesystem::path& acPath) noexcept;
+    [[nodiscard]] bool IsLoaded() const noexcept { return m_pData != nullptr; }
+
+    // Finds the cell at the given coordinates of a worldspace, ids are expressed in the server's mod ids
+    bool GetCellId(const GameId& acWorldSpaceId, const GridCellCoords& acCoords, const ModsComponent& acMods, GameId& aCellId) const noexcept;
+
+private:
+
+    struct Master
+    {
+        String Filename;
+        bool Lite;
+    };
+
+    bool Parse() noexcept;
+    void Unload() noexcept;
+    bool ResolveMaster(uint32_t aMaster, const ModsComponent& acMods, uint32_t& aModId) const noexcept;
+
+    const uint8_t* m_pData{nullptr};
+    size_t m_size{0};
+    void* m_pHandle{nullptr};
+
+    Vector<Master> m_masters;
+    // Keyed by master index and base id of the worldspace
+    Map<uint64_t, CellGrid> m_worldSpaces;
+};
@@ -4,6 +4,7 @@
 #include <stdafx.h>
 #include <GameServer.h>
 #include <Components.h>
+#include <RateLimitedLog.h>
 #include <Packet.hpp>
 
 #include <Events/AdminPacketEvent.h>
@@ -18,7 +19,9 @@
 #include <AdminMessages/ClientAdminMessageFactory.h>
 
 #include <Messages/ClientMessageFactory.h>
+#include <Messages/ServerMessageFactory.h>
 #include <Messages/AuthenticationResponse.h>
+#include <Messages/NotifyJoinQueue.h>
 #include <Scripts/Player.h>
 
 #if TP_PLATFORM_WINDOWS
@@ -31,6 +34,8 @@ GameServer::GameServer(uint16_t aPort, bool aPremium, String aName, String aToke
     : m_lastFrameTime(std::chrono::high_resolution_clock::now())
     , m_name(std::move(aName)), m_token(std::move(aToken)),
       m_adminPassword(std::move(aAdminPassword)),
+      m_congestionControl(*this),
+      m_messageStreams(*this),
       m_requestStop(false)
 {
     assert(s_pInstance == nullptr);
@@ -58,7 +63,7 @@ GameServer::GameServer(uint16_t aPort, bool aPremium, String aName, String aToke
 
             if (!pPlayer)
             {
-                spdlog::error("Connection {:x} is not associated with a player.", aConnectionId);
+                TP_LOG_RATE_LIMITED(spdlog::level::err, "Connection {:x} is not associated with a player.", aConnectionId);
                 Kick(aConnectionId);
                 return;
             }
@@ -73,10 +78,21 @@ GameServer::GameServer(uint16_t aPort, bool aPremium, String aName, String aToke
 
     ClientMessageFactory::Visit(handlerGenerator);
 
+    // Chunks can arrive before the player exists, a large authentication request is streamed too
+    m_messageHandlers[RequestMessageChunk::Opcode] = [this](UniquePtr<ClientMessage>& apMessage, ConnectionId_t aConnectionId) {
+        const auto pRealMessage = CastUnique<RequestMessageChunk>(std::move(apMessage));
+        HandleMessageChunk(aConnectionId, pRealMessage->Chunk);
+    };
+
+    m_messageHandlers[ClientMessageBatch::Opcode] = [this](UniquePtr<ClientMessage>& apMessage, ConnectionId_t aConnectionId) {
+        const auto pRealMessage = CastUnique<ClientMessageBatch>(std::move(apMessage));
+        HandleMessageBatch(aConnectionId, pRealMessage->Messages);
+    };
+
     // Override authentication request
     m_messageHandlers[AuthenticationRequest::Opcode] = [this](UniquePtr<ClientMessage>& apMessage, ConnectionId_t aConnectionId) {
-        const auto pRealMessage = CastUnique<AuthenticationRequest>(std::move(apMessage));
-        HandleAuthenticationRequest(aConnectionId, pRealMessage);
+        auto pRealMessage = CastUnique<AuthenticationRequest>(std::move(apMessage));
+        HandleAuthenticationRequest(aConnectionId, std::move(pRealMessage));
     };
 
     auto adminHandlerGenerator = [this](auto& x) {
@@ -114,8 +130,17 @@ void GameServer::OnUpdate()
 
     auto& dispatcher = m_pWorld->GetDispatcher();
 
+    // Admit players before the update so everything they trigger is handled in the same tick
+    ProcessJoinQueue();
+
     dispatcher.trigger(UpdateEvent{cDeltaSeconds});
 
+    m_congestionControl.Update(cDeltaSeconds);
+    m_messageStreams.Update(cDeltaSeconds);
+
+    // Once per tick, replies to the messages consumed during the tick go out with everything else
+    FlushBatches();
+
     if (m_requestStop)
         Close();
 }
@@ -131,7 +156,7 @@ void GameServer::OnConsume(const void* apData, const uint32_t aSize, const Conne
         auto pMessage = factory.Extract(reader);
         if (!pMessage)
         {
-            spdlog::error("Couldn't parse packet from {:x}", aConnectionId);
+            TP_LOG_RATE_LIMITED(spdlog::level::err, "Couldn't parse packet from {:x}", aConnectionId);
             return;
         }
 
@@ -143,7 +168,7 @@ void GameServer::OnConsume(const void* apData, const uint32_t aSize, const Conne
         auto pMessage = factory.Extract(reader);
         if (!pMessage)
         {
-            spdlog::error("Couldn't parse packet from {:x}", aConnectionId);
+            TP_LOG_RATE_LIMITED(spdlog::level::err, "Couldn't parse packet from {:x}", aConnectionId);
             return;
         }
 
@@ -162,7 +187,28 @@ void GameServer::OnDisconnection(const ConnectionId_t aConnectionId, EDisconnect
 {
     spdlog::info("Connection ended {:x}", aConnectionId);
 
-    m_adminSessions.erase(aConnectionId);
+    if (m_adminSessions.erase(aConnectionId))
+        m_pWorld->GetAdminService().RemoveSession(aConnectionId);
+
+    m_congestionControl.Remove(aConnectionId);
+    m_messageStreams.Remove(aConnectionId);
+
+    if (const auto itor = m_batches.find(aConnectionId); itor != std::end(m_batches))
+    {
+        const auto& cReliable = itor->second.Reliable.GetStats();
+        const auto& cUnreliable = itor->second.Unreliable.GetStats();
+        spdlog::debug("Connection {:x} batched {} messages in {} packets with {} bytes of overhead", aConnectionId,
+                      cReliable.Messages + cUnreliable.Messages, cReliable.Packets + cUnreliable.Packets,
+                      cReliable.OverheadBytes + cUnreliable.OverheadBytes);
+
+        m_batches.erase(itor);
+    }
+
+    const auto cQueuedCount = m_joinQueue.size();
+    m_joinQueue.erase(std::remove_if(std::begin(m_joinQueue), std::end(m_joinQueue),
+                                     [aConnectionId](const PendingJoin& acJoin) { return acJoin.ConnectionId == aConnectionId; }),
+                      std::end(m_joinQueue));
+    m_joinQueueChanged |= cQueuedCount != m_joinQueue.size();
 
     auto* pPlayer = m_pWorld->GetPlayerManager().GetByConnectionId(aConnectionId);
 
@@ -170,47 +216,115 @@ void GameServer::OnDisconnection(const ConnectionId_t aConnectionId, EDisconnect
 
     if (pPlayer)
     {
-        if (const auto& cell = pPlayer->GetCellComponent())
+        if (const auto oldCell = pPlayer->GetCellComponent())
         {
-            const auto oldCell = cell.Cell;
             pPlayer->SetCellComponent(CellIdComponent{{}, {}, {}});
-            m_pWorld->GetDispatcher().trigger(PlayerLeaveCellEvent(oldCell));
+            m_pWorld->GetDispatcher().trigger(PlayerLeaveCellEvent(pPlayer, oldCell));
         }
         m_pWorld->GetDispatcher().trigger(PlayerLeaveEvent(pPlayer));
     }
 
-    // Cleanup all entities that we own
-    auto ownerView = m_pWorld->view<OwnerComponent>();
-    for (auto entity : ownerView)
+    // Cleanup all entities that we own, transfers change the player's list so work on a copy
+    if (pPlayer)
     {
-        const auto& [ownerComponent] = ownerView.get(entity);
-        if (ownerComponent.GetOwner() == pPlayer)
-        {
+        const auto ownedEntities = pPlayer->GetOwnedEntities();
+        for (auto entity : ownedEntities)
             m_pWorld->GetDispatcher().trigger(OwnershipTransferEvent(entity));
-        }
     }
 
-    m_pWorld->GetPlayerManager().Remove(pPlayer);
+    // Release the player's mods so the table only contains what connected players have loaded
+    if (pPlayer)
+    {
+        m_pWorld->ctx<ModsComponent>().Release(pPlayer->GetModIds());
+        m_pWorld->GetPlayerManager().Remove(pPlayer);
+    }
 
     SetTitle();
 }
 
-void GameServer::Send(const ConnectionId_t aConnectionId, const ServerMessage& acServerMessage) const
+void GameServer::Send(const ConnectionId_t aConnectionId, const ServerMessage& acServerMessage)
 {
-    static thread_local ScratchAllocator s_allocator{ 1 << 18 };
+    const auto cTraits = ServerMessageFactory::GetTraits(acServerMessage.GetOpcode());
+    Send(aConnectionId, acServerMessage, cTraits.Delivery, cTraits.Lane);
+}
 
-    ScopedAllocator _(s_allocator);
+void GameServer::Send(const ConnectionId_t aConnectionId, const ServerMessage& acServerMessage, EDelivery aDelivery, ELane aLane)
+{
+    // Allocated once per thread outside of the scratch allocator, it has to fit the largest message we can stream
+    static thread_local Buffer s_buffer(MessageStream::kSerializeBufferSize);
+    static thread_local ScratchAllocator s_allocator{ 1 << 18 };
 
-    Buffer buffer(1 << 16);
-    Buffer::Writer writer(&buffer);
+    Buffer::Writer writer(&s_buffer);
     writer.WriteBits(0, 8); // Skip the first byte as it is used by packet
 
-    acServerMessage.Serialize(writer);
-
-    PacketView packet(reinterpret_cast<char*>(buffer.GetWriteData()), writer.Size());
-    Server::Send(aConnectionId, &packet);
+    {
+        ScopedAllocator _(s_allocator);
+        acServerMessage.Serialize(writer);
+    }
 
     s_allocator.Reset();
+
+    if (MessageStream::IsTruncated(writer))
+    {
+        spdlog::error("Message {} to {:x} doesn't fit in {} bytes, dropped", acServerMessage.GetOpcode(), aConnectionId,
+                      MessageStream::kMaxMessageSize);
+        return;
+    }
+
+    const auto* cpData = s_buffer.GetWriteData();
+
+    // Large messages are streamed, reliable ones sent after a stream wait for it to keep their order
+    if (aDelivery == EDelivery::kReliable && (writer.Size() > MessageStream::kChunkSize || m_messageStreams.IsStreaming(aConnectionId)))
+    {
+        auto& batch = m_batches[aConnectionId].Reliable;
+        batch.Flush([this, aConnectionId](const uint8_t* apPacket, size_t aSize) { SendRaw(aConnectionId, apPacket, aSize, EDelivery::kReliable); });
+
+        if (m_messageStreams.Queue(aConnectionId, cpData, writer.Size()))
+            return;
+    }
+
+    // Bulk payloads wait while the connection is backed up so state and movement don't queue behind them
+    if (aLane == ELane::kBulk && m_congestionControl.HoldBulk(aConnectionId, cpData, writer.Size()))
+        return;
+
+    auto& batches = m_batches[aConnectionId];
+    auto& batch = aDelivery == EDelivery::kReliable ? batches.Reliable : batches.Unreliable;
+    const auto cSend = [this, aConnectionId, aDelivery](const uint8_t* apPacket, size_t aSize) {
+        SendRaw(aConnectionId, apPacket, aSize, aDelivery);
+    };
+
+    if (batches.Reliable.IsEmpty() && batches.Unreliable.IsEmpty())
+        m_pendingBatches.push_back(aConnectionId);
+
+    if (!batch.Add(cpData, writer.Size(), cSend))
+        SendRaw(aConnectionId, cpData, writer.Size(), aDelivery);
+}
+
+void GameServer::SendRaw(ConnectionId_t aConnectionId, const uint8_t* apData, size_t aSize, EDelivery aDelivery) const
+{
+    PacketView packet(reinterpret_cast<char*>(const_cast<uint8_t*>(apData)), aSize);
+    Server::Send(aConnectionId, &packet, aDelivery == EDelivery::kReliable ? EPacketFlags::kReliable : EPacketFlags::kUnreliable);
+}
+
+void GameServer::FlushBatches() noexcept
+{
+    for (const auto cConnectionId : m_pendingBatches)
+    {
+        const auto itor = m_batches.find(cConnectionId);
+        if (itor == std::end(m_batches))
+            continue;
+
+        auto& batches = itor.value();
+
+        batches.Reliable.Flush([this, cConnectionId](const uint8_t* apPacket, size_t aSize) {
+            SendRaw(cConnectionId, apPacket, aSize, EDelivery::kReliable);
+        });
+        batches.Unreliable.Flush([this, cConnectionId](const uint8_t* apPacket, size_t aSize) {
+            SendRaw(cConnectionId, apPacket, aSize, EDelivery::kUnreliable);
+        });
+    }
+
+    m_pendingBatches.clear();
 }
 
 void GameServer::Send(ConnectionId_t aConnectionId, const ServerAdminMessage& acServerMessage) const
@@ -231,7 +345,7 @@ void GameServer::Send(ConnectionId_t aConnectionId, const ServerAdminMessage& ac
     s_allocator.Reset();
 }
 
-void GameServer::SendToLoaded(const ServerMessage& acServerMessage) const
+void GameServer::SendToLoaded(const ServerMessage& acServerMessage)
 {
     for(auto pPlayer : m_pWorld->GetPlayerManager())
     {
@@ -240,7 +354,12 @@ void GameServer::SendToLoaded(const ServerMessage& acServerMessage) const
     }
 }
 
-void GameServer::SendToPlayers(const ServerMessage& acServerMessage) const
+void GameServer::SendMovement(ConnectionId_t aConnectionId, const ServerReferencesMoveRequest& acMessage) noexcept
+{
+    m_congestionControl.SendMovement(aConnectionId, acMessage);
+}
+
+void GameServer::SendToPlayers(const ServerMessage& acServerMessage)
 {
     for (auto pPlayer : m_pWorld->GetPlayerManager())
     {
@@ -253,6 +372,22 @@ const String& GameServer::GetName() const noexcept
     return m_name;
 }
 
+void GameServer::SetJoinLimits(uint32_t aMaxJoinsPerTick, std::chrono::microseconds aBudget) noexcept
+{
+    m_maxJoinsPerTick = std::max(aMaxJoinsPerTick, 1u);
+    m_joinBudget = aBudget;
+}
+
+void GameServer::SetUpdateBudget(uint32_t aBytesPerSecond) noexcept
+{
+    m_pWorld->GetCharacterService().SetUpdateBudget(aBytesPerSecond);
+}
+
+void GameServer::SetStreamRate(uint32_t aBytesPerSecond) noexcept
+{
+    m_messageStreams.SetRate(aBytesPerSecond);
+}
+
 void GameServer::Stop() noexcept
 {
     m_requestStop = true;
@@ -263,7 +398,37 @@ GameServer* GameServer::Get() noexcept
 	return s_pInstance;
 }
 
-void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId, const UniquePtr<AuthenticationRequest>& acRequest) noexcept
+void GameServer::HandleMessageChunk(const ConnectionId_t aConnectionId, const MessageChunk& acChunk) noexcept
+{
+    const auto* pMessage = m_messageStreams.Receive(aConnectionId, acChunk);
+    if (!pMessage)
+        return;
+
+    // A stream can't carry another one, the reassembled buffer would be overwritten while we read it
+    if (pMessage->empty() || (*pMessage)[0] == RequestMessageChunk::Opcode)
+    {
+        TP_LOG_RATE_LIMITED(spdlog::level::err, "Invalid streamed message from {:x}", aConnectionId);
+        return;
+    }
+
+    OnConsume(pMessage->data(), static_cast<uint32_t>(pMessage->size()), aConnectionId);
+}
+
+void GameServer::HandleMessageBatch(const ConnectionId_t aConnectionId, const PackedMessages& acMessages) noexcept
+{
+    const bool cValid = acMessages.Visit([this, aConnectionId](const uint8_t* apMessage, size_t aSize) {
+        // Batches are never nested
+        if (apMessage[0] == ClientMessageBatch::Opcode)
+            return;
+
+        OnConsume(apMessage, static_cast<uint32_t>(aSize), aConnectionId);
+    });
+
+    if (!cValid)
+        TP_LOG_RATE_LIMITED(spdlog::level::err, "Malformed message batch from {:x}", aConnectionId);
+}
+
+void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId, UniquePtr<AuthenticationRequest> apRequest) noexcept
 {
     const auto info = GetConnectionInfo(aConnectionId);
 
@@ -271,102 +436,161 @@ void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId,
 
     info.m_addrRemote.ToString(remoteAddress, 48, false);
 
-    if(acRequest->Token == m_token)
+    if (apRequest->Token == m_token)
     {
-        auto& scripts = m_pWorld->GetScriptService();
+        // The client only sent the hash of its load order and we never saw it, ask for the full list before queuing
+        if (IsManifestOnly(*apRequest) && !m_pWorld->ctx<ModsComponent>().HasManifest(apRequest->ModsHash))
+        {
+            AuthenticationResponse response;
+            response.ModsRequired = true;
+            Send(aConnectionId, response);
+            return;
+        }
 
-        // TODO: Abort if a mod didn't accept the player
+        // Joining is expensive and everyone reconnects at once after a restart, players are admitted a few per tick
+        NotifyJoinQueue notify;
+        notify.Position = static_cast<uint32_t>(m_joinQueue.size());
+        Send(aConnectionId, notify);
 
-        auto& mods = m_pWorld->ctx<ModsComponent>();
+        m_joinQueue.push_back({aConnectionId, std::move(apRequest)});
+    }
+    else if (apRequest->Token == m_adminPassword && !m_adminPassword.empty())
+    {
+        AdminSessionOpen response;
+        Send(aConnectionId, response);
 
-        auto* pPlayer = m_pWorld->GetPlayerManager().Create(aConnectionId);
+        m_adminSessions.insert(aConnectionId);
+        m_pWorld->GetAdminService().AddSession(aConnectionId);
+        spdlog::warn("New admin session for {:x} '{}'", aConnectionId, remoteAddress);
+    }
+    else
+    {
+        spdlog::info("New player {:x} '{}' has a bad token, kicking.", aConnectionId, remoteAddress);
 
-        pPlayer->SetEndpoint(remoteAddress);
-        pPlayer->SetDiscordId(acRequest->DiscordId);
-        pPlayer->SetUsername(std::move(acRequest->Username));
+        Kick(aConnectionId);
+    }
+}
 
-        AuthenticationResponse serverResponse;
+void GameServer::ProcessJoinQueue() noexcept
+{
+    if (m_joinQueue.empty())
+        return;
 
-        Mods& serverMods = serverResponse.UserMods;
+    const auto cStart = std::chrono::high_resolution_clock::now();
 
-        // Note: to lower traffic we only send the mod ids the user can fix in order as other ids will lead to a null form id anyway
-        std::ostringstream oss;
-        oss << "New player {:x} connected with mods\n\t Standard: ";
+    // Always admit at least one player so the queue moves even if a single join blows the budget
+    size_t admitted = 0;
+    while (admitted < m_joinQueue.size() && admitted < m_maxJoinsPerTick)
+    {
+        auto& join = m_joinQueue[admitted];
+        AdmitPlayer(join.ConnectionId, join.pRequest);
+        ++admitted;
 
-        Vector<String> playerMods;
-        Vector<uint16_t> playerModsIds;
-        for (auto& standardMod : acRequest->UserMods.StandardMods)
-        {
-            oss << standardMod.Filename << ", ";
+        if (std::chrono::high_resolution_clock::now() - cStart >= m_joinBudget)
+            break;
+    }
 
-            const auto id = mods.AddStandard(standardMod.Filename);
+    m_joinQueue.erase(std::begin(m_joinQueue), std::begin(m_joinQueue) + admitted);
 
-            Mods::Entry entry;
-            entry.Filename = standardMod.Filename;
-            entry.Id = static_cast<uint16_t>(id);
+    if (admitted > 0 || m_joinQueueChanged)
+        SendJoinQueuePositions();
 
-            playerMods.push_back(standardMod.Filename);
-            playerModsIds.push_back(entry.Id);
+    m_joinQueueChanged = false;
+}
 
-            serverMods.StandardMods.push_back(entry);
-        }
+void GameServer::SendJoinQueuePositions() noexcept
+{
+    NotifyJoinQueue notify;
+    notify.Position = 0;
 
-        oss << "\n\t Lite: ";
-        for (auto& liteMod : acRequest->UserMods.LiteMods)
-        {
-            oss << liteMod.Filename << ", ";
+    for (const auto& join : m_joinQueue)
+    {
+        Send(join.ConnectionId, notify);
+        ++notify.Position;
+    }
+}
 
-            const auto id = mods.AddLite(liteMod.Filename);
+void GameServer::AdmitPlayer(const ConnectionId_t aConnectionId, const UniquePtr<AuthenticationRequest>& acRequest) noexcept
+{
+    const auto info = GetConnectionInfo(aConnectionId);
 
-            Mods::Entry entry;
-            entry.Filename = liteMod.Filename;
-            entry.Id = static_cast<uint16_t>(id);
+    char remoteAddress[48];
 
-            playerMods.push_back(liteMod.Filename);
-            playerModsIds.push_back(entry.Id);
+    info.m_addrRemote.ToString(remoteAddress, 48, false);
 
-            serverMods.LiteMods.push_back(entry);
-        }
+    auto& scripts = m_pWorld->GetScriptService();
 
-        pPlayer->SetMods(playerMods);
-        pPlayer->SetModIds(playerModsIds);
+    // TODO: Abort if a mod didn't accept the player
 
-        //TODO: Scripting
-        /*Script::Player player(cEntity, *m_pWorld);
-        auto [canceled, reason] = scripts.HandlePlayerJoin(player);
+    auto& mods = m_pWorld->ctx<ModsComponent>();
+
+    const ModsComponent::Manifest* pManifest = nullptr;
+    if (IsManifestOnly(*acRequest))
+    {
+        pManifest = mods.Acquire(acRequest->ModsHash);
 
-        if (canceled)
+        // The manifest was evicted while the player was queued, fall back to the full exchange
+        if (!pManifest)
         {
-            spdlog::info("New player {:x} has a been rejected because \"{}\".", aConnectionId, reason.c_str());
+            AuthenticationResponse response;
+            response.ModsRequired = true;
+            Send(aConnectionId, response);
+            return;
+        }
+    }
+    else
+    {
+        pManifest = mods.Resolve(acRequest->UserMods);
 
+        if (!pManifest)
+        {
+            spdlog::warn("New player {:x} '{}' has more mods than the server can track, kicking.", aConnectionId,
+                         remoteAddress);
             Kick(aConnectionId);
-            m_pWorld->destroy(cEntity);
             return;
-        }*/
+        }
+    }
 
-        spdlog::info(oss.str(), aConnectionId);
+    auto* pPlayer = m_pWorld->GetPlayerManager().Create(aConnectionId);
 
-        serverResponse.ServerScripts = std::move(scripts.SerializeScripts());
-        serverResponse.ReplicatedObjects = std::move(scripts.GenerateFull());
+    pPlayer->SetEndpoint(remoteAddress);
+    pPlayer->SetDiscordId(acRequest->DiscordId);
+    pPlayer->SetUsername(std::move(acRequest->Username));
+    pPlayer->SetMods(pManifest->Filenames);
+    pPlayer->SetModIds(pManifest->Ids);
 
-        Send(aConnectionId, serverResponse);
+    AuthenticationResponse serverResponse;
+    serverResponse.UserMods = pManifest->ServerMods;
 
-        m_pWorld->GetDispatcher().trigger(PlayerJoinEvent(pPlayer));
-    }
-    else if (acRequest->Token == m_adminPassword && !m_adminPassword.empty())
-    {
-        AdminSessionOpen response;
-        Send(aConnectionId, response);
+    //TODO: Scripting
+    /*Script::Player player(cEntity, *m_pWorld);
+    auto [canceled, reason] = scripts.HandlePlayerJoin(player);
 
-        m_adminSessions.insert(aConnectionId);
-        spdlog::warn("New admin session for {:x} '{}'", aConnectionId, remoteAddress);
-    }
-    else
+    if (canceled)
     {
-        spdlog::info("New player {:x} '{}' has a bad token, kicking.", aConnectionId, remoteAddress);
+        spdlog::info("New player {:x} has a been rejected because \"{}\".", aConnectionId, reason.c_str());
 
         Kick(aConnectionId);
-    }
+        m_pWorld->destroy(cEntity);
+        return;
+    }*/
+
+    spdlog::info("New player {:x} connected with {} mods (manifest {:x})", aConnectionId, pManifest->Ids.size(),
+                 acRequest->ModsHash);
+
+    serverResponse.ServerScripts = scripts.GetScripts();
+    serverResponse.ReplicatedObjects = scripts.GetFullObjects();
+
+    Send(aConnectionId, serverResponse);
+
+    m_pWorld->GetDispatcher().trigger(PlayerJoinEvent(pPlayer));
+}
+
+bool GameServer::IsManifestOnly(const AuthenticationRequest& acRequest) noexcept
+{
+    // An empty load order is complete even without a list, it would otherwise be asked for the list forever
+    return acRequest.ModsHash != 0 && acRequest.UserMods.StandardMods.empty() && acRequest.UserMods.LiteMods.empty() &&
+           acRequest.ModsHash != acRequest.UserMods.GetHash();
 }
 
 void GameServer::SetTitle() const
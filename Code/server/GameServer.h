@@ -4,6 +4,10 @@
 #include <Messages/Message.h>
 #include <Messages/AuthenticationRequest.h>
 #include <AdminMessages/Message.h>
+#include <Game/CongestionControl.h>
+#include <Game/MessageStreams.h>
+#include <MessageBatcher.h>
+#include <Messages/ServerMessageBatch.h>
 
 using TiltedPhoques::String;
 using TiltedPhoques::Server;
@@ -25,12 +29,28 @@ struct GameServer final : Server
     void OnConnection(ConnectionId_t aHandle) override;
     void OnDisconnection(ConnectionId_t aConnectionId, EDisconnectReason aReason) override;
 
-    void Send(ConnectionId_t aConnectionId, const ServerMessage& acServerMessage) const;
+    // Sends with the delivery class and lane the message type declares
+    void Send(ConnectionId_t aConnectionId, const ServerMessage& acServerMessage);
+    void Send(ConnectionId_t aConnectionId, const ServerMessage& acServerMessage, EDelivery aDelivery, ELane aLane);
     void Send(ConnectionId_t aConnectionId, const ServerAdminMessage& acServerMessage) const;
-    void SendToLoaded(const ServerMessage& acServerMessage) const;
-    void SendToPlayers(const ServerMessage& acServerMessage) const;
+    void SendRaw(ConnectionId_t aConnectionId, const uint8_t* apData, size_t aSize, EDelivery aDelivery) const;
+    // Sends the messages batched for each connection
+    void FlushBatches() noexcept;
+    void SendToLoaded(const ServerMessage& acServerMessage);
+    void SendToPlayers(const ServerMessage& acServerMessage);
+    // Movement snapshots may be merged with the next ones when the connection is backed up
+    void SendMovement(ConnectionId_t aConnectionId, const ServerReferencesMoveRequest& acMessage) noexcept;
+
+    const CongestionControl& GetCongestionControl() const noexcept { return m_congestionControl; }
+    const MessageStreams& GetMessageStreams() const noexcept { return m_messageStreams; }
 
     const String& GetName() const noexcept;
+    const String& GetListEndpoint() const noexcept { return m_listEndpoint; }
+    void SetListEndpoint(String aEndpoint) noexcept { m_listEndpoint = std::move(aEndpoint); }
+
+    void SetJoinLimits(uint32_t aMaxJoinsPerTick, std::chrono::microseconds aBudget) noexcept;
+    void SetUpdateBudget(uint32_t aBytesPerSecond) noexcept;
+    void SetStreamRate(uint32_t aBytesPerSecond) noexcept;
 
     void Stop() noexcept;
 
@@ -45,11 +65,17 @@ struct GameServer final : Server
 
 protected:
 
-    void HandleAuthenticationRequest(ConnectionId_t aConnectionId, const UniquePtr<AuthenticationRequest>& acRequest) noexcept;
+    void HandleAuthenticationRequest(ConnectionId_t aConnectionId, UniquePtr<AuthenticationRequest> apRequest) noexcept;
+    void HandleMessageChunk(ConnectionId_t aConnectionId, const MessageChunk& acChunk) noexcept;
+    void HandleMessageBatch(ConnectionId_t aConnectionId, const PackedMessages& acMessages) noexcept;
+    void AdmitPlayer(ConnectionId_t aConnectionId, const UniquePtr<AuthenticationRequest>& acRequest) noexcept;
+    void ProcessJoinQueue() noexcept;
+    void SendJoinQueuePositions() noexcept;
 
 private:
 
     void SetTitle() const;
+    static bool IsManifestOnly(const AuthenticationRequest& acRequest) noexcept;
 
     std::chrono::high_resolution_clock::time_point m_lastFrameTime;
     std::function<void(UniquePtr<ClientMessage>&, ConnectionId_t)> m_messageHandlers[kClientOpcodeMax];
@@ -58,12 +84,38 @@ private:
     String m_name;
     String m_token;
     String m_adminPassword;
+    String m_listEndpoint;
 
     std::unique_ptr<World> m_pWorld;
+    CongestionControl m_congestionControl;
+    MessageStreams m_messageStreams;
+
+    // Small messages sent to a connection during a tick share packets, one batch per delivery class
+    struct Batches
+    {
+        MessageBatcher<ServerMessageBatch> Reliable;
+        MessageBatcher<ServerMessageBatch> Unreliable{MessageBatcher<ServerMessageBatch>::kMaxUnreliableSize};
+    };
+
+    Map<ConnectionId_t, Batches> m_batches;
+    // Connections with something batched, so flushing doesn't walk every connection
+    Vector<ConnectionId_t> m_pendingBatches;
 
     Set<ConnectionId_t> m_adminSessions;
     Map<ConnectionId_t, entt::entity> m_connectionToEntity;
 
+    struct PendingJoin
+    {
+        ConnectionId_t ConnectionId;
+        UniquePtr<AuthenticationRequest> pRequest;
+    };
+
+    // Players that authenticated but haven't been admitted yet, in arrival order
+    Vector<PendingJoin> m_joinQueue;
+    uint32_t m_maxJoinsPerTick{4};
+    std::chrono::microseconds m_joinBudget{2000};
+    bool m_joinQueueChanged{false};
+
     bool m_requestStop;
 
     static GameServer* s_pInstance;
@@ -0,0 +1,50 @@
+#pragma once
+
+// Lets a call site log at most once per interval, repeats in between are only counted.
+// Meant for packet handlers where a misbehaving client could otherwise flood the logs.
+struct RateLimitedLog
+{
+    explicit RateLimitedLog(std::chrono::steady_clock::duration aInterval) noexcept
+        : m_interval(aInterval.count())
+    {
+    }
+
+    TP_NOCOPYMOVE(RateLimitedLog);
+
+    // Returns false if the message should be dropped, otherwise aSuppressed is set to the number dropped since the last one
+    bool Acquire(uint32_t& aSuppressed) noexcept
+    {
+        const auto cNow = std::chrono::steady_clock::now().time_since_epoch().count();
+
+        auto next = m_next.load(std::memory_order_relaxed);
+        if (cNow < next || !m_next.compare_exchange_strong(next, cNow + m_interval, std::memory_order_relaxed))
+        {
+            m_suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        aSuppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+
+    const std::chrono::steady_clock::rep m_interval;
+    std::atomic<std::chrono::steady_clock::rep> m_next{0};
+    std::atomic<uint32_t> m_suppressed{0};
+};
+
+#define TP_LOG_RATE_LIMITED_INTERVAL(aLevel, aInterval, ...)                                                           \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        static RateLimitedLog s_rateLimit{aInterval};                                                                  \
+        uint32_t suppressed = 0;                                                                                       \
+        if (spdlog::default_logger_raw()->should_log(aLevel) && s_rateLimit.Acquire(suppressed))                       \
+        {                                                                                                              \
+            spdlog::log(aLevel, __VA_ARGS__);                                                                          \
+            if (suppressed > 0)                                                                                        \
+                spdlog::log(aLevel, "Suppressed {} similar messages", suppressed);                                     \
+        }                                                                                                              \
+    } while (0)
+
+#define TP_LOG_RATE_LIMITED(aLevel, ...) TP_LOG_RATE_LIMITED_INTERVAL(aLevel, std::chrono::seconds(1), __VA_ARGS__)
@@ -0,0 +1,194 @@
+#include <stdafx.h>
+
+#include <Scripts/AsyncRunner.h>
+#include <Scripts/Base.h>
+
+namespace Script
+{
+    static constexpr size_t kEventQueueSize = 1 << 12;
+    static constexpr size_t kCommandQueueSize = 1 << 10;
+
+    template<typename... Args>
+    void AsyncRunner::CallEvent(const String& acName, Args&&... args) noexcept
+    {
+        const auto itor = m_callbacks.find(acName);
+        if (itor == std::end(m_callbacks))
+            return;
+
+        for (auto& callback : itor.value())
+        {
+            auto result = callback(std::forward<Args>(args)...);
+            if (!result.valid())
+            {
+                sol::error err = result;
+                spdlog::error(err.what());
+            }
+        }
+    }
+
+    AsyncRunner::AsyncRunner() noexcept
+        : m_events(kEventQueueSize)
+        , m_commands(kCommandQueueSize)
+    {
+    }
+
+    AsyncRunner::~AsyncRunner() noexcept
+    {
+        Stop();
+    }
+
+    void AsyncRunner::Start(const std::filesystem::path& acPath) noexcept
+    {
+        if (m_running)
+            return;
+
+        std::error_code ec;
+        if (!std::filesystem::is_directory(acPath, ec))
+            return;
+
+        m_running = true;
+        m_thread = std::thread(&AsyncRunner::Run, this, acPath);
+
+        spdlog::info("Async scripts started from {}", acPath.string());
+    }
+
+    void AsyncRunner::Stop() noexcept
+    {
+        if (!m_thread.joinable())
+            return;
+
+        m_running = false;
+        m_wakeCondition.notify_one();
+
+        m_thread.join();
+    }
+
+    bool AsyncRunner::Post(Event aEvent) noexcept
+    {
+        if (!m_running)
+            return false;
+
+        if (!m_events.TryPush(std::move(aEvent)))
+        {
+            ++m_droppedEvents;
+            return false;
+        }
+
+        m_wakeCondition.notify_one();
+
+        return true;
+    }
+
+    void AsyncRunner::Run(std::filesystem::path aPath) noexcept
+    {
+        sol::state state;
+        state.open_libraries(sol::lib::base, sol::lib::string, sol::lib::math, sol::lib::table, sol::lib::os);
+
+        BindTypes(state);
+
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(aPath, ec))
+        {
+            if (entry.path().extension() != ".lua")
+                continue;
+
+            state.registry()["PLUGIN_NAME"] = entry.path().stem().string();
+
+            auto result = state.safe_script_file(entry.path().string(), sol::script_pass_on_error);
+            if (!result.valid())
+            {
+                sol::error err = result;
+                spdlog::error(err.what());
+            }
+        }
+
+        Event event;
+        while (m_running)
+        {
+            bool processed = false;
+            while (m_events.TryPop(event))
+            {
+                Dispatch(event);
+                processed = true;
+            }
+
+            if (!processed)
+            {
+                std::unique_lock lock(m_wakeLock);
+                m_wakeCondition.wait_for(lock, 10ms);
+            }
+        }
+
+        // Functions reference the state, release them before it goes away
+        m_callbacks.clear();
+    }
+
+    void AsyncRunner::BindTypes(sol::state& aState) noexcept
+    {
+        auto playerType = aState.new_usertype<PlayerSnapshot>("Player", sol::no_constructor);
+        playerType["id"] = sol::readonly_property(&PlayerSnapshot::GetId);
+        playerType["name"] = sol::readonly_property(&PlayerSnapshot::GetName);
+        playerType["ip"] = sol::readonly_property(&PlayerSnapshot::GetIp);
+        playerType["discordid"] = sol::readonly_property(&PlayerSnapshot::GetDiscordId);
+        playerType["mods"] = sol::readonly_property(&PlayerSnapshot::GetMods);
+        playerType["position"] = sol::readonly_property(&PlayerSnapshot::GetPosition);
+
+        aState.set_function("print", &LuaPrint);
+
+        aState.set_function("addEventHandler", [this](std::string acName, sol::function aFunction)
+        {
+            m_callbacks[String(acName)].push_back(std::move(aFunction));
+        });
+
+        aState.set_function("setTime", [this](int aHours, int aMinutes, float aScale)
+        {
+            Command command;
+            command.CommandType = Command::kSetTime;
+            command.Hours = aHours;
+            command.Minutes = aMinutes;
+            command.TimeScale = aScale;
+
+            PushCommand(std::move(command));
+        });
+
+        aState.set_function("kickPlayer", [this](uint32_t aPlayerId)
+        {
+            Command command;
+            command.CommandType = Command::kKickPlayer;
+            command.PlayerId = aPlayerId;
+
+            PushCommand(std::move(command));
+        });
+    }
+
+    void AsyncRunner::Dispatch(const Event& acEvent) noexcept
+    {
+        switch (acEvent.EventType)
+        {
+        case Event::kUpdate:
+            CallEvent("onUpdate", acEvent.Delta);
+            break;
+        case Event::kPlayerQuit:
+            CallEvent("onPlayerQuit", acEvent.Player, acEvent.Reason);
+            break;
+        case Event::kQuestStart:
+            CallEvent("onQuestStart", acEvent.Player, acEvent.QuestId, acEvent.QuestStage);
+            break;
+        case Event::kQuestStage:
+            CallEvent("onQuestStage", acEvent.Player, acEvent.QuestId, acEvent.QuestStage);
+            break;
+        case Event::kQuestStop:
+            CallEvent("onQuestStop", acEvent.Player, acEvent.QuestId);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void AsyncRunner::PushCommand(Command aCommand) noexcept
+    {
+        // The game thread drains these every tick, if it doesn't keep up scripts are doing something wrong
+        if (!m_commands.TryPush(std::move(aCommand)))
+            spdlog::warn("Async script command queue is full, dropping command");
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <LocklessQueue.h>
+#include <Scripts/Snapshots.h>
+
+#include <thread>
+#include <condition_variable>
+
+namespace Script
+{
+    // Runs scripts that only observe events on a worker thread with a Lua state of their own.
+    // The game thread posts events along with snapshots of the data they need, scripts can't touch the world
+    // directly so anything they want to change comes back as a command applied on the next tick.
+    struct AsyncRunner
+    {
+        struct Event
+        {
+            enum Type : uint8_t
+            {
+                kUpdate,
+                kPlayerQuit,
+                kQuestStart,
+                kQuestStage,
+                kQuestStop
+            };
+
+            Type EventType{kUpdate};
+            float Delta{0.f};
+            PlayerSnapshot Player{};
+            std::string Reason{};
+            uint32_t QuestId{0};
+            uint16_t QuestStage{0};
+        };
+
+        struct Command
+        {
+            enum Type : uint8_t
+            {
+                kSetTime,
+                kKickPlayer
+            };
+
+            Type CommandType{kSetTime};
+            int Hours{0};
+            int Minutes{0};
+            float TimeScale{0.f};
+            uint32_t PlayerId{0};
+        };
+
+        AsyncRunner() noexcept;
+        ~AsyncRunner() noexcept;
+
+        TP_NOCOPYMOVE(AsyncRunner);
+
+        void Start(const std::filesystem::path& acPath) noexcept;
+        void Stop() noexcept;
+
+        // Never blocks, returns false and counts a drop if the worker is too far behind
+        bool Post(Event aEvent) noexcept;
+
+        template<class T>
+        void ProcessCommands(const T& acFunctor) noexcept
+        {
+            Command command;
+            while (m_commands.TryPop(command))
+                acFunctor(command);
+        }
+
+        [[nodiscard]] bool IsRunning() const noexcept { return m_running; }
+        [[nodiscard]] uint64_t GetDroppedEvents() const noexcept { return m_droppedEvents; }
+
+    private:
+
+        void Run(std::filesystem::path aPath) noexcept;
+        void BindTypes(sol::state& aState) noexcept;
+        void Dispatch(const Event& acEvent) noexcept;
+        void PushCommand(Command aCommand) noexcept;
+
+        template<typename... Args>
+        void CallEvent(const String& acName, Args&&... args) noexcept;
+
+        using TCallbacks = Vector<sol::function>;
+
+        std::atomic<bool> m_running{false};
+        std::atomic<uint64_t> m_droppedEvents{0};
+
+        LocklessQueue<Event> m_events;
+        LocklessQueue<Command> m_commands;
+
+        // Only used to sleep while the queue is empty, events never go through the lock
+        std::mutex m_wakeLock;
+        std::condition_variable m_wakeCondition;
+
+        // Worker thread only
+        Map<String, TCallbacks> m_callbacks;
+
+        std::thread m_thread;
+    };
+}
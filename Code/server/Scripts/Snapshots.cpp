@@ -0,0 +1,28 @@
+#include <stdafx.h>
+
+#include <Scripts/Snapshots.h>
+
+#include <World.h>
+#include <Components.h>
+
+namespace Script
+{
+    PlayerSnapshot PlayerSnapshot::From(const World& acWorld, const ::Player& acPlayer) noexcept
+    {
+        PlayerSnapshot snapshot;
+        snapshot.Id = acPlayer.GetId();
+        snapshot.ConnectionId = acPlayer.GetConnectionId();
+        snapshot.Name = acPlayer.GetUsername();
+        snapshot.Ip = acPlayer.GetEndpoint();
+        snapshot.DiscordId = acPlayer.GetDiscordId();
+        snapshot.Mods = acPlayer.GetMods();
+
+        if (const auto character = acPlayer.GetCharacter())
+        {
+            if (const auto* pMovementComponent = acWorld.try_get<MovementComponent>(*character))
+                snapshot.Position = pMovementComponent->Position;
+        }
+
+        return snapshot;
+    }
+}
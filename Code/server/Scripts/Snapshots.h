@@ -0,0 +1,28 @@
+#pragma once
+
+struct Player;
+struct World;
+
+namespace Script
+{
+    // Immutable copies of the data observer scripts need, safe to hand to another thread
+    struct PlayerSnapshot
+    {
+        static PlayerSnapshot From(const World& acWorld, const ::Player& acPlayer) noexcept;
+
+        [[nodiscard]] uint32_t GetId() const noexcept { return Id; }
+        [[nodiscard]] const String& GetName() const noexcept { return Name; }
+        [[nodiscard]] const String& GetIp() const noexcept { return Ip; }
+        [[nodiscard]] uint64_t GetDiscordId() const noexcept { return DiscordId; }
+        [[nodiscard]] const Vector<String>& GetMods() const noexcept { return Mods; }
+        [[nodiscard]] const glm::vec3& GetPosition() const noexcept { return Position; }
+
+        uint32_t Id{0};
+        ConnectionId_t ConnectionId{0};
+        String Name{};
+        String Ip{};
+        uint64_t DiscordId{0};
+        Vector<String> Mods{};
+        glm::vec3 Position{};
+    };
+}
@@ -6,13 +6,67 @@
 #include <Services/AdminService.h>
 
 #include <AdminMessages/AdminShutdownRequest.h>
+#include <AdminMessages/AdminSetLogLevel.h>
 #include <AdminMessages/ServerLogs.h>
 
+static constexpr size_t kLineQueueSize = 1 << 13;
+static constexpr auto kBatchInterval = 100ms;
+// Keeps each message well below the size of the send buffer
+static constexpr size_t kMaxBatchSize = 1 << 15;
 
-AdminService::AdminService(World& aWorld, entt::dispatcher& aDispatcher) : m_world(aWorld)
+AdminService::AdminService(World& aWorld, entt::dispatcher& aDispatcher)
+    : m_lines(kLineQueueSize)
+    , m_world(aWorld)
 {
     m_shutdownConnection =
         aDispatcher.sink<AdminPacketEvent<AdminShutdownRequest>>().connect<&AdminService::HandleShutdown>(this);
+    m_setLogLevelConnection =
+        aDispatcher.sink<AdminPacketEvent<AdminSetLogLevel>>().connect<&AdminService::HandleSetLogLevel>(this);
+
+    m_thread = std::thread(&AdminService::Run, this);
+}
+
+AdminService::~AdminService()
+{
+    Stop();
+}
+
+void AdminService::Stop() noexcept
+{
+    {
+        std::scoped_lock _(m_sessionsLock);
+        m_sessions.clear();
+    }
+
+    UpdateMinimumLevel();
+
+    if (!m_thread.joinable())
+        return;
+
+    m_running = false;
+    m_wakeCondition.notify_one();
+
+    m_thread.join();
+}
+
+void AdminService::AddSession(ConnectionId_t aConnectionId) noexcept
+{
+    {
+        std::scoped_lock _(m_sessionsLock);
+        m_sessions[aConnectionId] = spdlog::level::trace;
+    }
+
+    UpdateMinimumLevel();
+}
+
+void AdminService::RemoveSession(ConnectionId_t aConnectionId) noexcept
+{
+    {
+        std::scoped_lock _(m_sessionsLock);
+        m_sessions.erase(aConnectionId);
+    }
+
+    UpdateMinimumLevel();
 }
 
 void AdminService::HandleShutdown(const AdminPacketEvent<AdminShutdownRequest>& acMessage) noexcept
@@ -22,17 +76,116 @@ void AdminService::HandleShutdown(const AdminPacketEvent<AdminShutdownRequest>&
     GameServer::Get()->Stop();
 }
 
+void AdminService::HandleSetLogLevel(const AdminPacketEvent<AdminSetLogLevel>& acMessage) noexcept
+{
+    const auto cLevel = static_cast<spdlog::level::level_enum>(std::min<uint8_t>(acMessage.Packet.Level, spdlog::level::off));
+
+    {
+        std::scoped_lock _(m_sessionsLock);
+
+        const auto itor = m_sessions.find(acMessage.ConnectionId);
+        if (itor == std::end(m_sessions))
+            return;
+
+        itor.value() = cLevel;
+    }
+
+    UpdateMinimumLevel();
+}
+
+void AdminService::UpdateMinimumLevel() noexcept
+{
+    int minimumLevel = spdlog::level::off;
+
+    {
+        std::scoped_lock _(m_sessionsLock);
+        for (const auto& [id, level] : m_sessions)
+            minimumLevel = std::min<int>(minimumLevel, level);
+    }
+
+    m_minimumLevel = minimumLevel;
+}
+
 void AdminService::sink_it_(const spdlog::details::log_msg& msg)
 {
+    // Nobody listening, don't pay for formatting
+    if (msg.level < m_minimumLevel.load(std::memory_order_relaxed))
+        return;
+
     spdlog::memory_buf_t formatted;
     formatter_->format(msg, formatted);
-    
-    ServerLogs logs;
-    logs.Logs = fmt::to_string(formatted);
 
-    GameServer::Get()->ForEachAdmin([&logs](ConnectionId_t aId) { GameServer::Get()->Send(aId, logs); });
+    Line line;
+    line.Level = msg.level;
+    line.Text.assign(formatted.data(), formatted.size());
+
+    if (!m_lines.TryPush(std::move(line)))
+    {
+        ++m_dropped;
+        ++m_totalDropped;
+    }
 }
 
 void AdminService::flush_()
 {
 }
+
+void AdminService::Run() noexcept
+{
+    Vector<Line> batch;
+    Vector<std::pair<ConnectionId_t, spdlog::level::level_enum>> sessions;
+
+    while (m_running)
+    {
+        {
+            std::unique_lock lock(m_wakeLock);
+            m_wakeCondition.wait_for(lock, kBatchInterval, [this] { return !m_running; });
+        }
+
+        batch.clear();
+
+        Line line;
+        while (m_lines.TryPop(line))
+            batch.push_back(std::move(line));
+
+        const auto cDropped = m_dropped.exchange(0);
+        if (batch.empty() && cDropped == 0)
+            continue;
+
+        sessions.clear();
+        {
+            std::scoped_lock _(m_sessionsLock);
+            for (const auto& [id, level] : m_sessions)
+                sessions.emplace_back(id, level);
+        }
+
+        auto* pServer = GameServer::Get();
+        if (!pServer)
+            continue;
+
+        for (const auto& [id, level] : sessions)
+        {
+            ServerLogs logs;
+            logs.Dropped = cDropped;
+
+            for (const auto& entry : batch)
+            {
+                if (entry.Level < level)
+                    continue;
+
+                if (logs.Logs.size() + entry.Text.size() > kMaxBatchSize && !logs.Logs.empty())
+                {
+                    pServer->Send(id, logs);
+
+                    logs.Logs.clear();
+                    logs.Dropped = 0;
+                }
+
+                logs.Logs.append(entry.Text.c_str(), entry.Text.size());
+            }
+
+            if (!logs.Logs.empty() || logs.Dropped > 0)
+                pServer->Send(id, logs);
+        }
+    }
+}
@@ -2,23 +2,64 @@
 
 #include <Events/AdminPacketEvent.h>
 #include <spdlog/sinks/base_sink.h>
+#include <LocklessQueue.h>
+
+#include <thread>
+#include <condition_variable>
 
 struct World;
 struct UpdateEvent;
 struct AdminShutdownRequest;
+struct AdminSetLogLevel;
 
-class AdminService : public spdlog::sinks::base_sink<spdlog::details::null_mutex>
+// Forwards the server's logs to admin sessions.
+// Logging only formats the line and pushes it to a ring buffer, a background thread batches and sends them.
+class AdminService : public spdlog::sinks::base_sink<std::mutex>
 {
 public:
     AdminService(World& aWorld, entt::dispatcher& aDispatcher);
+    ~AdminService() override;
+
+    void AddSession(ConnectionId_t aConnectionId) noexcept;
+    void RemoveSession(ConnectionId_t aConnectionId) noexcept;
+
+    // Stops forwarding, the sink outlives the server as spdlog keeps a reference
+    void Stop() noexcept;
+
+    [[nodiscard]] uint64_t GetDroppedLines() const noexcept { return m_totalDropped; }
 
 private:
     void HandleShutdown(const AdminPacketEvent<AdminShutdownRequest>& aChanges) noexcept;
+    void HandleSetLogLevel(const AdminPacketEvent<AdminSetLogLevel>& acMessage) noexcept;
 
     void sink_it_(const spdlog::details::log_msg& msg) override;
     void flush_() override;
 
-    Vector<String> m_messages;
+    void Run() noexcept;
+    void UpdateMinimumLevel() noexcept;
+
+    struct Line
+    {
+        spdlog::level::level_enum Level{spdlog::level::trace};
+        // Not a String, lines may be logged while a scratch allocator is active
+        std::string Text;
+    };
+
+    LocklessQueue<Line> m_lines;
+    std::atomic<uint32_t> m_dropped{0};
+    std::atomic<uint64_t> m_totalDropped{0};
+    // Lowest level any session wants, lines below it are not even formatted
+    std::atomic<int> m_minimumLevel{spdlog::level::off};
+
+    std::mutex m_sessionsLock;
+    Map<ConnectionId_t, spdlog::level::level_enum> m_sessions;
+
+    std::mutex m_wakeLock;
+    std::condition_variable m_wakeCondition;
+    std::atomic<bool> m_running{true};
+    std::thread m_thread;
+
     entt::scoped_connection m_shutdownConnection;
+    entt::scoped_connection m_setLogLevelConnection;
     World& m_world;
 };
@@ -4,6 +4,9 @@
 #include <Components.h>
 #include <GameServer.h>
 #include <World.h>
+#include <RateLimitedLog.h>
+#include <DeadReckoning.h>
+#include <glm/gtc/constants.hpp>
 
 #include <Events/CharacterSpawnedEvent.h>
 #include <Events/CharacterExteriorCellChangeEvent.h>
@@ -28,10 +31,65 @@
 #include <Messages/NotifySpawnData.h>
 #include <Messages/RequestOwnershipTransfer.h>
 #include <Messages/NotifyOwnershipTransfer.h>
+#include <Messages/NotifyRelinquishControl.h>
 #include <Messages/RequestOwnershipClaim.h>
 
+namespace
+{
+    // How wrong the other players' guess may get before an entity is worth an update
+    constexpr float kPositionThreshold = 8.f;
+    constexpr float kRotationThreshold = 0.035f;
+    constexpr float kDirectionThreshold = 0.05f;
+    constexpr float kVariableThreshold = 0.05f;
+    // Updates are sent at least this often (ms) so a lost correction doesn't stick around
+    constexpr uint64_t kKeepAlive = DeadReckoning::cMaxExtrapolation;
+
+    float AngleDifference(float aLhs, float aRhs) noexcept
+    {
+        return std::abs(std::remainder(aLhs - aRhs, glm::two_pi<float>()));
+    }
+
+    bool AreVariablesClose(const AnimationVariables& acLhs, const AnimationVariables& acRhs) noexcept
+    {
+        if (acLhs.Booleans != acRhs.Booleans || acLhs.Integers != acRhs.Integers || acLhs.Floats.size() != acRhs.Floats.size())
+            return false;
+
+        for (auto i = 0u; i < acLhs.Floats.size(); ++i)
+        {
+            if (std::abs(acLhs.Floats[i] - acRhs.Floats[i]) > kVariableThreshold)
+                return false;
+        }
+
+        return true;
+    }
+
+    bool NeedsMovementUpdate(const MovementComponent& acMovement, const AnimationComponent& acAnimation,
+                             const SnapshotScheduler::Baseline& acSent, uint64_t aTick) noexcept
+    {
+        if (!acAnimation.Actions.empty() || aTick - acSent.Tick >= kKeepAlive)
+            return true;
+
+        const auto predicted = DeadReckoning::Extrapolate(acSent.PreviousPosition, acSent.PreviousTick, acSent.Position,
+                                                          acSent.Tick, aTick);
+
+        if (glm::distance(predicted, acMovement.Position) > kPositionThreshold)
+            return true;
+
+        // Only the position is extrapolated, everything else holds its last value
+        if (AngleDifference(acMovement.Rotation.x, acSent.Rotation.x) > kRotationThreshold ||
+            AngleDifference(acMovement.Rotation.z, acSent.Rotation.z) > kRotationThreshold ||
+            std::abs(acMovement.Direction - acSent.Direction) > kDirectionThreshold)
+            return true;
+
+        return !AreVariablesClose(acMovement.Variables, acSent.Variables);
+    }
+}
+
 CharacterService::CharacterService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
     : m_world(aWorld)
+    , m_balancer(aWorld)
+    , m_prefetcher(aWorld)
+    , m_scheduler(aWorld)
     , m_updateConnection(aDispatcher.sink<UpdateEvent>().connect<&CharacterService::OnUpdate>(this))
     , m_interiorCellChangeEventConnection(aDispatcher.sink<CharacterInteriorCellChangeEvent>().connect<&CharacterService::OnCharacterInteriorCellChange>(this))
     , m_exteriorCellChangeEventConnection(aDispatcher.sink<CharacterExteriorCellChangeEvent>().connect<&CharacterService::OnCharacterExteriorCellChange>(this))
@@ -99,10 +157,14 @@ void CharacterService::Serialize(const World& aRegistry, entt::entity aEntity, C
     apSpawnRequest->LatestAction = animationComponent.CurrentAction;
 }
 
-void CharacterService::OnUpdate(const UpdateEvent&) const noexcept
+void CharacterService::OnUpdate(const UpdateEvent& acEvent) noexcept
 {
     ProcessFactionsChanges();
     ProcessMovementChanges();
+    ProcessOwnershipBalancing(acEvent.Delta);
+
+    m_dormantCharacters.Update(acEvent.Delta);
+    m_prefetcher.Update(acEvent.Delta);
 }
 
 void CharacterService::OnCharacterExteriorCellChange(const CharacterExteriorCellChangeEvent& acEvent) const noexcept
@@ -152,7 +214,7 @@ void CharacterService::OnCharacterInteriorCellChange(const CharacterInteriorCell
     }
 }
 
-void CharacterService::OnAssignCharacterRequest(const PacketEvent<AssignCharacterRequest>& acMessage) const noexcept
+void CharacterService::OnAssignCharacterRequest(const PacketEvent<AssignCharacterRequest>& acMessage) noexcept
 {
     auto& message = acMessage.Packet;
     const auto& refId = message.ReferenceId;
@@ -175,9 +237,9 @@ void CharacterService::OnAssignCharacterRequest(const PacketEvent<AssignCharacte
         if (itor != std::end(view))
         {
             // This entity already has an owner
-            spdlog::info("FormId: {:x}:{:x} is already managed", refId.ModId, refId.BaseId);
+            TP_LOG_RATE_LIMITED(spdlog::level::info, "FormId: {:x}:{:x} is already managed", refId.ModId, refId.BaseId);
 
-            const auto* pServer = GameServer::Get();
+            auto* pServer = GameServer::Get();
 
             auto& actorValuesComponent = view.get<ActorValuesComponent>(*itor);
             auto& characterComponent = view.get<CharacterComponent>(*itor);
@@ -198,6 +260,17 @@ void CharacterService::OnAssignCharacterRequest(const PacketEvent<AssignCharacte
         }
     }
 
+    // A brief request can only be served if we still have the character's state
+    if (message.Brief && (isCustom || !m_dormantCharacters.Contains(refId)))
+    {
+        AssignCharacterResponse response;
+        response.Cookie = message.Cookie;
+        response.StateRequired = true;
+
+        acMessage.pPlayer->Send(response);
+        return;
+    }
+
     // This entity has no owner create it
     CreateCharacter(acMessage);
 }
@@ -221,54 +294,24 @@ void CharacterService::OnOwnershipTransferRequest(const PacketEvent<RequestOwner
     m_world.GetDispatcher().trigger(OwnershipTransferEvent(*it));
 }
 
-void CharacterService::OnOwnershipTransferEvent(const OwnershipTransferEvent& acEvent) const noexcept
+void CharacterService::OnOwnershipTransferEvent(const OwnershipTransferEvent& acEvent) noexcept
 {
-    const auto view = m_world.view<OwnerComponent, CharacterComponent, CellIdComponent>();
-
-    auto& characterOwnerComponent = view.get<OwnerComponent>(acEvent.Entity);
-    auto& characterCellIdComponent = view.get<CellIdComponent>(acEvent.Entity);
-
     NotifyOwnershipTransfer response;
     response.ServerId = World::ToInteger(acEvent.Entity);
-    
-    bool foundOwner = false;
-    for (auto pPlayer : m_world.GetPlayerManager())
-    {
-        if (characterOwnerComponent.GetOwner() == pPlayer)
-            continue;
-
-        bool isPlayerInvalid = false;
-        for (const auto invalidOwner : characterOwnerComponent.InvalidOwners)
-        {
-            isPlayerInvalid = invalidOwner == pPlayer;
-            if (isPlayerInvalid)
-                break;
-        }
-
-        if (isPlayerInvalid)
-            continue;
-
-        if (pPlayer->GetCellComponent().WorldSpaceId == GameId{})
-        {
-            if (pPlayer->GetCellComponent().Cell != characterCellIdComponent.Cell)
-                continue;
-        }
-        else
-        {
-            if (!GridCellCoords::IsCellInGridCell(characterCellIdComponent.CenterCoords, pPlayer->GetCellComponent().CenterCoords))
-                continue;
-        }
-
-        characterOwnerComponent.SetOwner(pPlayer);
 
-        pPlayer->Send(response);
+    auto* pPlayer = m_balancer.SelectOwner(acEvent.Entity);
+    if (!pPlayer)
+    {
+        // Keep what we know so whoever loads the cell next doesn't have to upload it all again
+        m_dormantCharacters.Store(m_world, acEvent.Entity);
 
-        foundOwner = true;
-        break;
+        m_world.GetDispatcher().trigger(CharacterRemoveEvent(response.ServerId));
+        return;
     }
 
-    if (!foundOwner)
-        m_world.GetDispatcher().trigger(CharacterRemoveEvent(response.ServerId));
+    m_world.get<OwnerComponent>(acEvent.Entity).SetOwner(pPlayer);
+
+    pPlayer->Send(response);
 }
 
 void CharacterService::OnCharacterRemoveEvent(const CharacterRemoveEvent& acEvent) const noexcept
@@ -289,7 +332,7 @@ void CharacterService::OnCharacterRemoveEvent(const CharacterRemoveEvent& acEven
     }
 
     m_world.destroy(*it);
-    spdlog::info("Character destroyed {:X}", acEvent.ServerId);
+    TP_LOG_RATE_LIMITED(spdlog::level::info, "Character destroyed {:X}", acEvent.ServerId);
 }
 
 void CharacterService::OnOwnershipClaimRequest(const PacketEvent<RequestOwnershipClaim>& acMessage) const noexcept
@@ -394,7 +437,7 @@ void CharacterService::OnReferencesMoveRequest(const PacketEvent<ClientReference
         auto itor = view.find(static_cast<entt::entity>(entry.first));
         if (itor == std::end(view))
         {
-            spdlog::debug("{:x} requested move of {:x} but does not exist", acMessage.pPlayer->GetConnectionId(), World::ToInteger(*itor));
+            spdlog::debug("{:x} requested move of {:x} but does not exist", acMessage.pPlayer->GetConnectionId(), entry.first);
             continue;
         }
 
@@ -416,8 +459,13 @@ void CharacterService::OnReferencesMoveRequest(const PacketEvent<ClientReference
         movementComponent.Variables = movement.Variables;
         movementComponent.Direction = movement.Direction;
 
-        cellIdComponent.Cell = movement.CellId;
-        cellIdComponent.WorldSpaceId = movement.WorldSpaceId;
+        // The cell only comes with the updates where it changed
+        if (movement.HasCell)
+        {
+            cellIdComponent.Cell = movement.CellId;
+            cellIdComponent.WorldSpaceId = movement.WorldSpaceId;
+        }
+
         cellIdComponent.CenterCoords = GridCellCoords::CalculateGridCellCoords(movement.Position.x, movement.Position.y);
 
         auto [canceled, reason] = m_world.GetScriptService().HandleMove(npc);
@@ -436,8 +484,6 @@ void CharacterService::OnReferencesMoveRequest(const PacketEvent<ClientReference
 
             animationComponent.Actions.push_back(animationComponent.CurrentAction);
         }
-
-        movementComponent.Sent = false;
     }
 }
 
@@ -451,7 +497,7 @@ void CharacterService::OnFactionsChanges(const PacketEvent<RequestFactionsChange
     {
         auto itor = view.find(static_cast<entt::entity>(id));
 
-        if (itor == std::end(view) || view.get<OwnerComponent>(*itor).GetOwner() != acMessage.pPlayer)
+        if (itor == std::end(view))
             continue;
 
         auto& characterComponent = view.get<CharacterComponent>(*itor);
@@ -460,7 +506,7 @@ void CharacterService::OnFactionsChanges(const PacketEvent<RequestFactionsChange
     }
 }
 
-void CharacterService::CreateCharacter(const PacketEvent<AssignCharacterRequest>& acMessage) const noexcept
+void CharacterService::CreateCharacter(const PacketEvent<AssignCharacterRequest>& acMessage) noexcept
 {
     auto& message = acMessage.Packet;
 
@@ -480,13 +526,13 @@ void CharacterService::CreateCharacter(const PacketEvent<AssignCharacterRequest>
     else if (baseId != GameId{} && !isTemporary)
     {
         m_world.destroy(cEntity);
-        spdlog::warn("Unexpected NpcId, player {:x} might be forging packets", acMessage.pPlayer->GetConnectionId());
+        TP_LOG_RATE_LIMITED(spdlog::level::warn, "Unexpected NpcId, player {:x} might be forging packets", acMessage.pPlayer->GetConnectionId());
         return;
     }
 
     auto* const pServer = GameServer::Get();
 
-    m_world.emplace<OwnerComponent>(cEntity, acMessage.pPlayer);
+    m_world.emplace<OwnerComponent>(cEntity, cEntity, acMessage.pPlayer);
 
     auto& cellIdComponent = m_world.emplace<CellIdComponent>(cEntity, message.CellId);
     if (message.WorldSpaceId != GameId{})
@@ -496,27 +542,36 @@ void CharacterService::CreateCharacter(const PacketEvent<AssignCharacterRequest>
         cellIdComponent.CenterCoords = coords;
     }
 
-    auto& characterComponent = m_world.emplace<CharacterComponent>(cEntity);
-    characterComponent.ChangeFlags = message.ChangeFlags;
-    characterComponent.SaveBuffer = std::move(message.AppearanceBuffer);
-    characterComponent.BaseId = FormIdComponent(message.FormId);
-    characterComponent.FaceTints = message.FaceTints;
-    characterComponent.FactionsContent = message.FactionsContent;
-    characterComponent.IsDead = message.IsDead;
-
-    auto& inventoryComponent = m_world.emplace<InventoryComponent>(cEntity);
-    inventoryComponent.Content = message.InventoryContent;
+    // Characters that went dormant keep the state the server had, the client's copy was reset when the cell unloaded.
+    // A full request carries the client's own state, that one wins.
+    const auto cRestored = message.Brief && !isCustom && m_dormantCharacters.Restore(m_world, cEntity, gameId);
+    if (!message.Brief && !isCustom)
+        m_dormantCharacters.Remove(gameId);
 
-    auto& actorValuesComponent = m_world.emplace<ActorValuesComponent>(cEntity);
-    actorValuesComponent.CurrentActorValues = message.AllActorValues;
+    if (!cRestored)
+    {
+        auto& characterComponent = m_world.emplace<CharacterComponent>(cEntity);
+        characterComponent.ChangeFlags = message.ChangeFlags;
+        characterComponent.SaveBuffer = std::move(message.AppearanceBuffer);
+        characterComponent.BaseId = FormIdComponent(message.FormId);
+        characterComponent.FaceTints = message.FaceTints;
+        characterComponent.FactionsContent = message.FactionsContent;
+        characterComponent.IsDead = message.IsDead;
+
+        auto& inventoryComponent = m_world.emplace<InventoryComponent>(cEntity);
+        inventoryComponent.Content = message.InventoryContent;
+
+        auto& actorValuesComponent = m_world.emplace<ActorValuesComponent>(cEntity);
+        actorValuesComponent.CurrentActorValues = message.AllActorValues;
+    }
 
-    spdlog::info("FormId: {:x}:{:x} - NpcId: {:x}:{:x} assigned to {:x}", gameId.ModId, gameId.BaseId, baseId.ModId, baseId.BaseId, acMessage.pPlayer->GetConnectionId());
+    TP_LOG_RATE_LIMITED(spdlog::level::info, "FormId: {:x}:{:x} - NpcId: {:x}:{:x} assigned to {:x}", gameId.ModId, gameId.BaseId,
+                        baseId.ModId, baseId.BaseId, acMessage.pPlayer->GetConnectionId());
 
     auto& movementComponent = m_world.emplace<MovementComponent>(cEntity);
     movementComponent.Tick = pServer->GetTick();
     movementComponent.Position = message.Position;
     movementComponent.Rotation = {message.Rotation.x, 0.f, message.Rotation.y};
-    movementComponent.Sent = false;
 
     auto& animationComponent = m_world.emplace<AnimationComponent>(cEntity);
     animationComponent.CurrentAction = message.LatestAction;
@@ -537,7 +592,16 @@ void CharacterService::CreateCharacter(const PacketEvent<AssignCharacterRequest>
     response.Cookie = message.Cookie;
     response.ServerId = World::ToInteger(cEntity);
     response.Owner = true;
-    response.AllActorValues = message.AllActorValues;
+    response.AllActorValues = m_world.get<ActorValuesComponent>(cEntity).CurrentActorValues;
+    response.IsDead = m_world.get<CharacterComponent>(cEntity).IsDead;
+
+    // Otherwise the owner's next change would overwrite what was restored with the copy it reset
+    if (cRestored)
+    {
+        response.Restored = true;
+        response.InventoryContent = m_world.get<InventoryComponent>(cEntity).Content;
+        response.FactionsContent = m_world.get<CharacterComponent>(cEntity).FactionsContent;
+    }
 
     pServer->Send(acMessage.pPlayer->GetConnectionId(), response);
 
@@ -608,7 +672,7 @@ void CharacterService::ProcessFactionsChanges() const noexcept
     }
 }
 
-void CharacterService::ProcessMovementChanges() const noexcept
+void CharacterService::ProcessMovementChanges() noexcept
 {
     static std::chrono::steady_clock::time_point lastSendTimePoint;
     constexpr auto cDelayBetweenSnapshots = 1000ms / 50;
@@ -617,18 +681,14 @@ void CharacterService::ProcessMovementChanges() const noexcept
     if (now - lastSendTimePoint < cDelayBetweenSnapshots)
         return;
 
+    // Don't hand out a huge budget after a stall, the burst cap would eat most of it anyway
+    const auto cDelta = std::min(std::chrono::duration<float>(now - lastSendTimePoint).count(), 1.f);
     lastSendTimePoint = now;
 
-    const auto characterView = m_world.view < CellIdComponent, MovementComponent, AnimationComponent, OwnerComponent >();
+    m_scheduler.Update(cDelta);
 
-    Map<Player*, ServerReferencesMoveRequest> messages;
-
-    for (auto pPlayer : m_world.GetPlayerManager())
-    {
-        auto& message = messages[pPlayer];
-
-        message.Tick = GameServer::Get()->GetTick();
-    }
+    const auto characterView = m_world.view < CellIdComponent, MovementComponent, AnimationComponent, OwnerComponent >();
+    const auto cTick = GameServer::Get()->GetTick();
 
     for (auto entity : characterView)
     {
@@ -637,10 +697,6 @@ void CharacterService::ProcessMovementChanges() const noexcept
         auto& ownerComponent = characterView.get<OwnerComponent>(entity);
         auto& animationComponent = characterView.get<AnimationComponent>(entity);
 
-        // If we have nothing new to send skip this
-        if (movementComponent.Sent == true)
-            continue;
-
         for (auto pPlayer : m_world.GetPlayerManager())
         {
             if (pPlayer == ownerComponent.GetOwner())
@@ -664,19 +720,13 @@ void CharacterService::ProcessMovementChanges() const noexcept
                 }
             }
 
-            auto& message = messages[pPlayer];
-            auto& update = message.Updates[World::ToInteger(entity)];
-            auto& movement = update.UpdatedMovement;
-
-            movement.Position = movementComponent.Position;
-
-            movement.Rotation.x = movementComponent.Rotation.x;
-            movement.Rotation.y = movementComponent.Rotation.z;
-
-            movement.Direction = movementComponent.Direction;
-            movement.Variables = movementComponent.Variables;
+            // The player keeps the entity moving on their own, only correct them when they are too far off. Entities
+            // without new data still have to be checked, the guess keeps moving when the truth stopped. Each player is
+            // checked against what they were actually scheduled, the budget and congestion can hold an update back.
+            if (!NeedsMovementUpdate(movementComponent, animationComponent, m_scheduler.GetBaseline(*pPlayer, entity), cTick))
+                continue;
 
-            update.ActionEvents = animationComponent.Actions;
+            m_scheduler.Queue(*pPlayer, entity, animationComponent.Actions);
         }
     }
 
@@ -688,14 +738,35 @@ void CharacterService::ProcessMovementChanges() const noexcept
         animationComponent.Actions.clear();
     });
 
-    m_world.view<MovementComponent>().each([](MovementComponent& movementComponent)
+    for (auto pPlayer : m_world.GetPlayerManager())
     {
-        movementComponent.Sent = true;
-    });
+        ServerReferencesMoveRequest message;
+        message.Tick = cTick;
+
+        m_scheduler.Schedule(*pPlayer, cDelta, message);
 
-    for (auto& [pPlayer, message] : messages)
-    {
         if (!message.Updates.empty())
-            pPlayer->Send(message);
+            pPlayer->SendMovement(message);
+    }
+}
+
+void CharacterService::ProcessOwnershipBalancing(float aDelta) noexcept
+{
+    for (const auto& transfer : m_balancer.Update(aDelta))
+    {
+        const auto serverId = World::ToInteger(transfer.Entity);
+
+        // The old owner stops simulating right away, anything it still sends is ignored as it no longer owns the entity
+        NotifyRelinquishControl relinquish;
+        relinquish.ServerId = serverId;
+        transfer.pFrom->Send(relinquish);
+
+        m_world.get<OwnerComponent>(transfer.Entity).SetOwner(transfer.pTo);
+
+        NotifyOwnershipTransfer notify;
+        notify.ServerId = serverId;
+        transfer.pTo->Send(notify);
+
+        spdlog::debug("Rebalanced {:X} from {:X} to {:X}", serverId, transfer.pFrom->GetConnectionId(), transfer.pTo->GetConnectionId());
     }
 }
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <Events/PacketEvent.h>
+#include <Game/OwnershipBalancer.h>
+#include <Game/DormantCharacterStore.h>
+#include <Game/SpawnPrefetcher.h>
+#include <Game/SnapshotScheduler.h>
 
 struct UpdateEvent;
 struct CharacterInteriorCellChangeEvent;
@@ -27,14 +31,19 @@ struct CharacterService
 
     static void Serialize(const World& aRegistry, entt::entity aEntity, CharacterSpawnRequest* apSpawnRequest) noexcept;
 
+    // Bytes of movement updates each player may receive per second
+    void SetUpdateBudget(uint32_t aBytesPerSecond) noexcept { m_scheduler.SetBudget(aBytesPerSecond); }
+
+    SpawnPrefetcher& GetPrefetcher() noexcept { return m_prefetcher; }
+
 protected:
 
-    void OnUpdate(const UpdateEvent& acEvent) const noexcept;
+    void OnUpdate(const UpdateEvent& acEvent) noexcept;
     void OnCharacterExteriorCellChange(const CharacterExteriorCellChangeEvent& acEvent) const noexcept;
     void OnCharacterInteriorCellChange(const CharacterInteriorCellChangeEvent& acEvent) const noexcept;
-    void OnAssignCharacterRequest(const PacketEvent<AssignCharacterRequest>& acMessage) const noexcept;
+    void OnAssignCharacterRequest(const PacketEvent<AssignCharacterRequest>& acMessage) noexcept;
     void OnOwnershipTransferRequest(const PacketEvent<RequestOwnershipTransfer>& acMessage) const noexcept;
-    void OnOwnershipTransferEvent(const OwnershipTransferEvent& acEvent) const noexcept;
+    void OnOwnershipTransferEvent(const OwnershipTransferEvent& acEvent) noexcept;
     void OnOwnershipClaimRequest(const PacketEvent<RequestOwnershipClaim>& acMessage) const noexcept;
     void OnCharacterRemoveEvent(const CharacterRemoveEvent& acEvent) const noexcept;
     void OnCharacterSpawned(const CharacterSpawnedEvent& acEvent) const noexcept;
@@ -42,14 +51,19 @@ protected:
     void OnFactionsChanges(const PacketEvent<RequestFactionsChanges>& acMessage) const noexcept;
     void OnRequestSpawnData(const PacketEvent<RequestSpawnData>& acMessage) const noexcept;
 
-    void CreateCharacter(const PacketEvent<AssignCharacterRequest>& acMessage) const noexcept;
+    void CreateCharacter(const PacketEvent<AssignCharacterRequest>& acMessage) noexcept;
 
     void ProcessFactionsChanges() const noexcept;
-    void ProcessMovementChanges() const noexcept;
+    void ProcessMovementChanges() noexcept;
+    void ProcessOwnershipBalancing(float aDelta) noexcept;
 
 private:
 
     World& m_world;
+    OwnershipBalancer m_balancer;
+    DormantCharacterStore m_dormantCharacters;
+    SpawnPrefetcher m_prefetcher;
+    SnapshotScheduler m_scheduler;
 
     entt::scoped_connection m_updateConnection;
     entt::scoped_connection m_exteriorCellChangeEventConnection;
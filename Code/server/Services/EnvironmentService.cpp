@@ -38,22 +38,8 @@ void EnvironmentService::OnPlayerJoin(const PlayerJoinEvent& acEvent) const noex
 
 void EnvironmentService::OnPlayerLeaveCellEvent(const PlayerLeaveCellEvent& acEvent) noexcept
 {
-    for (auto pPlayer : m_world.GetPlayerManager())
-    {
-        if (pPlayer->GetCellComponent().Cell == acEvent.OldCell)
-            return;
-    }
-
-    auto objectView = m_world.view<ObjectComponent, CellIdComponent>();
-    for (auto entity : objectView)
-    {
-        const auto& cellIdComponent = objectView.get<CellIdComponent>(entity);
-
-        if (cellIdComponent.Cell != acEvent.OldCell)
-            continue;
-
-        m_world.destroy(entity);
-    }
+    // Objects of cells nobody holds anymore are destroyed by OnUpdate once the grace period expires
+    m_cells.Move(acEvent.OldCell, acEvent.pPlayer->GetCellComponent());
 }
 
 void EnvironmentService::OnAssignObjectsRequest(const PacketEvent<AssignObjectsRequest>& acMessage) noexcept
@@ -64,13 +50,16 @@ void EnvironmentService::OnAssignObjectsRequest(const PacketEvent<AssignObjectsR
 
     for (const auto& object : acMessage.Packet.Objects)
     {
-        const auto iter = std::find_if(std::begin(view), std::end(view), [view, id = object.Id](auto entity)
+        const CellIdComponent cellIdComponent{object.CellId, object.WorldSpaceId, object.CurrentCoords};
+
+        const auto& cellObjects = m_cells.GetObjects(cellIdComponent);
+        const auto iter = std::find_if(std::begin(cellObjects), std::end(cellObjects), [view, id = object.Id](auto entity)
         {
             const auto formIdComponent = view.get<FormIdComponent>(entity);
             return formIdComponent.Id == id;
         });
 
-        if (iter != std::end(view))
+        if (iter != std::end(cellObjects))
         {
             ObjectData objectData;
 
@@ -94,8 +83,10 @@ void EnvironmentService::OnAssignObjectsRequest(const PacketEvent<AssignObjectsR
             auto& objectComponent = m_world.emplace<ObjectComponent>(cEntity, acMessage.pPlayer);
             objectComponent.CurrentLockData = object.CurrentLockData;
 
-            m_world.emplace<CellIdComponent>(cEntity, object.CellId, object.WorldSpaceId, object.CurrentCoords);
+            m_world.emplace<CellIdComponent>(cEntity, cellIdComponent);
             m_world.emplace<InventoryComponent>(cEntity);
+
+            m_cells.AddObject(cEntity, cellIdComponent);
         }
     }
 
@@ -192,8 +183,11 @@ EnvironmentService::TDate EnvironmentService::GetDate() const noexcept
     return {m_timeModel.Day, m_timeModel.Month, m_timeModel.Year};
 }
 
-void EnvironmentService::OnUpdate(const UpdateEvent &) noexcept
+void EnvironmentService::OnUpdate(const UpdateEvent& acEvent) noexcept
 {
+    for (auto entity : m_cells.Update(acEvent.Delta))
+        m_world.destroy(entity);
+
     if (!m_lastTick)
         m_lastTick = GameServer::Get()->GetTick();
 
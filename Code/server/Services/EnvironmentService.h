@@ -3,6 +3,7 @@
 #include <Events/PacketEvent.h>
 #include <Structs/TimeModel.h>
 #include <Structs/GameId.h>
+#include <Game/CellRegistry.h>
 
 struct World;
 struct UpdateEvent;
@@ -35,7 +36,7 @@ public:
     float GetTimeScale() const noexcept { return m_timeModel.TimeScale; }
 
 private:
-    void OnUpdate(const UpdateEvent &) noexcept; 
+    void OnUpdate(const UpdateEvent &) noexcept;
     void OnPlayerJoin(const PlayerJoinEvent&) const noexcept;
     void OnPlayerLeaveCellEvent(const PlayerLeaveCellEvent& acEvent) noexcept;
     void OnAssignObjectsRequest(const PacketEvent<AssignObjectsRequest>&) noexcept;
@@ -44,6 +45,7 @@ private:
 
     TimeModel m_timeModel;
     uint64_t m_lastTick = 0;
+    CellRegistry m_cells;
 
     entt::scoped_connection m_updateConnection;
     entt::scoped_connection m_joinConnection;
@@ -9,11 +9,13 @@
 #include <Events/UpdateEvent.h>
 
 #include <Messages/NotifyPlayerList.h>
+#include <Messages/NotifyPlayerListDelta.h>
 #include <Messages/NotifyPartyInfo.h>
 #include <Messages/NotifyPartyInvite.h>
 #include <Messages/PartyInviteRequest.h>
 #include <Messages/PartyAcceptInviteRequest.h>
 #include <Messages/PartyLeaveRequest.h>
+#include <Messages/RequestPlayerList.h>
 
 PartyService::PartyService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
     : m_world(aWorld)
@@ -23,6 +25,7 @@ PartyService::PartyService(World& aWorld, entt::dispatcher& aDispatcher) noexcep
     , m_partyInviteConnection(aDispatcher.sink<PacketEvent<PartyInviteRequest>>().connect<&PartyService::OnPartyInvite>(this))
     , m_partyAcceptInviteConnection(aDispatcher.sink<PacketEvent<PartyAcceptInviteRequest>>().connect<&PartyService::OnPartyAcceptInvite>(this))
     , m_partyLeaveConnection(aDispatcher.sink<PacketEvent<PartyLeaveRequest>>().connect<&PartyService::OnPartyLeave>(this))
+    , m_requestPlayerListConnection(aDispatcher.sink<PacketEvent<RequestPlayerList>>().connect<&PartyService::OnRequestPlayerList>(this))
 {
 }
 
@@ -37,6 +40,9 @@ const PartyService::Party* PartyService::GetById(uint32_t aId) const noexcept
 
 void PartyService::OnUpdate(const UpdateEvent& acEvent) noexcept
 {
+    // Joins and leaves are coalesced so a wave of players only costs one delta per tick
+    FlushPlayerListChanges();
+
     const auto cCurrentTick = GameServer::Get()->GetTick();
     if (m_nextInvitationExpire > cCurrentTick)
         return;
@@ -63,9 +69,12 @@ void PartyService::OnUpdate(const UpdateEvent& acEvent) noexcept
     }
 }
 
-void PartyService::OnPlayerJoin(const PlayerJoinEvent& acEvent) const noexcept
+void PartyService::OnPlayerJoin(const PlayerJoinEvent& acEvent) noexcept
 {
-    BroadcastPlayerList();
+    auto* pPlayer = acEvent.pPlayer;
+
+    m_updatedPlayers[pPlayer->GetId()] = pPlayer->GetUsername();
+    m_joiningPlayers.push_back(pPlayer);
 }
 
 void PartyService::OnPartyInvite(const PacketEvent<PartyInviteRequest>& acPacket) const noexcept
@@ -141,8 +150,18 @@ void PartyService::OnPartyLeave(const PacketEvent<PartyLeaveRequest>& acPacket)
 
 void PartyService::OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept
 {
-    RemovePlayerFromParty(acEvent.pPlayer);
-    BroadcastPlayerList(acEvent.pPlayer);
+    auto* pPlayer = acEvent.pPlayer;
+
+    RemovePlayerFromParty(pPlayer);
+
+    m_updatedPlayers.erase(pPlayer->GetId());
+
+    // Players that leave before the next flush were never announced, there is nothing to remove
+    const auto cJoiningItor = std::find(std::begin(m_joiningPlayers), std::end(m_joiningPlayers), pPlayer);
+    if (cJoiningItor != std::end(m_joiningPlayers))
+        m_joiningPlayers.erase(cJoiningItor);
+    else
+        m_removedPlayers.push_back(pPlayer->GetId());
 }
 
 void PartyService::RemovePlayerFromParty(Player* apPlayer) noexcept
@@ -171,28 +190,56 @@ void PartyService::RemovePlayerFromParty(Player* apPlayer) noexcept
     }
 }
 
-void PartyService::BroadcastPlayerList(Player* apPlayer) const noexcept
+void PartyService::FlushPlayerListChanges() noexcept
 {
-    auto pIgnoredPlayer = apPlayer;
-    for (auto pSelf : m_world.GetPlayerManager())
+    if (m_updatedPlayers.empty() && m_removedPlayers.empty())
+        return;
+
+    ++m_playerListVersion;
+
+    NotifyPlayerListDelta delta;
+    delta.Version = m_playerListVersion;
+    delta.UpdatedPlayers = std::move(m_updatedPlayers);
+    delta.RemovedPlayers = std::move(m_removedPlayers);
+
+    for (auto pPlayer : m_world.GetPlayerManager())
     {
-        if (pIgnoredPlayer == pSelf)
+        if (std::find(std::begin(m_joiningPlayers), std::end(m_joiningPlayers), pPlayer) != std::end(m_joiningPlayers))
             continue;
 
-        NotifyPlayerList playerList;
-        for (auto pPlayer : m_world.GetPlayerManager())
-        {
-            if (pSelf == pPlayer)
-                continue;
+        pPlayer->Send(delta);
+    }
 
-            if (pIgnoredPlayer == pPlayer)
-                continue;
+    for (auto pPlayer : m_joiningPlayers)
+        SendPlayerList(pPlayer);
 
-            playerList.Players[pPlayer->GetId()] = pPlayer->GetUsername();
-        }
+    m_updatedPlayers.clear();
+    m_removedPlayers.clear();
+    m_joiningPlayers.clear();
+}
+
+void PartyService::SendPlayerList(Player* apPlayer) const noexcept
+{
+    NotifyPlayerList playerList;
+    playerList.Version = m_playerListVersion;
+
+    for (auto pPlayer : m_world.GetPlayerManager())
+    {
+        if (apPlayer == pPlayer)
+            continue;
 
-        pSelf->Send(playerList);
+        playerList.Players[pPlayer->GetId()] = pPlayer->GetUsername();
     }
+
+    apPlayer->Send(playerList);
+}
+
+void PartyService::OnRequestPlayerList(const PacketEvent<RequestPlayerList>& acPacket) const noexcept
+{
+    spdlog::debug("Player {:x} missed player list changes (at version {}, current {}), sending the full list",
+                  acPacket.pPlayer->GetConnectionId(), acPacket.Packet.Version, m_playerListVersion);
+
+    SendPlayerList(acPacket.pPlayer);
 }
 
 void PartyService::BroadcastPartyInfo(uint32_t aPartyId) const noexcept
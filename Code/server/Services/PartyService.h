@@ -9,6 +9,7 @@ struct PlayerLeaveEvent;
 struct PartyInviteRequest;
 struct PartyAcceptInviteRequest;
 struct PartyLeaveRequest;
+struct RequestPlayerList;
 
 struct PartyService
 {
@@ -27,15 +28,17 @@ struct PartyService
 protected:
 
     void OnUpdate(const UpdateEvent& acEvent) noexcept;
-    void OnPlayerJoin(const PlayerJoinEvent& acEvent) const noexcept;
+    void OnPlayerJoin(const PlayerJoinEvent& acEvent) noexcept;
     void OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept;
     void OnPartyInvite(const PacketEvent<PartyInviteRequest>& acPacket) const noexcept;
     void OnPartyAcceptInvite(const PacketEvent<PartyAcceptInviteRequest>& acPacket) noexcept;
     void OnPartyLeave(const PacketEvent<PartyLeaveRequest>& acPacket) noexcept;
+    void OnRequestPlayerList(const PacketEvent<RequestPlayerList>& acPacket) const noexcept;
 
     void RemovePlayerFromParty(Player* apPlayer) noexcept;
 
-    void BroadcastPlayerList(Player* apPlayer = nullptr) const noexcept;
+    void FlushPlayerListChanges() noexcept;
+    void SendPlayerList(Player* apPlayer) const noexcept;
     void BroadcastPartyInfo(uint32_t aPartyId) const noexcept;
 
 private:
@@ -46,10 +49,18 @@ private:
     uint32_t m_nextId{0};
     uint64_t m_nextInvitationExpire{0};
 
+    // Player list changes are accumulated and sent as a single versioned delta per tick
+    uint32_t m_playerListVersion{0};
+    Map<uint32_t, String> m_updatedPlayers;
+    Vector<uint32_t> m_removedPlayers;
+    // Players that joined since the last flush, they get the full list instead of the delta
+    Vector<Player*> m_joiningPlayers;
+
     entt::scoped_connection m_updateEvent;
     entt::scoped_connection m_playerJoinConnection;
     entt::scoped_connection m_playerLeaveConnection;
     entt::scoped_connection m_partyInviteConnection;
     entt::scoped_connection m_partyAcceptInviteConnection;
     entt::scoped_connection m_partyLeaveConnection;
+    entt::scoped_connection m_requestPlayerListConnection;
 };
@@ -8,10 +8,12 @@
 #include <Services/CharacterService.h>
 #include <Components.h>
 #include <GameServer.h>
+#include <Game/Region.h>
 
 #include <Messages/ShiftGridCellRequest.h>
 #include <Messages/EnterExteriorCellRequest.h>
 #include <Messages/EnterInteriorCellRequest.h>
+#include <Messages/RequestClientStats.h>
 #include <Messages/CharacterSpawnRequest.h>
 
 PlayerService::PlayerService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
@@ -19,6 +21,7 @@ PlayerService::PlayerService(World& aWorld, entt::dispatcher& aDispatcher) noexc
     , m_interiorCellEnterConnection(aDispatcher.sink<PacketEvent<EnterInteriorCellRequest>>().connect<&PlayerService::HandleInteriorCellEnter>(this))
     , m_gridCellShiftConnection(aDispatcher.sink<PacketEvent<ShiftGridCellRequest>>().connect<&PlayerService::HandleGridCellShift>(this))
     , m_exteriorCellEnterConnection(aDispatcher.sink<PacketEvent<EnterExteriorCellRequest>>().connect<&PlayerService::HandleExteriorCellEnter>(this))
+    , m_clientStatsConnection(aDispatcher.sink<PacketEvent<RequestClientStats>>().connect<&PlayerService::HandleClientStats>(this))
 {
 }
 
@@ -28,13 +31,22 @@ void PlayerService::HandleGridCellShift(const PacketEvent<ShiftGridCellRequest>&
 
     auto& message = acMessage.Packet;
 
-    const auto oldCell = pPlayer->GetCellComponent().Cell;
+    const auto oldCell = pPlayer->GetCellComponent();
 
-    auto cell = CellIdComponent{message.PlayerCell, message.WorldSpaceId, message.CenterCoords};
+    // Only trust the client with the cell it stands in when we have no map to look it up
+    GameId playerCell = message.PlayerCell;
+    m_world.GetWorldMap().GetCellId(message.WorldSpaceId, message.PlayerCoords, m_world.ctx<const ModsComponent>(), playerCell);
+
+    auto cell = CellIdComponent{playerCell, message.WorldSpaceId, message.CenterCoords};
     pPlayer->SetCellComponent(cell);
 
-    m_world.GetDispatcher().trigger(PlayerLeaveCellEvent(oldCell));
+    m_world.GetDispatcher().trigger(PlayerLeaveCellEvent(pPlayer, oldCell));
+
+    // Characters of the cells that were already loaded have been sent before
+    const Region oldRegion(oldCell);
+    const Region newRegion(cell);
 
+    auto& prefetcher = m_world.GetCharacterService().GetPrefetcher();
     auto characterView = m_world.view<CellIdComponent, CharacterComponent, OwnerComponent>();
     for (auto character : characterView)
     {
@@ -44,16 +56,12 @@ void PlayerService::HandleGridCellShift(const PacketEvent<ShiftGridCellRequest>&
         if (ownedComponent.GetOwner() == pPlayer)
             continue;
 
-        const auto cellItor = std::find_if(std::begin(message.Cells), std::end(message.Cells),
-            [Cells = message.Cells, CharacterCell = characterCellComponent.Cell](auto playerCell)
-        {
-           return playerCell == CharacterCell;
-        });
+        if (!newRegion.Contains(characterCellComponent) || oldRegion.Contains(characterCellComponent))
+            continue;
 
-        if (cellItor == std::end(message.Cells))
-        {
+        // The client spawns prefetched characters itself when its grid shifts
+        if (prefetcher.TakeSent(*pPlayer, character, cell.CenterCoords))
             continue;
-        }
 
         CharacterSpawnRequest spawnMessage;
         CharacterService::Serialize(m_world, character, &spawnMessage);
@@ -71,14 +79,21 @@ void PlayerService::HandleExteriorCellEnter(const PacketEvent<EnterExteriorCellR
     {
         auto entity = *pPlayer->GetCharacter();
 
-        auto cell = CellIdComponent{message.CellId, message.WorldSpaceId, message.CurrentCoords};
-
         if (pPlayer->GetCellComponent())
         {
             m_world.GetDispatcher().trigger(CharacterExteriorCellChangeEvent{pPlayer, entity, message.WorldSpaceId, message.CurrentCoords});
         }
-       
+
+        const auto oldCell = pPlayer->GetCellComponent();
+
+        // Stepping into a cell doesn't move the loaded grid, only a grid shift does, keep its centre until the next one
+        auto cell = CellIdComponent{message.CellId, message.WorldSpaceId, message.CurrentCoords};
+        if (oldCell && oldCell.WorldSpaceId == message.WorldSpaceId)
+            cell.CenterCoords = oldCell.CenterCoords;
+
         pPlayer->SetCellComponent(cell);
+
+        m_world.GetDispatcher().trigger(PlayerLeaveCellEvent(pPlayer, oldCell));
     }
 }
 
@@ -88,12 +103,12 @@ void PlayerService::HandleInteriorCellEnter(const PacketEvent<EnterInteriorCellR
 
     auto& message = acMessage.Packet;
 
-    const auto oldCell = pPlayer->GetCellComponent().Cell;
+    const auto oldCell = pPlayer->GetCellComponent();
 
     auto cell = CellIdComponent{message.CellId, {}, {}};
     pPlayer->SetCellComponent(cell);
 
-    m_world.GetDispatcher().trigger(PlayerLeaveCellEvent(oldCell));
+    m_world.GetDispatcher().trigger(PlayerLeaveCellEvent(pPlayer, oldCell));
 
     if (pPlayer->GetCharacter())
     {
@@ -122,3 +137,9 @@ void PlayerService::HandleInteriorCellEnter(const PacketEvent<EnterInteriorCellR
         pPlayer->Send(spawnMessage);
     }
 }
+
+void PlayerService::HandleClientStats(const PacketEvent<RequestClientStats>& acMessage) const noexcept
+{
+    // Anything above a second is a loading screen or a hitch, treat it as a second so one bad sample doesn't dominate
+    acMessage.pPlayer->SetFrameTime(std::min(acMessage.Packet.FrameTime, 1000000u));
+}
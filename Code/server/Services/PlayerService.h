@@ -6,6 +6,7 @@ struct World;
 struct ShiftGridCellRequest;
 struct EnterInteriorCellRequest;
 struct EnterExteriorCellRequest;
+struct RequestClientStats;
 
 struct PlayerService
 {
@@ -19,6 +20,7 @@ protected:
     void HandleGridCellShift(const PacketEvent<ShiftGridCellRequest>& acMessage) const noexcept;
     void HandleExteriorCellEnter(const PacketEvent<EnterExteriorCellRequest>& acMessage) const noexcept;
     void HandleInteriorCellEnter(const PacketEvent<EnterInteriorCellRequest>& acMessage) const noexcept;
+    void HandleClientStats(const PacketEvent<RequestClientStats>& acMessage) const noexcept;
 
 private:
 
@@ -27,4 +29,5 @@ private:
     entt::scoped_connection m_gridCellShiftConnection;
     entt::scoped_connection m_exteriorCellEnterConnection;
     entt::scoped_connection m_interiorCellEnterConnection;
+    entt::scoped_connection m_clientStatsConnection;
 };
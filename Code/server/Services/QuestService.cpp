@@ -4,6 +4,7 @@
 #include <Components.h>
 
 #include <World.h>
+#include <RateLimitedLog.h>
 #include <Services/QuestService.h>
 
 #include <Messages/RequestQuestUpdate.h>
@@ -46,7 +47,9 @@ void QuestService::HandleQuestChanges(const PacketEvent<RequestQuestUpdate>& acM
 
             if (message.Status == RequestQuestUpdate::Started)
             {
-                spdlog::info("Started Quest: {:x}:{}", message.Id.BaseId, message.Id.ModId);
+                TP_LOG_RATE_LIMITED(spdlog::level::info, "Started Quest: {:x}:{}", message.Id.BaseId, message.Id.ModId);
+
+                m_world.GetScriptService().PostQuestStart(*pPlayer, message.Id.BaseId, message.Stage);
 
                 //TODO: Scripting support
                 // we only trigger that on remote quest start
@@ -58,12 +61,14 @@ void QuestService::HandleQuestChanges(const PacketEvent<RequestQuestUpdate>& acM
         } 
         else 
         {
-            spdlog::info("Updated quest: {:x}:{}", message.Id.BaseId, message.Stage);
+            TP_LOG_RATE_LIMITED(spdlog::level::info, "Updated quest: {:x}:{}", message.Id.BaseId, message.Stage);
 
             auto& record = *questIt;
             record.Id = message.Id;
             record.Stage = message.Stage;
 
+            m_world.GetScriptService().PostQuestStage(*pPlayer, message.Id.BaseId, message.Stage);
+
             // TODO: Scripting support
             //const Script::Player scriptPlayer(acMessage.Entity, m_world);
             //const Script::Quest scriptQuest(message.Id.BaseId, message.Stage, m_world);
@@ -73,7 +78,9 @@ void QuestService::HandleQuestChanges(const PacketEvent<RequestQuestUpdate>& acM
     }
     else if (message.Status == RequestQuestUpdate::Stopped)
     {
-        spdlog::info("Stopped quest: {:x}", message.Id.BaseId);
+        TP_LOG_RATE_LIMITED(spdlog::level::info, "Stopped quest: {:x}", message.Id.BaseId);
+
+        m_world.GetScriptService().PostQuestStop(*pPlayer, message.Id.BaseId);
 
         // TODO: Scripting support
         //const Script::Player player(acMessage.Entity, m_world);
@@ -85,7 +92,7 @@ void QuestService::HandleQuestChanges(const PacketEvent<RequestQuestUpdate>& acM
         }
         else
         {
-            spdlog::warn("Unable to delete quest object {:x}", message.Id.BaseId);
+            TP_LOG_RATE_LIMITED(spdlog::level::warn, "Unable to delete quest object {:x}", message.Id.BaseId);
         }
     }
 }
@@ -18,6 +18,7 @@
 #include <TiltedCore/Filesystem.hpp>
 #include <Components.h>
 #include <GameServer.h>
+#include <MessageStream.h>
 
 ScriptService::ScriptService(World& aWorld, entt::dispatcher& aDispatcher)
     : ScriptStore(true)
@@ -59,17 +60,20 @@ void ScriptService::Initialize() noexcept
 {
     auto path = TiltedPhoques::GetPath() / "scripts"; 
     LoadFullScripts(path);
+
+    m_cachedScripts.reset();
+    ++m_snapshotVersion;
+
+    // Scripts that only observe events live in their own folder and run off the game thread
+    m_asyncRunner.Start(path / "async");
 }
 
 Scripts ScriptService::SerializeScripts() noexcept
 {
-    TiltedPhoques::Buffer buff(10000);
-    Buffer::Writer writer(&buff);
-
-    GetNetState()->SerializeDefinitions(writer);
-
     Scripts scripts;
-    scripts.Data.assign(buff.GetData(), buff.GetData() + writer.Size());
+    const auto cSerialize = [this](Buffer::Writer& aWriter) { GetNetState()->SerializeDefinitions(aWriter); };
+    if (!MessageStream::Serialize(scripts.Data, cSerialize))
+        spdlog::error("Script definitions don't fit in {} bytes, dropping them", MessageStream::kMaxMessageSize);
 
     return scripts;
 }
@@ -93,17 +97,33 @@ Objects ScriptService::GenerateDifferential() noexcept
 
 FullObjects ScriptService::GenerateFull() noexcept
 {
-    TiltedPhoques::Buffer buff(10000);
-    Buffer::Writer writer(&buff);
-
-    GetNetState()->GenerateFullSnapshot(writer);
-
     FullObjects objects;
-    objects.Data.assign(buff.GetData(), buff.GetData() + writer.Size());
+    const auto cSerialize = [this](Buffer::Writer& aWriter) { GetNetState()->GenerateFullSnapshot(aWriter); };
+    if (!MessageStream::Serialize(objects.Data, cSerialize))
+        spdlog::error("Script objects don't fit in {} bytes, dropping them", MessageStream::kMaxMessageSize);
 
     return objects;
 }
 
+const Scripts& ScriptService::GetScripts() noexcept
+{
+    if (!m_cachedScripts)
+        m_cachedScripts = SerializeScripts();
+
+    return *m_cachedScripts;
+}
+
+const FullObjects& ScriptService::GetFullObjects() noexcept
+{
+    if (m_cachedFullObjectsVersion != m_snapshotVersion)
+    {
+        m_cachedFullObjects = GenerateFull();
+        m_cachedFullObjectsVersion = m_snapshotVersion;
+    }
+
+    return m_cachedFullObjects;
+}
+
 std::tuple<bool, String> ScriptService::HandleMove(const Script::Npc& aNpc) noexcept
 {
     return CallCancelableEvent("onCharacterMove", aNpc);
@@ -142,6 +162,16 @@ void ScriptService::HandlePlayerQuit(ConnectionId_t aConnectionId, Server::EDisc
     }
 
     CallEvent("onPlayerQuit", aConnectionId, reason);
+
+    if (const auto* pPlayer = m_world.GetPlayerManager().GetByConnectionId(aConnectionId))
+    {
+        Script::AsyncRunner::Event event;
+        event.EventType = Script::AsyncRunner::Event::kPlayerQuit;
+        event.Player = Script::PlayerSnapshot::From(m_world, *pPlayer);
+        event.Reason = std::move(reason);
+
+        m_asyncRunner.Post(std::move(event));
+    }
 }
 
 void ScriptService::HandleQuestStart(const Script::Player& aPlayer, const Script::Quest& aQuest) noexcept
@@ -159,6 +189,51 @@ void ScriptService::HandleQuestStop(const Script::Player& aPlayer, uint32_t afor
     CallEvent("onQuestStop", aPlayer, aformId);
 }
 
+void ScriptService::PostQuestStart(const ::Player& acPlayer, uint32_t aFormId, uint16_t aStage) noexcept
+{
+    PostQuestEvent(Script::AsyncRunner::Event::kQuestStart, acPlayer, aFormId, aStage);
+}
+
+void ScriptService::PostQuestStage(const ::Player& acPlayer, uint32_t aFormId, uint16_t aStage) noexcept
+{
+    PostQuestEvent(Script::AsyncRunner::Event::kQuestStage, acPlayer, aFormId, aStage);
+}
+
+void ScriptService::PostQuestStop(const ::Player& acPlayer, uint32_t aFormId) noexcept
+{
+    PostQuestEvent(Script::AsyncRunner::Event::kQuestStop, acPlayer, aFormId, 0);
+}
+
+void ScriptService::PostQuestEvent(Script::AsyncRunner::Event::Type aType, const ::Player& acPlayer, uint32_t aFormId, uint16_t aStage) noexcept
+{
+    if (!m_asyncRunner.IsRunning())
+        return;
+
+    Script::AsyncRunner::Event event;
+    event.EventType = aType;
+    event.Player = Script::PlayerSnapshot::From(m_world, acPlayer);
+    event.QuestId = aFormId;
+    event.QuestStage = aStage;
+
+    m_asyncRunner.Post(std::move(event));
+}
+
+void ScriptService::ApplyAsyncCommand(const Script::AsyncRunner::Command& acCommand) noexcept
+{
+    switch (acCommand.CommandType)
+    {
+    case Script::AsyncRunner::Command::kSetTime:
+        m_world.GetEnvironmentService().SetTime(acCommand.Hours, acCommand.Minutes, acCommand.TimeScale);
+        break;
+    case Script::AsyncRunner::Command::kKickPlayer:
+        if (const auto* pPlayer = m_world.GetPlayerManager().GetById(acCommand.PlayerId))
+            GameServer::Get()->Kick(pPlayer->GetConnectionId());
+        break;
+    default:
+        break;
+    }
+}
+
 void ScriptService::RegisterExtensions(ScriptContext& aContext)
 {
     ScriptStore::RegisterExtensions(aContext);
@@ -176,10 +251,25 @@ void ScriptService::OnUpdate(const UpdateEvent& acEvent) noexcept
     // Only send if the snapshot contains anything changed
     if(message.Data.IsEmpty() == false)
     {
+        // Anything cached from the previous state is now stale
+        ++m_snapshotVersion;
+
         GameServer::Get()->SendToLoaded(message);       
     }
 
     CallEvent("onUpdate", acEvent.Delta);
+
+    // Apply what the async scripts asked for since the last tick, then let them know about this one
+    m_asyncRunner.ProcessCommands([this](const Script::AsyncRunner::Command& acCommand) { ApplyAsyncCommand(acCommand); });
+
+    if (m_asyncRunner.IsRunning())
+    {
+        Script::AsyncRunner::Event event;
+        event.EventType = Script::AsyncRunner::Event::kUpdate;
+        event.Delta = acEvent.Delta;
+
+        m_asyncRunner.Post(std::move(event));
+    }
 }
 
 void ScriptService::OnPlayerEnterWorld(const PlayerEnterWorldEvent& acEvent) noexcept
@@ -8,7 +8,10 @@
 #include <Structs/FullObjects.h>
 #include <Structs/Scripts.h>
 
+#include <Scripts/AsyncRunner.h>
+
 struct World;
+struct Player;
 struct ClientRpcCalls;
 struct PlayerEnterWorldEvent;
 
@@ -31,6 +34,12 @@ struct ScriptService : ScriptStore
     Objects GenerateDifferential() noexcept;
     FullObjects GenerateFull() noexcept;
 
+    // Cached until the scripts are reloaded
+    const Scripts& GetScripts() noexcept;
+    // Cached until the next non empty differential
+    const FullObjects& GetFullObjects() noexcept;
+    [[nodiscard]] uint64_t GetSnapshotVersion() const noexcept { return m_snapshotVersion; }
+
     std::tuple<bool, String> HandlePlayerJoin(const Script::Player& aPlayer) noexcept;
     std::tuple<bool, String> HandleMove(const Script::Npc& aNpc) noexcept;
 
@@ -40,6 +49,11 @@ struct ScriptService : ScriptStore
     void HandleQuestStage(const Script::Player& aPlayer, const Script::Quest& aQuest) noexcept;
     void HandleQuestStop(const Script::Player& aPlayer, uint32_t aformId) noexcept;
 
+    // Observer only events, forwarded to the async scripts with a snapshot of the player
+    void PostQuestStart(const ::Player& acPlayer, uint32_t aFormId, uint16_t aStage) noexcept;
+    void PostQuestStage(const ::Player& acPlayer, uint32_t aFormId, uint16_t aStage) noexcept;
+    void PostQuestStop(const ::Player& acPlayer, uint32_t aFormId) noexcept;
+
 protected:
 
     void RegisterExtensions(ScriptContext& aContext) override;
@@ -48,6 +62,9 @@ protected:
     void OnPlayerEnterWorld(const PlayerEnterWorldEvent& acEvent) noexcept;
     void OnRpcCalls(const PacketEvent<ClientRpcCalls>& acRpcCalls) noexcept;
 
+    void PostQuestEvent(Script::AsyncRunner::Event::Type aType, const ::Player& acPlayer, uint32_t aFormId, uint16_t aStage) noexcept;
+    void ApplyAsyncCommand(const Script::AsyncRunner::Command& acCommand) noexcept;
+
     void BindStaticFunctions(ScriptContext& aContext) noexcept;
     void BindTypes(ScriptContext& aContext) noexcept;
 
@@ -73,6 +90,13 @@ private:
     String m_cancelReason;
     Map<String, TCallbacks> m_callbacks;
 
+    Script::AsyncRunner m_asyncRunner;
+
+    std::optional<Scripts> m_cachedScripts;
+    FullObjects m_cachedFullObjects;
+    uint64_t m_snapshotVersion{1};
+    uint64_t m_cachedFullObjectsVersion{0};
+
     entt::scoped_connection m_updateConnection;
     entt::scoped_connection m_rpcCallsRequest;
     entt::scoped_connection m_playerEnterWorldConnection;
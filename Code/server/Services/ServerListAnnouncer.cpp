@@ -0,0 +1,134 @@
+#include <Services/ServerListAnnouncer.h>
+
+#include <httplib.h>
+#include <spdlog/spdlog.h>
+
+static constexpr std::chrono::seconds kInitialBackoff{5};
+static constexpr std::chrono::seconds kMaxBackoff{300};
+
+ServerListAnnouncer::ServerListAnnouncer(String aEndpoint, std::chrono::milliseconds aTimeout) noexcept
+    : m_spState(std::make_shared<State>())
+{
+    m_spState->Endpoint = std::move(aEndpoint);
+    m_spState->Timeout = aTimeout;
+
+    m_thread = std::thread(&ServerListAnnouncer::Run, m_spState);
+}
+
+ServerListAnnouncer::~ServerListAnnouncer() noexcept
+{
+    auto& state = *m_spState;
+
+    std::unique_lock lock(state.Lock);
+    state.Running = false;
+    state.Condition.notify_all();
+
+    // The timeout applies to connecting, writing and reading separately, don't hold the shutdown for all of them
+    if (!state.Condition.wait_for(lock, state.Timeout, [&state] { return state.Done; }))
+    {
+        lock.unlock();
+
+        spdlog::warn("Server list announcement still in flight, not waiting for it");
+        m_thread.detach();
+        return;
+    }
+
+    lock.unlock();
+    m_thread.join();
+}
+
+void ServerListAnnouncer::Post(Announcement aAnnouncement) noexcept
+{
+    {
+        std::scoped_lock _(m_spState->Lock);
+        m_spState->Pending = std::move(aAnnouncement);
+    }
+
+    m_spState->Condition.notify_all();
+}
+
+void ServerListAnnouncer::Run(std::shared_ptr<State> aspState) noexcept
+{
+    auto& state = *aspState;
+
+    auto backoff = std::chrono::steady_clock::duration::zero();
+    auto retryAt = std::chrono::steady_clock::now();
+
+    std::unique_lock lock(state.Lock);
+
+    while (state.Running)
+    {
+        state.Condition.wait(lock, [&state] { return !state.Running || state.Pending; });
+
+        // Don't hammer the list while it is failing, newer announcements keep replacing the pending one meanwhile
+        if (state.Condition.wait_until(lock, retryAt, [&state] { return !state.Running; }))
+            break;
+
+        if (!state.Pending)
+            continue;
+
+        auto announcement = std::move(*state.Pending);
+        state.Pending.reset();
+
+        lock.unlock();
+        const auto cResult = DoPost(state, announcement);
+        lock.lock();
+
+        if (cResult == Result::kFailed)
+        {
+            ++state.Failures;
+
+            backoff = backoff == std::chrono::steady_clock::duration::zero()
+                          ? std::chrono::steady_clock::duration(kInitialBackoff)
+                          : std::min<std::chrono::steady_clock::duration>(backoff * 2, kMaxBackoff);
+            retryAt = std::chrono::steady_clock::now() + backoff;
+
+            // Retry with what failed unless something newer came in
+            if (!state.Pending)
+                state.Pending = std::move(announcement);
+
+            spdlog::warn("Failed to announce to the server list, retrying in {}s",
+                         std::chrono::duration_cast<std::chrono::seconds>(backoff).count());
+        }
+        else
+        {
+            state.Failures = 0;
+            backoff = std::chrono::steady_clock::duration::zero();
+            retryAt = std::chrono::steady_clock::now();
+
+            // If we get a 203 it means the list banned this server, there is no point in announcing again
+            if (cResult == Result::kBanned)
+            {
+                state.Banned = true;
+                break;
+            }
+        }
+    }
+
+    state.Done = true;
+    state.Condition.notify_all();
+}
+
+ServerListAnnouncer::Result ServerListAnnouncer::DoPost(const State& acState, const Announcement& acAnnouncement) noexcept
+{
+    const httplib::Params params{{"port", std::to_string(acAnnouncement.Port)},
+                                 {"player_count", std::to_string(acAnnouncement.PlayerCount)},
+                                 {"name", std::string(acAnnouncement.Name.c_str(), acAnnouncement.Name.size())}};
+
+    const auto cSeconds = acState.Timeout.count() / 1000;
+    const auto cMicroseconds = (acState.Timeout.count() % 1000) * 1000;
+
+    httplib::Client client(std::string(acState.Endpoint.c_str(), acState.Endpoint.size()));
+    client.set_connection_timeout(cSeconds, cMicroseconds);
+    client.set_read_timeout(cSeconds, cMicroseconds);
+    client.set_write_timeout(cSeconds, cMicroseconds);
+
+    const auto response = client.Post("/announce", params);
+    if (!response || response->status >= 400)
+        return Result::kFailed;
+
+    if (response->status == 203)
+        return Result::kBanned;
+
+    return Result::kSuccess;
+}
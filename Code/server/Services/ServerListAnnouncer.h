@@ -0,0 +1,71 @@
+#pragma once
+
+#include <TiltedCore/Platform.hpp>
+#include <TiltedCore/Stl.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+using TiltedPhoques::String;
+
+// Posts the server's information to the public list from a thread of its own.
+// Only the latest announcement matters so there is a single slot, posting replaces whatever wasn't sent yet.
+// Doesn't depend on the rest of the server so it can be tested against a local HTTP server.
+struct ServerListAnnouncer
+{
+    struct Announcement
+    {
+        String Name;
+        uint16_t Port;
+        uint32_t PlayerCount;
+    };
+
+    // aEndpoint is the base URL of the list, announcements are posted to /announce
+    ServerListAnnouncer(String aEndpoint, std::chrono::milliseconds aTimeout) noexcept;
+    // Waits at most aTimeout for a request in flight, the worker is left to finish it on its own after that
+    ~ServerListAnnouncer() noexcept;
+
+    TP_NOCOPYMOVE(ServerListAnnouncer);
+
+    // Never waits on the network
+    void Post(Announcement aAnnouncement) noexcept;
+
+    [[nodiscard]] bool IsBanned() const noexcept { return m_spState->Banned; }
+    [[nodiscard]] uint32_t GetFailureCount() const noexcept { return m_spState->Failures; }
+
+private:
+
+    enum class Result
+    {
+        kSuccess,
+        kBanned,
+        kFailed
+    };
+
+    // Shared with the worker so it can outlive the announcer when a request doesn't finish in time
+    struct State
+    {
+        String Endpoint;
+        std::chrono::milliseconds Timeout;
+
+        std::mutex Lock;
+        std::condition_variable Condition;
+        std::optional<Announcement> Pending;
+        bool Running{true};
+        bool Done{false};
+
+        std::atomic<bool> Banned{false};
+        std::atomic<uint32_t> Failures{0};
+    };
+
+    static void Run(std::shared_ptr<State> aspState) noexcept;
+    [[nodiscard]] static Result DoPost(const State& acState, const Announcement& acAnnouncement) noexcept;
+
+    std::shared_ptr<State> m_spState;
+    std::thread m_thread;
+};
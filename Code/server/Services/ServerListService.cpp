@@ -6,15 +6,12 @@
 #include <Events/PlayerLeaveEvent.h>
 #include <GameServer.h>
 
-#include <future>
-
 #include <Components.h>
 
+// Only disables the official list, an endpoint passed on the command line is always used
 #define DISABLE_LIST
 
-#ifndef DISABLE_LIST
-#include <httplib.h>
-#endif
+static constexpr std::chrono::seconds kAnnounceTimeout{5};
 
 #if TP_SKYRIM
 static const char* s_listEndpoint = "https://skyrim-reborn-list.skyrim-together.com";
@@ -24,12 +21,23 @@ static const char* s_listEndpoint = "https://fallout-reborn-list.skyrim-together
 
 ServerListService::ServerListService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
     : m_world(aWorld), m_updateConnection(aDispatcher.sink<UpdateEvent>().connect<&ServerListService::OnUpdate>(this)),
+      m_playerJoinConnection(aDispatcher.sink<PlayerJoinEvent>().connect<&ServerListService::OnPlayerJoin>(this)),
+      m_playerLeaveConnection(aDispatcher.sink<PlayerLeaveEvent>().connect<&ServerListService::OnPlayerLeave>(this)),
       m_nextAnnounce(std::chrono::seconds(0))
 {
 }
 
 void ServerListService::OnUpdate(const UpdateEvent& acEvent) noexcept
 {
+    if (m_pAnnouncer && m_pAnnouncer->IsBanned())
+    {
+        spdlog::error("This server was banned from the server list, shutting down");
+
+        m_pAnnouncer.reset();
+        GameServer::Get()->Stop();
+        return;
+    }
+
     if (m_nextAnnounce < std::chrono::steady_clock::now())
     {
         Announce();
@@ -52,29 +60,27 @@ void ServerListService::OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept
     m_nextAnnounce = (std::chrono::steady_clock::now() + std::chrono::minutes(1));
 }
 
-void ServerListService::Announce() const noexcept
+void ServerListService::Announce() noexcept
 {
-    uint32_t playerCount = m_world.GetPlayerManager().Count() & 0xFFFFFFFF;
-    uint16_t port = GameServer::Get()->GetPort();
-    const auto& cName = GameServer::Get()->GetName();
-
-    auto f = std::async(std::launch::async, DoPost, cName, port, playerCount);
-}
+    if (!m_pAnnouncer)
+    {
+        String endpoint = GameServer::Get()->GetListEndpoint();
 
-void ServerListService::DoPost(String acName, uint16_t aPort, uint32_t aPlayerCount) noexcept
-{
 #ifndef DISABLE_LIST
-    const httplib::Params params{{"port", std::to_string(aPort)},
-                                 {"player_count", std::to_string(aPlayerCount)},
-                                 {"name", std::string(acName.c_str(), acName.size())}};
+        if (endpoint.empty())
+            endpoint = s_listEndpoint;
+#endif
 
-    httplib::Client client(s_listEndpoint);
-    const auto response = client.Post("/announce", params);
+        if (endpoint.empty())
+            return;
 
-    // If we send a 203 it means we banned this server
-    if (response && response->status == 203)
-    {
-        GameServer::Get()->Close();
+        m_pAnnouncer = MakeUnique<ServerListAnnouncer>(std::move(endpoint), kAnnounceTimeout);
     }
-#endif
+
+    ServerListAnnouncer::Announcement announcement;
+    announcement.Name = GameServer::Get()->GetName();
+    announcement.Port = GameServer::Get()->GetPort();
+    announcement.PlayerCount = m_world.GetPlayerManager().Count() & 0xFFFFFFFF;
+
+    m_pAnnouncer->Post(std::move(announcement));
 }
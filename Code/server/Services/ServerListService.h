@@ -1,5 +1,7 @@
 #pragma once
 
+#include <Services/ServerListAnnouncer.h>
+
 struct World;
 struct UpdateEvent;
 struct PlayerJoinEvent;
@@ -20,14 +22,15 @@ protected:
 
 private:
 
-    void Announce() const noexcept;
-
-    static void DoPost(String acName, uint16_t aPort, uint32_t aPlayerCount) noexcept;
+    void Announce() noexcept;
 
     World& m_world;
 
+    // Created on the first announcement so the endpoint set from the command line is known
+    UniquePtr<ServerListAnnouncer> m_pAnnouncer;
+
     entt::scoped_connection m_updateConnection;
     entt::scoped_connection m_playerJoinConnection;
     entt::scoped_connection m_playerLeaveConnection;
-    mutable std::chrono::steady_clock::time_point m_nextAnnounce;
+    std::chrono::steady_clock::time_point m_nextAnnounce;
 };
@@ -3,6 +3,8 @@
 #include <World.h>
 #include <Components.h>
 
+#include <spdlog/sinks/dist_sink.h>
+
 #include <Services/CharacterService.h>
 #include <Services/PlayerService.h>
 #include <Services/EnvironmentService.h>
@@ -13,10 +15,43 @@
 #include <Services/AdminService.h>
 #include <Services/InventoryService.h>
 
+namespace
+{
+    // Owners keep a list of what they own so per player work doesn't have to scan every owned entity
+    void OnOwnerComponentAdded(entt::registry& aRegistry, entt::entity aEntity) noexcept
+    {
+        if (auto* pOwner = aRegistry.get<OwnerComponent>(aEntity).GetOwner())
+            pOwner->AddOwnedEntity(aEntity);
+    }
+
+    void OnOwnerComponentRemoved(entt::registry& aRegistry, entt::entity aEntity) noexcept
+    {
+        if (auto* pOwner = aRegistry.get<OwnerComponent>(aEntity).GetOwner())
+            pOwner->RemoveOwnedEntity(aEntity);
+    }
+}
+
 World::World()
 {
+    on_construct<OwnerComponent>().connect<&OnOwnerComponentAdded>();
+    on_destroy<OwnerComponent>().connect<&OnOwnerComponentRemoved>();
+
+#if SKYRIM
+    const std::filesystem::path cMapPath = "data/skyrim.tpmap";
+#else
+    const std::filesystem::path cMapPath = "data/fallout4.tpmap";
+#endif
+
+    if (!m_worldMap.Load(cMapPath))
+        spdlog::warn("No world map found at {}, exterior cells are resolved from client data", cMapPath.string());
+
     m_spAdminService = std::make_shared<AdminService>(*this, m_dispatcher);
-    spdlog::default_logger()->sinks().push_back(std::static_pointer_cast<spdlog::sinks::sink>(m_spAdminService));
+    // The logger is asynchronous, its sink list can't be touched anymore so we go through the distributing sink
+    for (auto& spSink : spdlog::default_logger()->sinks())
+    {
+        if (auto spServices = std::dynamic_pointer_cast<spdlog::sinks::dist_sink_mt>(spSink))
+            spServices->add_sink(m_spAdminService);
+    }
 
     set<CharacterService>(*this, m_dispatcher);
     set<PlayerService>(*this, m_dispatcher);
@@ -31,3 +66,9 @@ World::World()
     // late initialize the ScriptService to ensure all components are valid
     m_scriptService = std::make_unique<ScriptService>(*this, m_dispatcher);
 }
+
+World::~World() noexcept
+{
+    // The logger keeps the admin sink alive, make sure it stops sending before the server goes away
+    m_spAdminService->Stop();
+}
@@ -9,11 +9,12 @@
 #include <Services/QuestService.h>
 
 #include "Game/PlayerManager.h"
+#include "Game/WorldMap.h"
 
 struct World : entt::registry
 {
     World();
-    ~World() noexcept = default;
+    ~World() noexcept;
 
     TP_NOCOPYMOVE(World);
 
@@ -29,8 +30,10 @@ struct World : entt::registry
     const EnvironmentService& GetEnvironmentService() const noexcept { return ctx<const EnvironmentService>(); }
     QuestService& GetQuestService() noexcept { return ctx<QuestService>(); }
     const QuestService& GetQuestService() const noexcept { return ctx<const QuestService>(); }
+    AdminService& GetAdminService() noexcept { return *m_spAdminService; }
     PlayerManager& GetPlayerManager() noexcept { return m_playerManager; }
     const PlayerManager& GetPlayerManager() const noexcept { return m_playerManager; }
+    const WorldMap& GetWorldMap() const noexcept { return m_worldMap; }
 
     [[nodiscard]] static uint32_t ToInteger(entt::entity aEntity) { return to_integral(aEntity); }
 
@@ -40,4 +43,5 @@ private:
     std::shared_ptr<AdminService> m_spAdminService;
     std::unique_ptr<ScriptService> m_scriptService;
     PlayerManager m_playerManager;
+    WorldMap m_worldMap;
 };
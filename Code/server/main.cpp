@@ -1,6 +1,8 @@
 #include <stdafx.h>
 
 
+#include <spdlog/async.h>
+#include <spdlog/sinks/dist_sink.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog-inl.h>
@@ -18,9 +20,18 @@ int main(int argc, char** argv)
     auto console = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
     console->set_pattern("%^[%H:%M:%S] [%l]%$ %v");
 
-    auto logger = std::make_shared<spdlog::logger>("", spdlog::sinks_init_list{ console, rotatingLogger });
+    // Sinks are only written from the logging thread, the game thread just queues messages
+    // Sinks added later (admin sessions) go through this one as the logger's own list can't change once logging started
+    auto services = std::make_shared<spdlog::sinks::dist_sink_mt>();
+
+    spdlog::init_thread_pool(1 << 14, 1);
+    auto logger = std::make_shared<spdlog::async_logger>("", spdlog::sinks_init_list{ console, rotatingLogger, services },
+                                                         spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
+    logger->flush_on(spdlog::level::err);
     set_default_logger(logger);
 
+    spdlog::flush_every(std::chrono::seconds(3));
+
     cxxopts::Options options(argv[0], "Game server for "
 #if SKYRIM
         "Skyrim"
@@ -33,14 +44,23 @@ int main(int argc, char** argv)
 
     uint16_t port = 10578;
     bool premium = false;
-    std::string name, token, logLevel, adminPassword;
+    uint32_t joinRate = 4;
+    uint32_t joinBudget = 2000;
+    uint32_t updateBudget = 64 * 1024;
+    uint32_t streamRate = 512 * 1024;
+    std::string name, token, logLevel, adminPassword, listEndpoint;
 
     options.add_options()
         ("p,port", "port to run on", cxxopts::value<uint16_t>(port)->default_value("10578"), "N")
         ("root_password", "Admin password", cxxopts::value<>(adminPassword)->default_value(""), "N")
         ("premium", "Use the premium tick rates", cxxopts::value<bool>(premium)->default_value("false"), "true/false")
+        ("join_rate", "Maximum number of players admitted per tick", cxxopts::value<uint32_t>(joinRate)->default_value("4"), "N")
+        ("join_budget", "Time in microseconds spent admitting players per tick", cxxopts::value<uint32_t>(joinBudget)->default_value("2000"), "N")
+        ("update_budget", "Bytes of movement updates sent to each player per second", cxxopts::value<uint32_t>(updateBudget)->default_value("65536"), "N")
+        ("stream_rate", "Bytes per second of large messages streamed to each player", cxxopts::value<uint32_t>(streamRate)->default_value("524288"), "N")
         ("h,help", "Display the help message")
         ("n,name", "Name to advertise to the public server list", cxxopts::value<>(name))
+        ("list_endpoint", "Server list to announce to instead of the official one", cxxopts::value<>(listEndpoint)->default_value(""), "URL")
         ("l,log", "Log level.", cxxopts::value<>(logLevel)->default_value("info"), "trace/debug/info/warning/error/critical/off")
         ("t,token", "The token required to connect to the server, acts as a password", cxxopts::value<>(token));
 
@@ -67,6 +87,10 @@ int main(int argc, char** argv)
         }
 
         GameServer server(port, premium, name.c_str(), token.c_str(), adminPassword.c_str());
+        server.SetJoinLimits(joinRate, std::chrono::microseconds(joinBudget));
+        server.SetUpdateBudget(updateBudget);
+        server.SetStreamRate(streamRate);
+        server.SetListEndpoint(listEndpoint.c_str());
         // things that need initialization post construction
         server.Initialize();
 
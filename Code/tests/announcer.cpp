@@ -0,0 +1,135 @@
+#include <catch2/catch.hpp>
+
+#include <Services/ServerListAnnouncer.h>
+
+#include <httplib.h>
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    // Stands in for the server list on localhost
+    struct StubList
+    {
+        StubList()
+        {
+            m_server.Post("/announce", [this](const httplib::Request& acRequest, httplib::Response& aResponse) {
+                {
+                    std::scoped_lock _(m_lock);
+                    m_requests.push_back(acRequest.params);
+                }
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(Delay));
+                aResponse.status = Status;
+            });
+
+            m_port = m_server.bind_to_any_port("127.0.0.1");
+            m_thread = std::thread([this] { m_server.listen_after_bind(); });
+        }
+
+        ~StubList()
+        {
+            m_server.stop();
+            m_thread.join();
+        }
+
+        [[nodiscard]] String GetEndpoint() const noexcept
+        {
+            return "http://127.0.0.1:" + TiltedPhoques::String(std::to_string(m_port).c_str());
+        }
+
+        [[nodiscard]] size_t GetRequestCount() noexcept
+        {
+            std::scoped_lock _(m_lock);
+            return m_requests.size();
+        }
+
+        [[nodiscard]] std::string GetParam(size_t aRequest, const char* acpName) noexcept
+        {
+            std::scoped_lock _(m_lock);
+            const auto itor = m_requests[aRequest].find(acpName);
+            return itor != std::end(m_requests[aRequest]) ? itor->second : std::string{};
+        }
+
+        std::atomic<int> Status{200};
+        std::atomic<int> Delay{0};
+
+    private:
+
+        httplib::Server m_server;
+        int m_port{0};
+        std::thread m_thread;
+
+        std::mutex m_lock;
+        std::vector<httplib::Params> m_requests;
+    };
+
+    template <class T>
+    bool WaitFor(const T& acPredicate) noexcept
+    {
+        const auto cDeadline = std::chrono::steady_clock::now() + 5s;
+        while (!acPredicate())
+        {
+            if (std::chrono::steady_clock::now() > cDeadline)
+                return false;
+
+            std::this_thread::sleep_for(10ms);
+        }
+
+        return true;
+    }
+}
+
+TEST_CASE("Server list announcer", "[server.list]")
+{
+    StubList list;
+
+    SECTION("Announcements reach the list")
+    {
+        ServerListAnnouncer announcer(list.GetEndpoint(), 1000ms);
+        announcer.Post({"Test server", 10578, 3});
+
+        REQUIRE(WaitFor([&list] { return list.GetRequestCount() == 1; }));
+        REQUIRE(list.GetParam(0, "name") == "Test server");
+        REQUIRE(list.GetParam(0, "port") == "10578");
+        REQUIRE(list.GetParam(0, "player_count") == "3");
+        REQUIRE(announcer.GetFailureCount() == 0);
+        REQUIRE_FALSE(announcer.IsBanned());
+    }
+
+    SECTION("A ban is reported")
+    {
+        list.Status = 203;
+
+        ServerListAnnouncer announcer(list.GetEndpoint(), 1000ms);
+        announcer.Post({"Test server", 10578, 0});
+
+        REQUIRE(WaitFor([&announcer] { return announcer.IsBanned(); }));
+    }
+
+    SECTION("Errors are counted as failures")
+    {
+        list.Status = 500;
+
+        ServerListAnnouncer announcer(list.GetEndpoint(), 1000ms);
+        announcer.Post({"Test server", 10578, 0});
+
+        REQUIRE(WaitFor([&announcer] { return announcer.GetFailureCount() == 1; }));
+        REQUIRE_FALSE(announcer.IsBanned());
+    }
+
+    SECTION("Shutting down doesn't wait for a stuck list")
+    {
+        list.Delay = 2000;
+
+        const auto cStart = std::chrono::steady_clock::now();
+        {
+            ServerListAnnouncer announcer(list.GetEndpoint(), 200ms);
+            announcer.Post({"Test server", 10578, 0});
+
+            REQUIRE(WaitFor([&list] { return list.GetRequestCount() == 1; }));
+        }
+
+        REQUIRE(std::chrono::steady_clock::now() - cStart < 1500ms);
+    }
+}
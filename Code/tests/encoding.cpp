@@ -4,9 +4,18 @@
 #include <Messages/ClientMessageFactory.h>
 #include <Messages/ServerMessageFactory.h>
 #include <Structs/Vector2_NetQuantize.h>
+#include <MessageStream.h>
+#include <MessageBatcher.h>
+#include <MovementQuantizer.h>
+#include <Structs/AnimationGraphDescriptorManager.h>
  
 #include <TiltedCore/Math.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <random>
+
 using namespace TiltedPhoques;
 
 TEST_CASE("Encoding factory", "[encoding.factory]")
@@ -109,6 +118,20 @@ TEST_CASE("Static structures", "[encoding.static]")
 
             REQUIRE(sendObjects == recvObjects);
         }
+
+        sendObjects.Data.resize(1 << 17, 7);
+
+        {
+            Buffer buff(1 << 18);
+            Buffer::Writer writer(&buff);
+
+            sendObjects.Serialize(writer);
+
+            Buffer::Reader reader(&buff);
+            recvObjects.Deserialize(reader);
+
+            REQUIRE(sendObjects == recvObjects);
+        }
     }
 
     GIVEN("GameId")
@@ -273,6 +296,24 @@ TEST_CASE("Differential structures", "[encoding.differential]")
         REQUIRE(sendMods == recvMods);
     }
 
+    GIVEN("Mods hash")
+    {
+        Mods mods, otherIds, otherKind;
+
+        mods.StandardMods.push_back({ "Hello", 42 });
+        mods.LiteMods.push_back({ "Test", 8 });
+
+        // Ids are local to each client, only the filenames matter
+        otherIds.StandardMods.push_back({ "Hello", 1 });
+        otherIds.LiteMods.push_back({ "Test", 2 });
+
+        otherKind.StandardMods.push_back({ "Hello", 42 });
+        otherKind.StandardMods.push_back({ "Test", 8 });
+
+        REQUIRE(mods.GetHash() == otherIds.GetHash());
+        REQUIRE(mods.GetHash() != otherKind.GetHash());
+    }
+
     GIVEN("AnimationVariables")
     {
         AnimationVariables vars, recvVars;
@@ -298,7 +339,7 @@ TEST_CASE("Differential structures", "[encoding.differential]")
             vars.GenerateDiff(recvVars, writer);
 
             Buffer::Reader reader(&buff);
-            recvVars.ApplyDiff(reader);
+            REQUIRE(recvVars.ApplyDiff(reader));
 
             REQUIRE(vars.Booleans == recvVars.Booleans);
             REQUIRE(vars.Floats == recvVars.Floats);
@@ -316,7 +357,7 @@ TEST_CASE("Differential structures", "[encoding.differential]")
             vars.GenerateDiff(recvVars, writer);
 
             Buffer::Reader reader(&buff);
-            recvVars.ApplyDiff(reader);
+            REQUIRE(recvVars.ApplyDiff(reader));
 
             REQUIRE(vars.Booleans == recvVars.Booleans);
             REQUIRE(vars.Floats == recvVars.Floats);
@@ -337,6 +378,7 @@ TEST_CASE("Packets", "[encoding.packets]")
         sendMessage.UserMods.StandardMods.push_back({"Hi", 14});
         sendMessage.UserMods.LiteMods.push_back({"Test", 8});
         sendMessage.UserMods.LiteMods.push_back({"Toast", 49});
+        sendMessage.ModsHash = sendMessage.UserMods.GetHash();
 
         Buffer::Writer writer(&buff);
         sendMessage.Serialize(writer);
@@ -439,6 +481,100 @@ TEST_CASE("Packets", "[encoding.packets]")
         recvMessage.DeserializeRaw(reader);
 
         REQUIRE(sendMessage == recvMessage);
+
+        // A brief request leaves the state out
+        {
+            Buffer briefBuff(1000);
+
+            AssignCharacterRequest briefMessage = sendMessage, recvBrief;
+            briefMessage.Brief = true;
+            briefMessage.AppearanceBuffer = "";
+
+            Buffer::Writer briefWriter(&briefBuff);
+            briefMessage.Serialize(briefWriter);
+
+            REQUIRE(briefWriter.Size() < writer.Size());
+
+            Buffer::Reader briefReader(&briefBuff);
+            briefReader.ReadBits(trash, 8); // pop opcode
+
+            recvBrief.DeserializeRaw(briefReader);
+
+            REQUIRE(briefMessage == recvBrief);
+        }
+    }
+
+    SECTION("NotifyJoinQueue")
+    {
+        Buffer buff(1000);
+
+        NotifyJoinQueue sendMessage, recvMessage;
+        REQUIRE(sendMessage.Position == 0);
+
+        sendMessage.Position = 300;
+
+        Buffer::Writer writer(&buff);
+        sendMessage.Serialize(writer);
+
+        Buffer::Reader reader(&buff);
+
+        uint64_t trash;
+        reader.ReadBits(trash, 8); // pop opcode
+
+        recvMessage.DeserializeRaw(reader);
+
+        REQUIRE(sendMessage == recvMessage);
+    }
+
+    SECTION("AssignCharacterResponse")
+    {
+        Buffer buff(1000);
+
+        AssignCharacterResponse sendMessage, recvMessage;
+        sendMessage.Owner = true;
+        sendMessage.Cookie = 1234;
+        sendMessage.ServerId = 42;
+        sendMessage.IsDead = true;
+        sendMessage.Restored = true;
+        sendMessage.InventoryContent.Buffer = "restored";
+        sendMessage.InventoryContent.RightHandWeapon = GameId(1, 0x1234);
+        sendMessage.FactionsContent.NpcFactions.push_back({});
+
+        Buffer::Writer writer(&buff);
+        sendMessage.Serialize(writer);
+
+        Buffer::Reader reader(&buff);
+
+        uint64_t trash;
+        reader.ReadBits(trash, 8); // pop opcode
+
+        recvMessage.DeserializeRaw(reader);
+
+        REQUIRE(sendMessage == recvMessage);
+    }
+
+    SECTION("NotifyPlayerListDelta")
+    {
+        Buffer buff(1000);
+
+        NotifyPlayerListDelta sendMessage, recvMessage;
+        sendMessage.Version = 42;
+        sendMessage.UpdatedPlayers[4] = "Hello";
+        sendMessage.UpdatedPlayers[1234567] = "Toast";
+        sendMessage.RemovedPlayers.push_back(8);
+        sendMessage.RemovedPlayers.push_back(987654);
+
+        Buffer::Writer writer(&buff);
+        sendMessage.Serialize(writer);
+
+        Buffer::Reader reader(&buff);
+
+        uint64_t trash;
+        reader.ReadBits(trash, 8); // pop opcode
+
+        recvMessage.DeserializeRaw(reader);
+
+        REQUIRE(sendMessage == recvMessage);
     }
 
     GIVEN("ClientReferencesMoveRequest")
@@ -480,3 +616,766 @@ TEST_CASE("Packets", "[encoding.packets]")
         
     }
 }
+
+TEST_CASE("Message streams", "[encoding.stream]")
+{
+    NotifyPlayerListDelta largeMessage;
+    largeMessage.Version = 7;
+    for (uint32_t i = 0; i < 4000; ++i)
+        largeMessage.UpdatedPlayers[i] = "Some player name";
+
+    NotifyRelinquishControl smallMessage;
+    smallMessage.ServerId = 1234;
+
+    Buffer largeBuff(MessageStream::kMaxMessageSize);
+    Buffer::Writer largeWriter(&largeBuff);
+    largeWriter.WriteBits(0, 8);
+    largeMessage.Serialize(largeWriter);
+
+    Buffer smallBuff(100);
+    Buffer::Writer smallWriter(&smallBuff);
+    smallWriter.WriteBits(0, 8);
+    smallMessage.Serialize(smallWriter);
+
+    REQUIRE(largeWriter.Size() > MessageStream::kChunkSize);
+
+    MessageStreamWriter<NotifyMessageChunk> streamWriter;
+
+    // Small messages go out directly until a stream is queued, then they wait behind it
+    REQUIRE_FALSE(streamWriter.Queue(smallBuff.GetWriteData(), smallWriter.Size()));
+    REQUIRE(streamWriter.Queue(largeBuff.GetWriteData(), largeWriter.Size()));
+    REQUIRE(streamWriter.Queue(smallBuff.GetWriteData(), smallWriter.Size()));
+
+    Vector<Vector<uint8_t>> packets;
+    const auto cSend = [&packets](const uint8_t* apPacket, size_t aSize) { packets.emplace_back(apPacket, apPacket + aSize); };
+
+    // The rate limits how much goes out per update
+    streamWriter.Update(0.01f, 1024 * 1024, cSend);
+    REQUIRE(packets.size() == 1);
+    REQUIRE_FALSE(streamWriter.IsIdle());
+
+    while (!streamWriter.IsIdle())
+        streamWriter.Update(1.f, 1024 * 1024, cSend);
+
+    REQUIRE(streamWriter.GetStats().SentMessages == 2);
+    REQUIRE(streamWriter.GetStats().QueuedBytes == 0);
+
+    const ServerMessageFactory factory;
+    MessageStreamReader streamReader;
+    Vector<UniquePtr<ServerMessage>> received;
+
+    for (auto& packet : packets)
+    {
+        ViewBuffer packetBuff(packet.data() + 1, packet.size() - 1);
+        Buffer::Reader reader(&packetBuff);
+
+        auto pMessage = factory.Extract(reader);
+        REQUIRE(pMessage);
+
+        if (pMessage->GetOpcode() != NotifyMessageChunk::Opcode)
+        {
+            received.push_back(std::move(pMessage));
+            continue;
+        }
+
+        const auto pChunk = CastUnique<NotifyMessageChunk>(std::move(pMessage));
+        REQUIRE(pChunk->Chunk.Data.size() <= MessageStream::kChunkSize);
+
+        const auto cResult = streamReader.Add(pChunk->Chunk);
+        REQUIRE(cResult != MessageStreamReader::EResult::kInvalid);
+
+        if (cResult == MessageStreamReader::EResult::kComplete)
+        {
+            auto message = streamReader.GetMessage();
+            ViewBuffer messageBuff(message.data(), message.size());
+            Buffer::Reader messageReader(&messageBuff);
+
+            received.push_back(factory.Extract(messageReader));
+        }
+    }
+
+    REQUIRE(received.size() == 2);
+    REQUIRE(received[0]->GetOpcode() == NotifyPlayerListDelta::Opcode);
+    REQUIRE(*CastUnique<NotifyPlayerListDelta>(std::move(received[0])) == largeMessage);
+    REQUIRE(*CastUnique<NotifyRelinquishControl>(std::move(received[1])) == smallMessage);
+
+    // A chunk that doesn't continue the stream is rejected
+    MessageChunk chunk;
+    chunk.StreamId = 3;
+    chunk.TotalSize = 10;
+    chunk.Offset = 4;
+    chunk.Data.resize(2);
+    REQUIRE(streamReader.Add(chunk) == MessageStreamReader::EResult::kInvalid);
+
+    // Too large to be sent, even though the second name is dropped by the writer instead of being written
+    NotifyPlayerListDelta hugeMessage;
+    hugeMessage.UpdatedPlayers[1] = String(MessageStream::kMaxMessageSize - 1, 'a');
+    hugeMessage.UpdatedPlayers[2] = String(MessageStream::kMaxMessageSize - 1, 'b');
+
+    Buffer hugeBuff(MessageStream::kSerializeBufferSize);
+    Buffer::Writer hugeWriter(&hugeBuff);
+    hugeWriter.WriteBits(0, 8);
+    hugeMessage.Serialize(hugeWriter);
+
+    REQUIRE(hugeWriter.Size() < MessageStream::kSerializeBufferSize);
+    REQUIRE(MessageStream::IsTruncated(hugeWriter));
+    REQUIRE_FALSE(MessageStream::IsTruncated(largeWriter));
+
+    // Same check for data kept outside of messages
+    Vector<uint8_t> data{1, 2, 3};
+    REQUIRE_FALSE(MessageStream::Serialize(data, [&hugeMessage](Buffer::Writer& aWriter) { hugeMessage.Serialize(aWriter); }));
+    REQUIRE(data.empty());
+
+    REQUIRE(MessageStream::Serialize(data, [&smallMessage](Buffer::Writer& aWriter) { smallMessage.Serialize(aWriter); }));
+    REQUIRE(data == Vector<uint8_t>(smallBuff.GetData() + 1, smallBuff.GetData() + smallWriter.Size()));
+}
+
+TEST_CASE("Message batches", "[encoding.batch]")
+{
+    Vector<Vector<uint8_t>> packets;
+    const auto cSend = [&packets](const uint8_t* apPacket, size_t aSize) { packets.emplace_back(apPacket, apPacket + aSize); };
+
+    const auto cSerialize = [](const ServerMessage& acMessage) {
+        Buffer buff(1000);
+        Buffer::Writer writer(&buff);
+        writer.WriteBits(0, 8);
+        acMessage.Serialize(writer);
+
+        return Vector<uint8_t>(buff.GetWriteData(), buff.GetWriteData() + writer.Size());
+    };
+
+    const ServerMessageFactory factory;
+    const auto cExtract = [&factory](const uint8_t* apData, size_t aSize) {
+        ViewBuffer buff(const_cast<uint8_t*>(apData), aSize);
+        Buffer::Reader reader(&buff);
+
+        return factory.Extract(reader);
+    };
+
+    MessageBatcher<ServerMessageBatch> batcher;
+
+    SECTION("Messages share a packet")
+    {
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            NotifyRelinquishControl message;
+            message.ServerId = 1000 + i;
+
+            const auto cPacket = cSerialize(message);
+            REQUIRE(batcher.Add(cPacket.data(), cPacket.size(), cSend));
+        }
+
+        REQUIRE(packets.empty());
+        batcher.Flush(cSend);
+        REQUIRE(packets.size() == 1);
+        REQUIRE(batcher.IsEmpty());
+
+        auto pMessage = cExtract(packets[0].data() + 1, packets[0].size() - 1);
+        REQUIRE(pMessage);
+        REQUIRE(pMessage->GetOpcode() == ServerMessageBatch::Opcode);
+
+        const auto pBatch = CastUnique<ServerMessageBatch>(std::move(pMessage));
+
+        uint32_t expectedId = 1000;
+        REQUIRE(pBatch->Messages.Visit([&](const uint8_t* apMessage, size_t aSize) {
+            const auto pInner = CastUnique<NotifyRelinquishControl>(cExtract(apMessage, aSize));
+            REQUIRE(pInner->ServerId == expectedId++);
+        }));
+        REQUIRE(expectedId == 1003);
+
+        REQUIRE(batcher.GetStats().Messages == 3);
+        REQUIRE(batcher.GetStats().Packets == 1);
+    }
+
+    SECTION("A single message is sent as is")
+    {
+        NotifyRelinquishControl message;
+        message.ServerId = 42;
+
+        const auto cPacket = cSerialize(message);
+        REQUIRE(batcher.Add(cPacket.data(), cPacket.size(), cSend));
+        batcher.Flush(cSend);
+
+        REQUIRE(packets.size() == 1);
+        REQUIRE(packets[0] == cPacket);
+    }
+
+    SECTION("Large messages keep their order")
+    {
+        NotifyRelinquishControl message;
+        message.ServerId = 42;
+
+        const auto cPacket = cSerialize(message);
+        REQUIRE(batcher.Add(cPacket.data(), cPacket.size(), cSend));
+
+        Vector<uint8_t> large(PackedMessages::kMaxSize, 0);
+        REQUIRE_FALSE(batcher.Add(large.data(), large.size(), cSend));
+
+        // What was batched went out first
+        REQUIRE(packets.size() == 1);
+        REQUIRE(packets[0] == cPacket);
+    }
+
+    SECTION("Unreliable batches fit in a packet")
+    {
+        MessageBatcher<ServerMessageBatch> unreliable(MessageBatcher<ServerMessageBatch>::kMaxUnreliableSize);
+
+        for (uint32_t i = 0; i < 500; ++i)
+        {
+            NotifyRelinquishControl message;
+            message.ServerId = 100000 + i;
+
+            const auto cPacket = cSerialize(message);
+            REQUIRE(unreliable.Add(cPacket.data(), cPacket.size(), cSend));
+        }
+        unreliable.Flush(cSend);
+
+        REQUIRE(packets.size() > 1);
+        for (const auto& cPacket : packets)
+            REQUIRE(cPacket.size() <= MessageBatcher<ServerMessageBatch>::kMaxUnreliableSize + 16);
+    }
+
+    SECTION("Malformed batches are rejected")
+    {
+        PackedMessages messages;
+        messages.Data = {0x05, 0x01};
+
+        REQUIRE_FALSE(messages.Visit([](const uint8_t*, size_t) {}));
+    }
+
+    SECTION("Busy ticks cost fewer packets and bytes")
+    {
+        // What every packet costs on top of its payload, UDP and IPv4 headers only, the transport adds its own
+        constexpr size_t cPacketOverhead = 28;
+        constexpr uint32_t cTicks = 60;
+        constexpr uint32_t cMessagesPerTick = 12;
+
+        std::mt19937 generator(42);
+
+        size_t unbatchedPackets = 0;
+        size_t unbatchedBytes = 0;
+        for (uint32_t tick = 0; tick < cTicks; ++tick)
+        {
+            // A crowded cell, characters dying, leaving and changing hands
+            for (uint32_t i = 0; i < cMessagesPerTick; ++i)
+            {
+                const auto cServerId = generator() % 5000;
+
+                Vector<uint8_t> packet;
+                switch (generator() % 3)
+                {
+                case 0:
+                {
+                    NotifyDeathStateChange message;
+                    message.Id = cServerId;
+                    message.IsDead = true;
+                    packet = cSerialize(message);
+                    break;
+                }
+                case 1:
+                {
+                    NotifyRemoveCharacter message;
+                    message.ServerId = cServerId;
+                    packet = cSerialize(message);
+                    break;
+                }
+                default:
+                {
+                    NotifyRelinquishControl message;
+                    message.ServerId = cServerId;
+                    packet = cSerialize(message);
+                    break;
+                }
+                }
+
+                ++unbatchedPackets;
+                unbatchedBytes += packet.size() + cPacketOverhead;
+
+                REQUIRE(batcher.Add(packet.data(), packet.size(), cSend));
+            }
+
+            // Once per tick, as the server does
+            batcher.Flush(cSend);
+        }
+
+        size_t batchedBytes = 0;
+        for (const auto& cPacket : packets)
+            batchedBytes += cPacket.size() + cPacketOverhead;
+
+        REQUIRE(packets.size() == cTicks);
+        REQUIRE(batcher.GetStats().Packets == cTicks);
+        REQUIRE(batcher.GetStats().Messages == cTicks * cMessagesPerTick);
+
+        INFO("Packets " << packets.size() << ", " << unbatchedPackets << " before");
+        INFO("Bytes " << batchedBytes << ", " << unbatchedBytes << " before, " << batcher.GetStats().OverheadBytes
+                      << " of batch headers");
+        REQUIRE(batchedBytes < unbatchedBytes);
+    }
+}
+
+TEST_CASE("Cell relative positions", "[encoding.position]")
+{
+    const glm::vec3 cPositions[] = {{0.f, 0.f, 0.f},          {1234.37f, -5678.61f, 312.25f}, {-4096.f, 4095.9f, -1.3f},
+                                    {-154322.8f, 203947.1f, -28000.6f}, {8191.99f, -0.01f, 60000.f}};
+
+    for (uint32_t fractionBits = 0; fractionBits <= Vector3_NetQuantize::kMaxFractionBits; fractionBits += 2)
+    {
+        // Rounding to the nearest step, half a step at most
+        const auto cTolerance = 0.5f / static_cast<float>(1u << fractionBits) + 0.02f;
+
+        for (const auto& cPosition : cPositions)
+        {
+            Vector3_NetQuantize sendPosition, recvPosition;
+            sendPosition = cPosition;
+
+            Buffer buff(100);
+            Buffer::Writer writer(&buff);
+            sendPosition.SerializeCellRelative(writer, fractionBits);
+
+            Buffer::Reader reader(&buff);
+            recvPosition.DeserializeCellRelative(reader, fractionBits);
+
+            REQUIRE(std::abs(recvPosition.x - cPosition.x) <= cTolerance);
+            REQUIRE(std::abs(recvPosition.y - cPosition.y) <= cTolerance);
+            REQUIRE(std::abs(recvPosition.z - cPosition.z) <= cTolerance);
+        }
+    }
+
+    // Rounded up to the size of the cell, the offset carries into the next cell instead of being clamped
+    Vector3_NetQuantize edgePosition;
+    edgePosition = glm::vec3(4095.99f, -0.01f, 0.f);
+
+    const auto cEdge = edgePosition.QuantizeCellRelative(2);
+    REQUIRE(cEdge.CellX == 1);
+    REQUIRE(cEdge.OffsetX == 0);
+    REQUIRE(cEdge.CellY == 0);
+    REQUIRE(cEdge.OffsetY == 0);
+
+    GIVEN("Movement")
+    {
+        Movement sendMovement, recvMovement;
+        sendMovement.Position = glm::vec3(1234.37f, -5678.61f, 312.25f);
+        sendMovement.CellId = GameId(1, 0x3C);
+        sendMovement.WorldSpaceId = GameId(1, 0x3C);
+
+        Buffer buff(1000);
+
+        {
+            Buffer::Writer writer(&buff);
+            sendMovement.Serialize(writer);
+            const auto cWithoutCell = writer.Size();
+
+            // The cell isn't sent unless asked for
+            Buffer::Reader reader(&buff);
+            REQUIRE(recvMovement.Deserialize(reader));
+
+            REQUIRE_FALSE(recvMovement.HasCell);
+            REQUIRE(recvMovement.CellId == GameId{});
+            REQUIRE(recvMovement.Position == sendMovement.Position);
+
+            sendMovement.HasCell = true;
+
+            Buffer::Writer cellWriter(&buff);
+            sendMovement.Serialize(cellWriter);
+            REQUIRE(cellWriter.Size() > cWithoutCell);
+        }
+
+        Buffer::Reader reader(&buff);
+        REQUIRE(recvMovement.Deserialize(reader));
+
+        REQUIRE(recvMovement == sendMovement);
+    }
+}
+
+namespace
+{
+    // Edge cases first, the rest is spread over the whole world with angles both inside and outside of a turn
+    void FillQuantizer(MovementQuantizer& aQuantizer, size_t aCount) noexcept
+    {
+        const float cSpecials[] = {0.f, -0.f, 4096.f, -4096.f, 4095.999f, -0.0001f, 0.125f, 0.375f, 2.5f,
+                                   16777216.f, -16777216.f, 1e30f, -1e30f, 6.2831855f, -6.2831855f,
+                                   std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN()};
+        constexpr size_t cSpecialCount = std::size(cSpecials);
+
+        std::mt19937 generator(1234);
+        std::uniform_real_distribution<float> positions(-300000.f, 300000.f);
+        std::uniform_real_distribution<float> angles(-8.f, 8.f);
+
+        for (size_t i = 0; i < aCount; ++i)
+        {
+            if (i < cSpecialCount * cSpecialCount)
+            {
+                const auto cA = cSpecials[i % cSpecialCount];
+                const auto cB = cSpecials[i / cSpecialCount];
+                aQuantizer.Add(glm::vec3(cA, cB, cA), cB, cA);
+            }
+            else
+                aQuantizer.Add(glm::vec3(positions(generator), positions(generator), positions(generator) / 8.f),
+                               angles(generator), angles(generator));
+        }
+    }
+}
+
+TEST_CASE("Batch quantization", "[encoding.quantizer]")
+{
+    // Odd count so every path has a scalar tail
+    MovementQuantizer quantizer;
+    FillQuantizer(quantizer, 1001);
+
+    const auto cBest = MovementQuantizer::GetBestPath();
+
+    for (uint32_t fractionBits = 0; fractionBits <= Vector3_NetQuantize::kMaxFractionBits; fractionBits += 2)
+    {
+        quantizer.Quantize(MovementQuantizer::EPath::kScalar, fractionBits);
+
+        for (auto path : {MovementQuantizer::EPath::kSse2, MovementQuantizer::EPath::kAvx2})
+        {
+            if (path > cBest)
+                continue;
+
+            // Has to be exactly what the scalar codecs produce, other players decode it the same way
+            MovementQuantizer batch = quantizer;
+            batch.Quantize(path, fractionBits);
+
+            for (size_t i = 0; i < quantizer.Size(); ++i)
+            {
+                REQUIRE(batch.GetPosition(i) == quantizer.GetPosition(i));
+                REQUIRE(batch.GetRotation(i) == quantizer.GetRotation(i));
+            }
+        }
+    }
+
+    GIVEN("Movement")
+    {
+        Movement movement;
+        movement.Position = glm::vec3(-154322.8f, 203947.1f, -28000.6f);
+        movement.Rotation.x = -1.2f;
+        movement.Rotation.y = 7.5f;
+
+        MovementQuantizer single;
+        single.Add(movement.Position, movement.Rotation.x, movement.Rotation.y);
+        single.Quantize();
+
+        REQUIRE(single.GetPosition(0) == movement.Position.QuantizeCellRelative());
+        REQUIRE(single.GetRotation(0) == movement.Rotation.Pack());
+
+        Buffer buff(1000);
+        Buffer::Writer writer(&buff);
+        movement.Serialize(writer);
+
+        Buffer quantizedBuff(1000);
+        Buffer::Writer quantizedWriter(&quantizedBuff);
+        movement.QuantizedPosition = single.GetPosition(0);
+        movement.QuantizedRotation = single.GetRotation(0);
+        movement.Serialize(quantizedWriter);
+
+        REQUIRE(writer.Size() == quantizedWriter.Size());
+        REQUIRE(std::memcmp(buff.GetWriteData(), quantizedBuff.GetWriteData(), writer.Size()) == 0);
+    }
+}
+
+// Hidden, run with "[.benchmark]"
+TEST_CASE("Batch quantization throughput", "[.benchmark][encoding.quantizer]")
+{
+    MovementQuantizer quantizer;
+    FillQuantizer(quantizer, 4096);
+
+    BENCHMARK("Scalar")
+    {
+        quantizer.Quantize(MovementQuantizer::EPath::kScalar);
+        return quantizer.GetRotation(0);
+    };
+
+    if (MovementQuantizer::GetBestPath() >= MovementQuantizer::EPath::kSse2)
+    {
+        BENCHMARK("SSE2")
+        {
+            quantizer.Quantize(MovementQuantizer::EPath::kSse2);
+            return quantizer.GetRotation(0);
+        };
+    }
+
+    if (MovementQuantizer::GetBestPath() >= MovementQuantizer::EPath::kAvx2)
+    {
+        BENCHMARK("AVX2")
+        {
+            quantizer.Quantize(MovementQuantizer::EPath::kAvx2);
+            return quantizer.GetRotation(0);
+        };
+    }
+}
+
+namespace
+{
+    // Key of the humanoid graph, AnimationGraphDescriptor_Master_Behavior
+    constexpr uint64_t kMasterBehaviorKey = 16506788379142006504ull;
+
+    // A humanoid walking around, turning, stopping and drawing a weapon now and then, one entry per movement update
+    Vector<AnimationVariables> RecordWalk(size_t aCount) noexcept
+    {
+        const auto* pDescriptor = AnimationGraphDescriptorManager::Get().GetDescriptor(kMasterBehaviorKey);
+
+        AnimationVariables variables;
+        variables.DescriptorKey = kMasterBehaviorKey;
+        variables.Booleans = 0x3000;
+        variables.Integers.assign(pDescriptor->IntegerLookupTable.size(), 0);
+        variables.Floats.assign(pDescriptor->FloatLookupTable.size(), 0.f);
+
+        std::mt19937 generator(42);
+
+        Vector<AnimationVariables> records;
+        for (size_t i = 0; i < aCount; ++i)
+        {
+            const auto cTime = static_cast<float>(i) / 20.f;
+            const auto cMoving = (i / 100) % 3 != 2;
+
+            variables.Floats[0] = 180.f + 90.f * std::sin(cTime * 0.3f);
+            variables.Floats[1] = cMoving ? 120.f + 5.f * std::sin(cTime) : 0.f;
+            variables.Floats[3] = variables.Floats[1];
+
+            if (generator() % 25 == 0)
+                variables.Booleans ^= 1ull << (generator() % pDescriptor->BooleanLookUpTable.size());
+            if (generator() % 60 == 0)
+                variables.Integers[generator() % variables.Integers.size()] = generator() % 4;
+
+            records.push_back(variables);
+        }
+
+        return records;
+    }
+
+    // What the diff cost before descriptors were used: both counts, the whole boolean mask and raw floats
+    size_t LegacyDiffBits(const AnimationVariables& acVariables, const AnimationVariables& acPrevious) noexcept
+    {
+        auto VarIntBits = [](uint64_t aValue) {
+            size_t bits = 8;
+            for (aValue >>= 7; aValue != 0; aValue >>= 7)
+                bits += 8;
+            return bits;
+        };
+
+        size_t bits = VarIntBits(acVariables.Integers.size()) + VarIntBits(acVariables.Floats.size());
+        bits += 1 + acVariables.Integers.size() + acVariables.Floats.size();
+
+        if (acVariables.Booleans != acPrevious.Booleans)
+            bits += 64;
+
+        for (size_t i = 0; i < acVariables.Integers.size(); ++i)
+        {
+            if (acVariables.Integers[i] != acPrevious.Integers[i])
+                bits += VarIntBits(acVariables.Integers[i]);
+        }
+
+        for (size_t i = 0; i < acVariables.Floats.size(); ++i)
+        {
+            if (acVariables.Floats[i] != acPrevious.Floats[i])
+                bits += 32;
+        }
+
+        return bits;
+    }
+}
+
+TEST_CASE("Animation variables with a descriptor", "[encoding.animation]")
+{
+    const auto cRecords = RecordWalk(600);
+
+    Buffer buff(64 * 1024);
+    Buffer::Writer writer(&buff);
+
+    size_t legacyBits = 0;
+    AnimationVariables previous;
+    previous.Integers.assign(cRecords[0].Integers.size(), 0);
+    previous.Floats.assign(cRecords[0].Floats.size(), 0.f);
+
+    for (const auto& cVariables : cRecords)
+    {
+        cVariables.GenerateDiff(previous, writer);
+        legacyBits += LegacyDiffBits(cVariables, previous);
+        previous = cVariables;
+    }
+
+    Buffer::Reader reader(&buff);
+    AnimationVariables received;
+
+    for (const auto& cVariables : cRecords)
+    {
+        REQUIRE(received.ApplyDiff(reader));
+
+        REQUIRE(received.DescriptorKey == cVariables.DescriptorKey);
+        REQUIRE(received.Booleans == cVariables.Booleans);
+        REQUIRE(received.Integers == cVariables.Integers);
+
+        // Quantized to the precision the descriptor declares, weapAdj isn't quantized
+        REQUIRE(received.Floats.size() == cVariables.Floats.size());
+        for (size_t i = 0; i < cVariables.Floats.size(); ++i)
+            REQUIRE(std::abs(received.Floats[i] - cVariables.Floats[i]) <= 0.01f);
+    }
+
+    const auto cBitsPerUpdate = static_cast<float>(writer.Size() * 8) / static_cast<float>(cRecords.size());
+    const auto cLegacyBitsPerUpdate = static_cast<float>(legacyBits) / static_cast<float>(cRecords.size());
+
+    INFO("Bits per update " << cBitsPerUpdate << ", " << cLegacyBitsPerUpdate << " before");
+    REQUIRE(cBitsPerUpdate < cLegacyBitsPerUpdate);
+
+    GIVEN("A full update, as movement sends them")
+    {
+        AnimationVariables sent = cRecords.back();
+        // Out of the declared range, has to go through as is
+        sent.Floats[1] = 1e9f;
+
+        Buffer::Writer fullWriter(&buff);
+        sent.GenerateDiff(AnimationVariables{}, fullWriter);
+
+        Buffer::Reader fullReader(&buff);
+        AnimationVariables full;
+        REQUIRE(full.ApplyDiff(fullReader));
+
+        REQUIRE(full.Booleans == sent.Booleans);
+        REQUIRE(full.Integers == sent.Integers);
+        REQUIRE(full.Floats[1] == sent.Floats[1]);
+    }
+
+    GIVEN("A descriptor the receiver doesn't know")
+    {
+        Buffer::Writer unknownWriter(&buff);
+        Serialization::WriteVarInt(unknownWriter, 0xFFFF);
+        unknownWriter.WriteBits(0x1F, 8);
+
+        Buffer::Reader unknownReader(&buff);
+        AnimationVariables unknown = cRecords.back();
+
+        // Dropped instead of thrown, there is no way to tell how long the diff is
+        REQUIRE_FALSE(unknown.ApplyDiff(unknownReader));
+        REQUIRE(unknown == AnimationVariables{});
+    }
+}
+
+TEST_CASE("Animation graph descriptors", "[encoding.animation]")
+{
+    const auto& cManager = AnimationGraphDescriptorManager::Get();
+
+    uint32_t id = 1;
+    for (; cManager.GetKey(id) != 0; ++id)
+    {
+        const auto cKey = cManager.GetKey(id);
+        const auto* pDescriptor = cManager.GetDescriptor(cKey);
+
+        REQUIRE(pDescriptor);
+        REQUIRE(pDescriptor->Id == id);
+        REQUIRE_FALSE(cManager.GetDescriptor(cKey ^ 1));
+
+        for (const auto cIdx : pDescriptor->FloatLookupTable)
+            REQUIRE(pDescriptor->IsSynced(cIdx));
+    }
+
+    REQUIRE(id > 1);
+
+    // Speed and Direction are floats, TurnDelta an integer, SpeedWalk isn't synced
+    const auto* pMaster = cManager.GetDescriptor(kMasterBehaviorKey);
+    REQUIRE(pMaster);
+    REQUIRE(pMaster->IsSynced(0));
+    REQUIRE(pMaster->IsSynced(1));
+    REQUIRE(pMaster->IsSynced(2));
+    REQUIRE_FALSE(pMaster->IsSynced(4));
+    REQUIRE_FALSE(pMaster->IsSynced(100000));
+}
+
+TEST_CASE("Id sorted collections", "[encoding.ids]")
+{
+    Factions factions;
+    factions.NpcFactions.push_back({});
+
+    NotifyFactionsChanges sendMessage, recvMessage;
+    for (const uint32_t cId : {70000u, 3u, 70001u, 512u, 3u})
+        sendMessage.Changes[cId] = factions;
+
+    REQUIRE(sendMessage.Changes.size() == 4);
+    REQUIRE(sendMessage.Changes.count(512) == 1);
+    REQUIRE(sendMessage.Changes.find(4) == std::end(sendMessage.Changes));
+    REQUIRE(std::is_sorted(std::begin(sendMessage.Changes), std::end(sendMessage.Changes),
+                           [](const auto& acLhs, const auto& acRhs) { return acLhs.first < acRhs.first; }));
+
+    SECTION("Round trip")
+    {
+        Buffer buff(1000);
+        Buffer::Writer writer(&buff);
+        sendMessage.Serialize(writer);
+
+        Buffer::Reader reader(&buff);
+
+        uint64_t trash;
+        reader.ReadBits(trash, 8); // pop opcode
+
+        recvMessage.DeserializeRaw(reader);
+
+        REQUIRE(sendMessage == recvMessage);
+    }
+
+    SECTION("Ids are smaller than in full")
+    {
+        // Entities spawned around the same time have ids close to each other
+        ServerReferencesMoveRequest message;
+        message.Tick = 1234;
+        for (uint32_t i = 0; i < 64; ++i)
+            message.Updates[100000 + i * 3] = {};
+
+        Buffer buff(10000);
+        Buffer::Writer writer(&buff);
+        message.SerializeRaw(writer);
+
+        Buffer legacyBuff(10000);
+        Buffer::Writer legacyWriter(&legacyBuff);
+        Serialization::WriteVarInt(legacyWriter, message.Tick);
+        Serialization::WriteVarInt(legacyWriter, message.Updates.size());
+        for (const auto& [id, update] : message.Updates)
+        {
+            Serialization::WriteVarInt(legacyWriter, id);
+            update.Serialize(legacyWriter);
+        }
+
+        // Every id but the first takes one byte instead of three
+        REQUIRE(writer.Size() + 63 * 2 == legacyWriter.Size());
+    }
+
+    SECTION("Out of order ids still end up sorted")
+    {
+        Buffer buff(1000);
+        Buffer::Writer writer(&buff);
+        writer.WriteBits(3, 8);
+        for (const uint32_t cDelta : {10u, 0xFFFFFFFFu, 0u})
+        {
+            Serialization::WriteVarInt(writer, cDelta);
+            factions.Serialize(writer);
+        }
+
+        Buffer::Reader reader(&buff);
+        recvMessage.DeserializeRaw(reader);
+
+        REQUIRE(recvMessage.Changes.size() == 2);
+        REQUIRE(std::begin(recvMessage.Changes)->first == 9);
+        REQUIRE(recvMessage.Changes.count(10) == 1);
+    }
+
+    SECTION("A bogus count doesn't get to allocate or loop")
+    {
+        Buffer buff(1000);
+        Buffer::Writer writer(&buff);
+        Serialization::WriteVarInt(writer, 1234);
+        Serialization::WriteVarInt(writer, 1ull << 62);
+        for (const uint32_t cDelta : {5u, 1u})
+        {
+            Serialization::WriteVarInt(writer, cDelta);
+            ReferenceUpdate{}.Serialize(writer);
+        }
+
+        ViewBuffer view(buff.GetWriteData(), writer.Size());
+        Buffer::Reader reader(&view);
+
+        ClientReferencesMoveRequest message;
+        message.DeserializeRaw(reader);
+
+        REQUIRE(message.Updates.size() == 2);
+        REQUIRE(message.Updates.count(6) == 1);
+    }
+}
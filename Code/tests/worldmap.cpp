@@ -0,0 +1,235 @@
+#include <catch2/catch.hpp>
+
+#include <stdafx.h>
+
+#include <CellGrid.h>
+#include <Components.h>
+#include <Game/Region.h>
+#include <Game/WorldMap.h>
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace
+{
+    constexpr uint32_t kWorldSpace = 0x3C;
+
+    template <class T> void Put(Vector<uint8_t>& aData, T aValue)
+    {
+        const auto cOffset = aData.size();
+        aData.resize(cOffset + sizeof(T));
+        std::memcpy(aData.data() + cOffset, &aValue, sizeof(T));
+    }
+
+    // A 4x3 worldspace from (-2, -1) to (1, 1) owned by the first master, the second row holds a lite master's cell
+    // and a hole
+    Vector<uint8_t> BuildMap()
+    {
+        const std::pair<bool, std::string> cMasters[] = {{false, "Skyrim.esm"}, {true, "ccTest.esl"}};
+
+        Vector<uint8_t> data;
+        Put<uint32_t>(data, 'T' | ('P' << 8) | ('W' << 16) | ('M' << 24));
+        Put<uint16_t>(data, 1);
+        Put<uint16_t>(data, 2);
+        Put<uint32_t>(data, 1);
+        Put<uint32_t>(data, 0);
+
+        for (const auto& [lite, filename] : cMasters)
+        {
+            Put<uint8_t>(data, lite);
+            Put<uint8_t>(data, static_cast<uint8_t>(filename.size()));
+            data.insert(std::end(data), std::begin(filename), std::end(filename));
+        }
+
+        while (data.size() % 4)
+            data.push_back(0);
+
+        const auto cCellOffset = static_cast<uint32_t>(data.size() + 20);
+
+        Put<uint32_t>(data, 1);
+        Put<uint32_t>(data, kWorldSpace);
+        Put<int16_t>(data, -2);
+        Put<int16_t>(data, -1);
+        Put<uint16_t>(data, 4);
+        Put<uint16_t>(data, 3);
+        Put<uint32_t>(data, cCellOffset);
+
+        for (auto y = 0; y < 3; ++y)
+        {
+            for (auto x = 0; x < 4; ++x)
+            {
+                Cell cell{1, static_cast<uint32_t>(0x100 + y * 4 + x)};
+                if (y == 1 && x == 1)
+                    cell = {2, 0x800};
+                else if (y == 1 && x == 2)
+                    cell = {};
+
+                Put(data, cell);
+            }
+        }
+
+        return data;
+    }
+
+    struct TemporaryMap
+    {
+        explicit TemporaryMap(const Vector<uint8_t>& acData)
+            : Path(std::filesystem::temp_directory_path() / "tp_tests.tpmap")
+        {
+            std::ofstream file(Path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(acData.data()), static_cast<std::streamsize>(acData.size()));
+        }
+
+        ~TemporaryMap()
+        {
+            std::error_code ec;
+            std::filesystem::remove(Path, ec);
+        }
+
+        std::filesystem::path Path;
+    };
+}
+
+TEST_CASE("Cell grid lookup", "[common.cellgrid]")
+{
+    const Cell cells[] = {{1, 0x10}, {0, 0}, {1, 0x12}, {2, 0x13}};
+    const CellGrid grid(cells, -1, 5, 2, 2);
+
+    REQUIRE(grid.At(-1, 5) == &cells[0]);
+    REQUIRE(grid.At(0, 6) == &cells[3]);
+    REQUIRE(grid.At(-1, 6) == &cells[2]);
+
+    // Holes and anything outside the table
+    REQUIRE(grid.At(0, 5) == nullptr);
+    REQUIRE(grid.At(-2, 5) == nullptr);
+    REQUIRE(grid.At(1, 6) == nullptr);
+    REQUIRE(grid.At(0, 7) == nullptr);
+    REQUIRE(grid.At(std::numeric_limits<int32_t>::min(), 5) == nullptr);
+    REQUIRE(grid.At(std::numeric_limits<int32_t>::max(), 5) == nullptr);
+
+    REQUIRE(CellGrid().At(0, 0) == nullptr);
+}
+
+TEST_CASE("World map lookup", "[server.worldmap]")
+{
+    ModsComponent mods;
+    const auto cLiteId = mods.AddLite("ccTest.esl");
+    const auto cMasterId = mods.AddStandard("Skyrim.esm");
+
+    const TemporaryMap file(BuildMap());
+
+    WorldMap map;
+    REQUIRE(map.Load(file.Path));
+
+    const GameId cWorldSpace(cMasterId, kWorldSpace);
+    GameId cell;
+
+    SECTION("Cells resolve to server mod ids")
+    {
+        REQUIRE(map.GetCellId(cWorldSpace, {-2, -1}, mods, cell));
+        REQUIRE(cell == GameId(cMasterId, 0x100));
+
+        REQUIRE(map.GetCellId(cWorldSpace, {1, 1}, mods, cell));
+        REQUIRE(cell == GameId(cMasterId, 0x10B));
+
+        REQUIRE(map.GetCellId(cWorldSpace, {-1, 0}, mods, cell));
+        REQUIRE(cell == GameId(cLiteId, 0x800));
+    }
+
+    SECTION("Missing cells are not found")
+    {
+        REQUIRE_FALSE(map.GetCellId(cWorldSpace, {0, 0}, mods, cell));
+        REQUIRE_FALSE(map.GetCellId(cWorldSpace, {2, 0}, mods, cell));
+        REQUIRE_FALSE(map.GetCellId(cWorldSpace, {-2, -2}, mods, cell));
+        REQUIRE_FALSE(map.GetCellId(GameId(cMasterId, kWorldSpace + 1), {0, 1}, mods, cell));
+        REQUIRE_FALSE(map.GetCellId(GameId(cLiteId, kWorldSpace), {0, 1}, mods, cell));
+    }
+
+    SECTION("Masters the server doesn't know are not resolved")
+    {
+        ModsComponent otherMods;
+        const auto cId = otherMods.AddStandard("Skyrim.esm");
+
+        REQUIRE(map.GetCellId(GameId(cId, kWorldSpace), {0, 1}, otherMods, cell));
+        REQUIRE_FALSE(map.GetCellId(GameId(cId, kWorldSpace), {-1, 0}, otherMods, cell));
+    }
+}
+
+TEST_CASE("World map validation", "[server.worldmap]")
+{
+    auto data = BuildMap();
+
+    SECTION("Truncated")
+    {
+        data.resize(data.size() - sizeof(Cell));
+    }
+
+    SECTION("Bad version")
+    {
+        data[4] = 2;
+    }
+
+    SECTION("Unknown master in a cell")
+    {
+        data[data.size() - sizeof(Cell)] = 3;
+    }
+
+    const TemporaryMap file(data);
+
+    WorldMap map;
+    REQUIRE_FALSE(map.Load(file.Path));
+    REQUIRE_FALSE(map.IsLoaded());
+}
+
+TEST_CASE("Region deltas", "[server.region]")
+{
+    const GameId cWorldSpace(0, kWorldSpace);
+    const GameId cOtherWorldSpace(0, kWorldSpace + 1);
+
+    const Region oldRegion(CellIdComponent{GameId(0, 0x100), cWorldSpace, {0, 0}});
+    const Region newRegion(CellIdComponent{GameId(0, 0x101), cWorldSpace, {1, 0}});
+
+    REQUIRE(oldRegion.IsExterior());
+
+    // Same rule as the grid shift: sent when the new grid holds it and the old one did not
+    uint32_t entering = 0;
+    uint32_t leaving = 0;
+    for (auto x = -5; x <= 5; ++x)
+    {
+        for (auto y = -5; y <= 5; ++y)
+        {
+            const CellIdComponent cell{GameId(0, 0x1000), cWorldSpace, {x, y}};
+            const auto cInOld = oldRegion.Contains(cell);
+            const auto cInNew = newRegion.Contains(cell);
+
+            if (cInNew && !cInOld)
+            {
+                REQUIRE(x == 3);
+                ++entering;
+            }
+            if (cInOld && !cInNew)
+            {
+                REQUIRE(x == -2);
+                ++leaving;
+            }
+        }
+    }
+
+    REQUIRE(entering == static_cast<uint32_t>(GridCellCoords::m_gridsToLoad));
+    REQUIRE(leaving == static_cast<uint32_t>(GridCellCoords::m_gridsToLoad));
+
+    REQUIRE_FALSE(newRegion.Contains(CellIdComponent{GameId(0, 0x101), cOtherWorldSpace, {1, 0}}));
+
+    SECTION("Interiors hold a single cell")
+    {
+        const Region interior(CellIdComponent{GameId(0, 0x200)});
+
+        REQUIRE_FALSE(interior.IsExterior());
+        REQUIRE(interior.Contains(CellIdComponent{GameId(0, 0x200)}));
+        REQUIRE_FALSE(interior.Contains(CellIdComponent{GameId(0, 0x201)}));
+        REQUIRE_FALSE(interior.Contains(CellIdComponent{GameId(0, 0x101), cWorldSpace, {1, 0}}));
+
+        REQUIRE_FALSE(Region(CellIdComponent{}).Contains(CellIdComponent{}));
+    }
+}
@@ -2,15 +2,32 @@
 target("TPTests")
     set_kind("binary")
     set_group("Tests")
-    add_defines("TP_SKYRIM=1")
+    add_defines("TP_SKYRIM=1", "CATCH_CONFIG_ENABLE_BENCHMARKING")
     add_includedirs(
-        ".", "../encoding")
+        ".", "../encoding", "../server", "../../Libraries/")
     add_headerfiles("**.h")
     add_files("*.cpp")
-    add_deps("SkyrimEncoding")
+    -- Standalone parts of the server
+    add_files("../server/Services/ServerListAnnouncer.cpp")
+    add_files(
+        "../server/Game/WorldMap.cpp",
+        "../server/Game/Region.cpp",
+        "../server/Components/ModsComponent.cpp")
+    add_deps(
+        "SkyrimEncoding",
+        "Common",
+        "TiltedConnect",
+        "TiltedScript")
     add_packages(
         "tiltedcore",
         "hopscotch-map",
         "catch2",
         "mimalloc",
-        "glm")
+        "glm",
+        "spdlog",
+        "cpp-httplib",
+        "gamenetworkingsockets",
+        "sqlite3",
+        "lua",
+        "sol2",
+        "entt")
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""Generates the world map the server uses to resolve exterior cells.
+
+The server loads data/skyrim.tpmap (Skyrim SE) or data/fallout4.tpmap (Fallout 4)
+from its working directory. The file is built from the game's own plugins, which
+can't be redistributed, so it has to be generated from a local installation:
+
+    python generate_world_map.py skyrim.tpmap <Data>/Skyrim.esm <Data>/Update.esm ...
+
+Pass the plugins in load order, at least the ones adding worldspaces or exterior
+cells. Later plugins override the cells of earlier ones like they do in game.
+
+Without the file the server falls back to the cell reported by each client.
+"""
+
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = b'TPWM'
+VERSION = 1
+
+RECORD_HEADER = struct.Struct('<4sIIIIHH')
+GROUP_HEADER = struct.Struct('<4sI4siHHHH')
+
+FLAG_LIGHT = 0x200
+FLAG_DELETED = 0x20
+FLAG_COMPRESSED = 0x40000
+
+GROUP_EXTERIOR_SUB_BLOCK = 5
+
+
+class Plugin:
+    def __init__(self, path):
+        self.filename = os.path.basename(path)
+        with open(path, 'rb') as f:
+            self.data = f.read()
+
+        header = RECORD_HEADER.unpack_from(self.data, 0)
+        if header[0] != b'TES4':
+            raise ValueError('{} is not a plugin'.format(path))
+
+        self.lite = bool(header[2] & FLAG_LIGHT) or self.filename.lower().endswith('.esl')
+        self.masters = [value.split(b'\0')[0].decode('cp1252')
+                        for tag, value in subrecords(self.data[RECORD_HEADER.size:RECORD_HEADER.size + header[1]])
+                        if tag == b'MAST']
+        self.first_group = RECORD_HEADER.size + header[1]
+
+    def owner(self, form_id):
+        """Filename of the plugin defining a form and its id without the load order index."""
+        index = form_id >> 24
+        filename = self.masters[index] if index < len(self.masters) else self.filename
+        return filename, form_id & 0xFFFFFF
+
+
+def subrecords(data):
+    offset = 0
+    extended = None
+    while offset + 6 <= len(data):
+        tag, size = struct.unpack_from('<4sH', data, offset)
+        offset += 6
+        if extended is not None:
+            size, extended = extended, None
+        if tag == b'XXXX':
+            extended = struct.unpack_from('<I', data, offset)[0]
+        else:
+            yield tag, data[offset:offset + size]
+        offset += size
+
+
+def record_data(data, offset, size, flags):
+    payload = data[offset:offset + size]
+    if flags & FLAG_COMPRESSED:
+        payload = zlib.decompress(payload[4:])
+    return payload
+
+
+def read_cells(plugin, cells):
+    """Collects the coordinates of the exterior cells of every worldspace into cells[world][cell]."""
+    data = plugin.data
+
+    def walk(offset, end, world, in_block):
+        while offset < end:
+            tag = data[offset:offset + 4]
+            if tag == b'GRUP':
+                _, size, label, group_type, _, _, _, _ = GROUP_HEADER.unpack_from(data, offset)
+                child_world = world
+                # World children groups are labelled with the worldspace they belong to
+                if group_type == 1:
+                    child_world = plugin.owner(struct.unpack('<I', label)[0])
+                # Top level groups other than worldspaces and cell children hold nothing of interest
+                if (group_type == 0 and label != b'WRLD') or group_type in (6, 8, 9, 10):
+                    offset += size
+                    continue
+                walk(offset + GROUP_HEADER.size, offset + size, child_world,
+                     group_type == GROUP_EXTERIOR_SUB_BLOCK)
+                offset += size
+                continue
+
+            _, size, flags, form_id, _, _, _ = RECORD_HEADER.unpack_from(data, offset)
+            body = offset + RECORD_HEADER.size
+
+            if tag == b'CELL' and in_block and world is not None:
+                key = plugin.owner(form_id)
+                table = cells.setdefault(world, {})
+
+                if flags & FLAG_DELETED:
+                    table.pop(key, None)
+                else:
+                    for sub_tag, value in subrecords(record_data(data, body, size, flags)):
+                        if sub_tag == b'XCLC':
+                            table[key] = struct.unpack_from('<ii', value)
+                            break
+
+            offset = body + size
+
+    walk(plugin.first_group, len(data), None, False)
+
+
+def write_map(path, plugins, cells):
+    lite = {plugin.filename.lower(): plugin.lite for plugin in plugins}
+
+    masters = []
+    indices = {}
+
+    def master_index(filename):
+        key = filename.lower()
+        if key not in indices:
+            masters.append(filename)
+            indices[key] = len(masters)
+        return indices[key]
+
+    worlds = []
+    for (world_file, world_id), table in cells.items():
+        if not table:
+            continue
+        xs = [x for x, _ in table.values()]
+        ys = [y for _, y in table.values()]
+        min_x, min_y = min(xs), min(ys)
+        width, height = max(xs) - min_x + 1, max(ys) - min_y + 1
+        if min_x < -0x8000 or min_y < -0x8000 or width > 0xFFFF or height > 0xFFFF:
+            raise ValueError('worldspace {:X} of {} is too large'.format(world_id, world_file))
+
+        grid = [(0, 0)] * (width * height)
+        for (cell_file, cell_id), (x, y) in table.items():
+            # Lite plugins only use the low 12 bits of their ids
+            if lite.get(cell_file.lower(), False):
+                cell_id &= 0xFFF
+            grid[(y - min_y) * width + (x - min_x)] = (master_index(cell_file), cell_id)
+
+        if lite.get(world_file.lower(), False):
+            world_id &= 0xFFF
+        worlds.append((master_index(world_file), world_id, min_x, min_y, width, height, grid))
+
+    header = struct.pack('<4sHHII', MAGIC, VERSION, len(masters), len(worlds), 0)
+
+    names = b''
+    for filename in masters:
+        encoded = filename.encode('cp1252')
+        if len(encoded) > 0xFF:
+            raise ValueError('{} has too long a name'.format(filename))
+        names += struct.pack('<BB', lite.get(filename.lower(), False), len(encoded)) + encoded
+
+    # Worldspace entries are 4 byte aligned, the cell tables that follow them too
+    names += b'\0' * (-(len(header) + len(names)) % 4)
+
+    offset = len(header) + len(names) + 20 * len(worlds)
+    entries = b''
+    tables = b''
+    for master, world_id, min_x, min_y, width, height, grid in worlds:
+        entries += struct.pack('<IIhhHHI', master, world_id, min_x, min_y, width, height, offset + len(tables))
+        tables += b''.join(struct.pack('<II', *cell) for cell in grid)
+
+    with open(path, 'wb') as f:
+        f.write(header + names + entries + tables)
+
+    print('Wrote {} worldspaces from {} masters to {}'.format(len(worlds), len(masters), path))
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__)
+        return 1
+
+    plugins = [Plugin(path) for path in sys.argv[2:]]
+
+    cells = {}
+    for plugin in plugins:
+        read_cells(plugin, cells)
+
+    write_map(sys.argv[1], plugins, cells)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())